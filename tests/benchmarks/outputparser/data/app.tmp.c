@@ -0,0 +1,2002 @@
+#include <stdio.h>
+
+#line 509 "src/main.v"
+	int opts_0 = 0;
+	int ctx_0 = 1;
+	int items_0 = 2;
+	int req_0 = 3;
+#line 658 "src/db/models.v"
+	int resp_1 = 0;
+	int ctx_1 = 1;
+	int items_1 = 2;
+	int user_1 = 3;
+#line 154 "src/server/router.v"
+	int resp_2 = 0;
+	int user_2 = 1;
+	int opts_2 = 2;
+	int cfg_2 = 3;
+#line 201 "src/main.v"
+	int cfg_3 = 0;
+	int row_3 = 1;
+	int buf_3 = 2;
+	int cfg_3 = 3;
+#line 174 "src/main.v"
+	int resp_4 = 0;
+	int items_4 = 1;
+	int items_4 = 2;
+	int cfg_4 = 3;
+#line 807 "src/server/router.v"
+	int conn_5 = 0;
+	int req_5 = 1;
+	int row_5 = 2;
+	int ctx_5 = 3;
+#line 13 "src/main.v"
+	int cfg_6 = 0;
+	int resp_6 = 1;
+	int req_6 = 2;
+	int cfg_6 = 3;
+#line 869 "src/server/handlers.v"
+	int opts_7 = 0;
+	int user_7 = 1;
+	int cfg_7 = 2;
+	int buf_7 = 3;
+#line 93 "src/util/strings.v"
+	int cfg_8 = 0;
+	int row_8 = 1;
+	int row_8 = 2;
+	int cfg_8 = 3;
+#line 421 "src/server/router.v"
+	int buf_9 = 0;
+	int resp_9 = 1;
+	int cfg_9 = 2;
+	int req_9 = 3;
+#line 803 "src/db/models.v"
+	int row_10 = 0;
+	int ctx_10 = 1;
+	int ctx_10 = 2;
+	int row_10 = 3;
+#line 708 "src/main.v"
+	int resp_11 = 0;
+	int cfg_11 = 1;
+	int row_11 = 2;
+	int resp_11 = 3;
+#line 130 "src/server/router.v"
+	int user_12 = 0;
+	int ctx_12 = 1;
+	int items_12 = 2;
+	int conn_12 = 3;
+#line 314 "src/db/query.v"
+	int ctx_13 = 0;
+	int conn_13 = 1;
+	int cfg_13 = 2;
+	int cfg_13 = 3;
+#line 157 "src/util/strings.v"
+	int buf_14 = 0;
+	int user_14 = 1;
+	int items_14 = 2;
+	int ctx_14 = 3;
+#line 284 "src/main.v"
+	int conn_15 = 0;
+	int req_15 = 1;
+	int opts_15 = 2;
+	int resp_15 = 3;
+#line 163 "src/util/strings.v"
+	int req_16 = 0;
+	int req_16 = 1;
+	int resp_16 = 2;
+	int ctx_16 = 3;
+#line 404 "src/cli/args.v"
+	int cfg_17 = 0;
+	int user_17 = 1;
+	int cfg_17 = 2;
+	int opts_17 = 3;
+#line 511 "src/main.v"
+	int opts_18 = 0;
+	int buf_18 = 1;
+	int buf_18 = 2;
+	int row_18 = 3;
+#line 608 "src/util/strings.v"
+	int cfg_19 = 0;
+	int row_19 = 1;
+	int user_19 = 2;
+	int conn_19 = 3;
+#line 453 "src/cli/args.v"
+	int user_20 = 0;
+	int conn_20 = 1;
+	int buf_20 = 2;
+	int items_20 = 3;
+#line 286 "src/util/strings.v"
+	int buf_21 = 0;
+	int buf_21 = 1;
+	int req_21 = 2;
+	int resp_21 = 3;
+#line 194 "src/cli/args.v"
+	int conn_22 = 0;
+	int user_22 = 1;
+	int cfg_22 = 2;
+	int req_22 = 3;
+#line 378 "src/server/handlers.v"
+	int ctx_23 = 0;
+	int row_23 = 1;
+	int ctx_23 = 2;
+	int conn_23 = 3;
+#line 133 "src/cli/args.v"
+	int ctx_24 = 0;
+	int items_24 = 1;
+	int resp_24 = 2;
+	int conn_24 = 3;
+#line 301 "src/db/models.v"
+	int conn_25 = 0;
+	int user_25 = 1;
+	int opts_25 = 2;
+	int req_25 = 3;
+#line 379 "src/server/router.v"
+	int items_26 = 0;
+	int items_26 = 1;
+	int resp_26 = 2;
+	int resp_26 = 3;
+#line 793 "src/util/strings.v"
+	int user_27 = 0;
+	int row_27 = 1;
+	int opts_27 = 2;
+	int ctx_27 = 3;
+#line 894 "src/db/query.v"
+	int buf_28 = 0;
+	int conn_28 = 1;
+	int buf_28 = 2;
+	int resp_28 = 3;
+#line 86 "src/db/models.v"
+	int row_29 = 0;
+	int items_29 = 1;
+	int items_29 = 2;
+	int items_29 = 3;
+#line 743 "src/cli/args.v"
+	int buf_30 = 0;
+	int conn_30 = 1;
+	int buf_30 = 2;
+	int user_30 = 3;
+#line 180 "src/util/strings.v"
+	int opts_31 = 0;
+	int conn_31 = 1;
+	int ctx_31 = 2;
+	int req_31 = 3;
+#line 537 "src/db/query.v"
+	int req_32 = 0;
+	int row_32 = 1;
+	int cfg_32 = 2;
+	int opts_32 = 3;
+#line 410 "src/server/router.v"
+	int resp_33 = 0;
+	int resp_33 = 1;
+	int resp_33 = 2;
+	int cfg_33 = 3;
+#line 52 "src/cli/args.v"
+	int ctx_34 = 0;
+	int ctx_34 = 1;
+	int user_34 = 2;
+	int opts_34 = 3;
+#line 469 "src/db/query.v"
+	int cfg_35 = 0;
+	int resp_35 = 1;
+	int ctx_35 = 2;
+	int req_35 = 3;
+#line 281 "src/db/query.v"
+	int row_36 = 0;
+	int user_36 = 1;
+	int items_36 = 2;
+	int user_36 = 3;
+#line 65 "src/cli/args.v"
+	int conn_37 = 0;
+	int req_37 = 1;
+	int row_37 = 2;
+	int user_37 = 3;
+#line 25 "src/server/handlers.v"
+	int user_38 = 0;
+	int resp_38 = 1;
+	int row_38 = 2;
+	int row_38 = 3;
+#line 447 "src/db/query.v"
+	int cfg_39 = 0;
+	int row_39 = 1;
+	int conn_39 = 2;
+	int resp_39 = 3;
+#line 265 "src/db/query.v"
+	int opts_40 = 0;
+	int buf_40 = 1;
+	int conn_40 = 2;
+	int opts_40 = 3;
+#line 197 "src/db/query.v"
+	int items_41 = 0;
+	int user_41 = 1;
+	int ctx_41 = 2;
+	int row_41 = 3;
+#line 530 "src/main.v"
+	int conn_42 = 0;
+	int req_42 = 1;
+	int ctx_42 = 2;
+	int opts_42 = 3;
+#line 415 "src/util/strings.v"
+	int opts_43 = 0;
+	int opts_43 = 1;
+	int ctx_43 = 2;
+	int cfg_43 = 3;
+#line 538 "src/db/models.v"
+	int items_44 = 0;
+	int buf_44 = 1;
+	int resp_44 = 2;
+	int items_44 = 3;
+#line 815 "src/main.v"
+	int user_45 = 0;
+	int req_45 = 1;
+	int resp_45 = 2;
+	int row_45 = 3;
+#line 435 "src/main.v"
+	int conn_46 = 0;
+	int items_46 = 1;
+	int cfg_46 = 2;
+	int resp_46 = 3;
+#line 248 "src/db/models.v"
+	int resp_47 = 0;
+	int ctx_47 = 1;
+	int row_47 = 2;
+	int cfg_47 = 3;
+#line 377 "src/db/query.v"
+	int row_48 = 0;
+	int items_48 = 1;
+	int opts_48 = 2;
+	int ctx_48 = 3;
+#line 725 "src/db/query.v"
+	int resp_49 = 0;
+	int buf_49 = 1;
+	int opts_49 = 2;
+	int cfg_49 = 3;
+#line 624 "src/server/handlers.v"
+	int req_50 = 0;
+	int conn_50 = 1;
+	int items_50 = 2;
+	int row_50 = 3;
+#line 154 "src/db/query.v"
+	int conn_51 = 0;
+	int resp_51 = 1;
+	int resp_51 = 2;
+	int conn_51 = 3;
+#line 554 "src/db/query.v"
+	int row_52 = 0;
+	int opts_52 = 1;
+	int cfg_52 = 2;
+	int row_52 = 3;
+#line 229 "src/util/strings.v"
+	int user_53 = 0;
+	int cfg_53 = 1;
+	int cfg_53 = 2;
+	int resp_53 = 3;
+#line 520 "src/main.v"
+	int opts_54 = 0;
+	int cfg_54 = 1;
+	int user_54 = 2;
+	int buf_54 = 3;
+#line 316 "src/cli/args.v"
+	int user_55 = 0;
+	int cfg_55 = 1;
+	int row_55 = 2;
+	int row_55 = 3;
+#line 169 "src/server/router.v"
+	int opts_56 = 0;
+	int req_56 = 1;
+	int cfg_56 = 2;
+	int buf_56 = 3;
+#line 396 "src/db/models.v"
+	int req_57 = 0;
+	int items_57 = 1;
+	int resp_57 = 2;
+	int cfg_57 = 3;
+#line 640 "src/db/query.v"
+	int user_58 = 0;
+	int opts_58 = 1;
+	int user_58 = 2;
+	int opts_58 = 3;
+#line 828 "src/cli/args.v"
+	int cfg_59 = 0;
+	int user_59 = 1;
+	int user_59 = 2;
+	int opts_59 = 3;
+#line 561 "src/util/strings.v"
+	int row_60 = 0;
+	int req_60 = 1;
+	int ctx_60 = 2;
+	int user_60 = 3;
+#line 76 "src/db/query.v"
+	int user_61 = 0;
+	int buf_61 = 1;
+	int opts_61 = 2;
+	int opts_61 = 3;
+#line 322 "src/util/strings.v"
+	int opts_62 = 0;
+	int resp_62 = 1;
+	int resp_62 = 2;
+	int cfg_62 = 3;
+#line 447 "src/db/models.v"
+	int conn_63 = 0;
+	int cfg_63 = 1;
+	int opts_63 = 2;
+	int row_63 = 3;
+#line 599 "src/cli/args.v"
+	int cfg_64 = 0;
+	int req_64 = 1;
+	int req_64 = 2;
+	int user_64 = 3;
+#line 437 "src/server/router.v"
+	int buf_65 = 0;
+	int cfg_65 = 1;
+	int row_65 = 2;
+	int row_65 = 3;
+#line 225 "src/server/handlers.v"
+	int conn_66 = 0;
+	int buf_66 = 1;
+	int row_66 = 2;
+	int buf_66 = 3;
+#line 424 "src/db/models.v"
+	int opts_67 = 0;
+	int resp_67 = 1;
+	int row_67 = 2;
+	int ctx_67 = 3;
+#line 427 "src/server/router.v"
+	int resp_68 = 0;
+	int user_68 = 1;
+	int buf_68 = 2;
+	int items_68 = 3;
+#line 691 "src/util/strings.v"
+	int conn_69 = 0;
+	int resp_69 = 1;
+	int ctx_69 = 2;
+	int conn_69 = 3;
+#line 238 "src/db/models.v"
+	int resp_70 = 0;
+	int opts_70 = 1;
+	int items_70 = 2;
+	int buf_70 = 3;
+#line 386 "src/util/strings.v"
+	int items_71 = 0;
+	int buf_71 = 1;
+	int items_71 = 2;
+	int items_71 = 3;
+#line 565 "src/server/handlers.v"
+	int row_72 = 0;
+	int opts_72 = 1;
+	int ctx_72 = 2;
+	int opts_72 = 3;
+#line 729 "src/cli/args.v"
+	int opts_73 = 0;
+	int req_73 = 1;
+	int cfg_73 = 2;
+	int row_73 = 3;
+#line 581 "src/db/models.v"
+	int opts_74 = 0;
+	int resp_74 = 1;
+	int conn_74 = 2;
+	int items_74 = 3;
+#line 114 "src/server/router.v"
+	int opts_75 = 0;
+	int items_75 = 1;
+	int resp_75 = 2;
+	int req_75 = 3;
+#line 152 "src/server/router.v"
+	int row_76 = 0;
+	int buf_76 = 1;
+	int opts_76 = 2;
+	int cfg_76 = 3;
+#line 328 "src/server/router.v"
+	int buf_77 = 0;
+	int buf_77 = 1;
+	int ctx_77 = 2;
+	int ctx_77 = 3;
+#line 789 "src/main.v"
+	int items_78 = 0;
+	int row_78 = 1;
+	int ctx_78 = 2;
+	int user_78 = 3;
+#line 189 "src/db/models.v"
+	int buf_79 = 0;
+	int buf_79 = 1;
+	int user_79 = 2;
+	int buf_79 = 3;
+#line 94 "src/cli/args.v"
+	int ctx_80 = 0;
+	int opts_80 = 1;
+	int row_80 = 2;
+	int items_80 = 3;
+#line 634 "src/db/models.v"
+	int user_81 = 0;
+	int cfg_81 = 1;
+	int resp_81 = 2;
+	int opts_81 = 3;
+#line 597 "src/cli/args.v"
+	int req_82 = 0;
+	int buf_82 = 1;
+	int user_82 = 2;
+	int resp_82 = 3;
+#line 236 "src/db/models.v"
+	int row_83 = 0;
+	int cfg_83 = 1;
+	int buf_83 = 2;
+	int cfg_83 = 3;
+#line 207 "src/server/handlers.v"
+	int buf_84 = 0;
+	int resp_84 = 1;
+	int req_84 = 2;
+	int cfg_84 = 3;
+#line 761 "src/cli/args.v"
+	int conn_85 = 0;
+	int items_85 = 1;
+	int conn_85 = 2;
+	int req_85 = 3;
+#line 11 "src/db/query.v"
+	int resp_86 = 0;
+	int opts_86 = 1;
+	int opts_86 = 2;
+	int resp_86 = 3;
+#line 757 "src/db/query.v"
+	int cfg_87 = 0;
+	int cfg_87 = 1;
+	int resp_87 = 2;
+	int items_87 = 3;
+#line 28 "src/db/models.v"
+	int opts_88 = 0;
+	int resp_88 = 1;
+	int conn_88 = 2;
+	int cfg_88 = 3;
+#line 407 "src/util/strings.v"
+	int conn_89 = 0;
+	int cfg_89 = 1;
+	int opts_89 = 2;
+	int resp_89 = 3;
+#line 501 "src/cli/args.v"
+	int resp_90 = 0;
+	int resp_90 = 1;
+	int row_90 = 2;
+	int resp_90 = 3;
+#line 276 "src/db/query.v"
+	int conn_91 = 0;
+	int items_91 = 1;
+	int resp_91 = 2;
+	int resp_91 = 3;
+#line 781 "src/db/query.v"
+	int buf_92 = 0;
+	int ctx_92 = 1;
+	int ctx_92 = 2;
+	int ctx_92 = 3;
+#line 818 "src/server/handlers.v"
+	int cfg_93 = 0;
+	int opts_93 = 1;
+	int items_93 = 2;
+	int row_93 = 3;
+#line 104 "src/cli/args.v"
+	int user_94 = 0;
+	int user_94 = 1;
+	int resp_94 = 2;
+	int cfg_94 = 3;
+#line 401 "src/server/router.v"
+	int ctx_95 = 0;
+	int buf_95 = 1;
+	int buf_95 = 2;
+	int items_95 = 3;
+#line 45 "src/server/handlers.v"
+	int req_96 = 0;
+	int conn_96 = 1;
+	int items_96 = 2;
+	int row_96 = 3;
+#line 711 "src/server/router.v"
+	int row_97 = 0;
+	int cfg_97 = 1;
+	int cfg_97 = 2;
+	int conn_97 = 3;
+#line 16 "src/cli/args.v"
+	int conn_98 = 0;
+	int items_98 = 1;
+	int conn_98 = 2;
+	int req_98 = 3;
+#line 511 "src/server/handlers.v"
+	int conn_99 = 0;
+	int row_99 = 1;
+	int ctx_99 = 2;
+	int opts_99 = 3;
+#line 813 "src/server/handlers.v"
+	int ctx_100 = 0;
+	int cfg_100 = 1;
+	int resp_100 = 2;
+	int row_100 = 3;
+#line 506 "src/cli/args.v"
+	int cfg_101 = 0;
+	int items_101 = 1;
+	int conn_101 = 2;
+	int req_101 = 3;
+#line 344 "src/db/models.v"
+	int resp_102 = 0;
+	int opts_102 = 1;
+	int ctx_102 = 2;
+	int req_102 = 3;
+#line 758 "src/main.v"
+	int row_103 = 0;
+	int conn_103 = 1;
+	int conn_103 = 2;
+	int opts_103 = 3;
+#line 34 "src/db/models.v"
+	int user_104 = 0;
+	int items_104 = 1;
+	int opts_104 = 2;
+	int row_104 = 3;
+#line 118 "src/cli/args.v"
+	int cfg_105 = 0;
+	int conn_105 = 1;
+	int buf_105 = 2;
+	int items_105 = 3;
+#line 544 "src/db/query.v"
+	int ctx_106 = 0;
+	int resp_106 = 1;
+	int ctx_106 = 2;
+	int buf_106 = 3;
+#line 543 "src/util/strings.v"
+	int buf_107 = 0;
+	int resp_107 = 1;
+	int buf_107 = 2;
+	int row_107 = 3;
+#line 86 "src/server/router.v"
+	int items_108 = 0;
+	int items_108 = 1;
+	int items_108 = 2;
+	int resp_108 = 3;
+#line 11 "src/server/router.v"
+	int req_109 = 0;
+	int req_109 = 1;
+	int conn_109 = 2;
+	int resp_109 = 3;
+#line 651 "src/db/models.v"
+	int user_110 = 0;
+	int opts_110 = 1;
+	int conn_110 = 2;
+	int resp_110 = 3;
+#line 717 "src/main.v"
+	int req_111 = 0;
+	int opts_111 = 1;
+	int req_111 = 2;
+	int row_111 = 3;
+#line 161 "src/cli/args.v"
+	int user_112 = 0;
+	int ctx_112 = 1;
+	int conn_112 = 2;
+	int cfg_112 = 3;
+#line 308 "src/db/models.v"
+	int conn_113 = 0;
+	int req_113 = 1;
+	int resp_113 = 2;
+	int opts_113 = 3;
+#line 586 "src/server/handlers.v"
+	int user_114 = 0;
+	int buf_114 = 1;
+	int ctx_114 = 2;
+	int row_114 = 3;
+#line 254 "src/cli/args.v"
+	int row_115 = 0;
+	int resp_115 = 1;
+	int resp_115 = 2;
+	int user_115 = 3;
+#line 379 "src/server/handlers.v"
+	int row_116 = 0;
+	int user_116 = 1;
+	int req_116 = 2;
+	int resp_116 = 3;
+#line 744 "src/cli/args.v"
+	int req_117 = 0;
+	int buf_117 = 1;
+	int ctx_117 = 2;
+	int conn_117 = 3;
+#line 668 "src/cli/args.v"
+	int cfg_118 = 0;
+	int conn_118 = 1;
+	int user_118 = 2;
+	int resp_118 = 3;
+#line 495 "src/main.v"
+	int req_119 = 0;
+	int ctx_119 = 1;
+	int cfg_119 = 2;
+	int resp_119 = 3;
+#line 679 "src/cli/args.v"
+	int row_120 = 0;
+	int ctx_120 = 1;
+	int row_120 = 2;
+	int user_120 = 3;
+#line 162 "src/main.v"
+	int row_121 = 0;
+	int items_121 = 1;
+	int cfg_121 = 2;
+	int user_121 = 3;
+#line 424 "src/cli/args.v"
+	int req_122 = 0;
+	int user_122 = 1;
+	int ctx_122 = 2;
+	int ctx_122 = 3;
+#line 596 "src/db/query.v"
+	int row_123 = 0;
+	int row_123 = 1;
+	int req_123 = 2;
+	int conn_123 = 3;
+#line 687 "src/main.v"
+	int resp_124 = 0;
+	int opts_124 = 1;
+	int opts_124 = 2;
+	int req_124 = 3;
+#line 374 "src/server/handlers.v"
+	int opts_125 = 0;
+	int user_125 = 1;
+	int opts_125 = 2;
+	int cfg_125 = 3;
+#line 389 "src/db/query.v"
+	int opts_126 = 0;
+	int buf_126 = 1;
+	int row_126 = 2;
+	int resp_126 = 3;
+#line 854 "src/db/models.v"
+	int conn_127 = 0;
+	int buf_127 = 1;
+	int items_127 = 2;
+	int items_127 = 3;
+#line 159 "src/server/handlers.v"
+	int resp_128 = 0;
+	int items_128 = 1;
+	int items_128 = 2;
+	int opts_128 = 3;
+#line 193 "src/db/query.v"
+	int resp_129 = 0;
+	int ctx_129 = 1;
+	int buf_129 = 2;
+	int row_129 = 3;
+#line 583 "src/db/models.v"
+	int cfg_130 = 0;
+	int items_130 = 1;
+	int cfg_130 = 2;
+	int items_130 = 3;
+#line 556 "src/server/handlers.v"
+	int items_131 = 0;
+	int ctx_131 = 1;
+	int buf_131 = 2;
+	int opts_131 = 3;
+#line 693 "src/util/strings.v"
+	int conn_132 = 0;
+	int resp_132 = 1;
+	int row_132 = 2;
+	int user_132 = 3;
+#line 106 "src/main.v"
+	int items_133 = 0;
+	int user_133 = 1;
+	int cfg_133 = 2;
+	int items_133 = 3;
+#line 738 "src/util/strings.v"
+	int conn_134 = 0;
+	int opts_134 = 1;
+	int conn_134 = 2;
+	int opts_134 = 3;
+#line 697 "src/util/strings.v"
+	int row_135 = 0;
+	int cfg_135 = 1;
+	int items_135 = 2;
+	int opts_135 = 3;
+#line 355 "src/main.v"
+	int resp_136 = 0;
+	int conn_136 = 1;
+	int items_136 = 2;
+	int user_136 = 3;
+#line 264 "src/main.v"
+	int ctx_137 = 0;
+	int req_137 = 1;
+	int buf_137 = 2;
+	int ctx_137 = 3;
+#line 120 "src/db/models.v"
+	int user_138 = 0;
+	int ctx_138 = 1;
+	int conn_138 = 2;
+	int resp_138 = 3;
+#line 860 "src/db/query.v"
+	int req_139 = 0;
+	int buf_139 = 1;
+	int req_139 = 2;
+	int items_139 = 3;
+#line 713 "src/cli/args.v"
+	int req_140 = 0;
+	int items_140 = 1;
+	int ctx_140 = 2;
+	int buf_140 = 3;
+#line 767 "src/server/handlers.v"
+	int conn_141 = 0;
+	int opts_141 = 1;
+	int resp_141 = 2;
+	int items_141 = 3;
+#line 639 "src/main.v"
+	int row_142 = 0;
+	int ctx_142 = 1;
+	int items_142 = 2;
+	int ctx_142 = 3;
+#line 464 "src/util/strings.v"
+	int ctx_143 = 0;
+	int req_143 = 1;
+	int resp_143 = 2;
+	int user_143 = 3;
+#line 716 "src/util/strings.v"
+	int items_144 = 0;
+	int cfg_144 = 1;
+	int conn_144 = 2;
+	int buf_144 = 3;
+#line 297 "src/cli/args.v"
+	int items_145 = 0;
+	int req_145 = 1;
+	int row_145 = 2;
+	int row_145 = 3;
+#line 611 "src/cli/args.v"
+	int opts_146 = 0;
+	int items_146 = 1;
+	int opts_146 = 2;
+	int items_146 = 3;
+#line 710 "src/db/query.v"
+	int conn_147 = 0;
+	int items_147 = 1;
+	int req_147 = 2;
+	int cfg_147 = 3;
+#line 830 "src/db/query.v"
+	int resp_148 = 0;
+	int buf_148 = 1;
+	int user_148 = 2;
+	int cfg_148 = 3;
+#line 449 "src/util/strings.v"
+	int req_149 = 0;
+	int conn_149 = 1;
+	int conn_149 = 2;
+	int row_149 = 3;
+#line 201 "src/util/strings.v"
+	int items_150 = 0;
+	int req_150 = 1;
+	int opts_150 = 2;
+	int opts_150 = 3;
+#line 65 "src/cli/args.v"
+	int req_151 = 0;
+	int resp_151 = 1;
+	int req_151 = 2;
+	int req_151 = 3;
+#line 278 "src/cli/args.v"
+	int row_152 = 0;
+	int row_152 = 1;
+	int resp_152 = 2;
+	int ctx_152 = 3;
+#line 133 "src/main.v"
+	int row_153 = 0;
+	int user_153 = 1;
+	int ctx_153 = 2;
+	int items_153 = 3;
+#line 196 "src/db/models.v"
+	int ctx_154 = 0;
+	int user_154 = 1;
+	int row_154 = 2;
+	int buf_154 = 3;
+#line 419 "src/main.v"
+	int req_155 = 0;
+	int buf_155 = 1;
+	int user_155 = 2;
+	int opts_155 = 3;
+#line 622 "src/db/query.v"
+	int ctx_156 = 0;
+	int row_156 = 1;
+	int resp_156 = 2;
+	int buf_156 = 3;
+#line 675 "src/server/router.v"
+	int cfg_157 = 0;
+	int user_157 = 1;
+	int buf_157 = 2;
+	int buf_157 = 3;
+#line 678 "src/cli/args.v"
+	int items_158 = 0;
+	int ctx_158 = 1;
+	int resp_158 = 2;
+	int req_158 = 3;
+#line 617 "src/cli/args.v"
+	int user_159 = 0;
+	int row_159 = 1;
+	int buf_159 = 2;
+	int items_159 = 3;
+#line 755 "src/cli/args.v"
+	int user_160 = 0;
+	int opts_160 = 1;
+	int ctx_160 = 2;
+	int items_160 = 3;
+#line 575 "src/server/router.v"
+	int resp_161 = 0;
+	int buf_161 = 1;
+	int buf_161 = 2;
+	int conn_161 = 3;
+#line 70 "src/db/models.v"
+	int items_162 = 0;
+	int cfg_162 = 1;
+	int ctx_162 = 2;
+	int items_162 = 3;
+#line 836 "src/main.v"
+	int conn_163 = 0;
+	int ctx_163 = 1;
+	int ctx_163 = 2;
+	int ctx_163 = 3;
+#line 452 "src/util/strings.v"
+	int items_164 = 0;
+	int ctx_164 = 1;
+	int items_164 = 2;
+	int resp_164 = 3;
+#line 703 "src/db/models.v"
+	int conn_165 = 0;
+	int conn_165 = 1;
+	int opts_165 = 2;
+	int req_165 = 3;
+#line 868 "src/db/models.v"
+	int buf_166 = 0;
+	int opts_166 = 1;
+	int items_166 = 2;
+	int cfg_166 = 3;
+#line 270 "src/main.v"
+	int items_167 = 0;
+	int ctx_167 = 1;
+	int user_167 = 2;
+	int user_167 = 3;
+#line 631 "src/server/router.v"
+	int conn_168 = 0;
+	int items_168 = 1;
+	int row_168 = 2;
+	int user_168 = 3;
+#line 369 "src/server/router.v"
+	int req_169 = 0;
+	int ctx_169 = 1;
+	int buf_169 = 2;
+	int resp_169 = 3;
+#line 889 "src/server/handlers.v"
+	int req_170 = 0;
+	int conn_170 = 1;
+	int row_170 = 2;
+	int resp_170 = 3;
+#line 408 "src/main.v"
+	int opts_171 = 0;
+	int conn_171 = 1;
+	int items_171 = 2;
+	int resp_171 = 3;
+#line 56 "src/db/query.v"
+	int resp_172 = 0;
+	int user_172 = 1;
+	int resp_172 = 2;
+	int user_172 = 3;
+#line 75 "src/server/router.v"
+	int req_173 = 0;
+	int ctx_173 = 1;
+	int conn_173 = 2;
+	int user_173 = 3;
+#line 461 "src/cli/args.v"
+	int resp_174 = 0;
+	int row_174 = 1;
+	int row_174 = 2;
+	int items_174 = 3;
+#line 276 "src/server/handlers.v"
+	int resp_175 = 0;
+	int items_175 = 1;
+	int user_175 = 2;
+	int resp_175 = 3;
+#line 621 "src/main.v"
+	int req_176 = 0;
+	int opts_176 = 1;
+	int req_176 = 2;
+	int req_176 = 3;
+#line 290 "src/server/router.v"
+	int opts_177 = 0;
+	int req_177 = 1;
+	int items_177 = 2;
+	int conn_177 = 3;
+#line 440 "src/cli/args.v"
+	int req_178 = 0;
+	int cfg_178 = 1;
+	int row_178 = 2;
+	int cfg_178 = 3;
+#line 596 "src/server/handlers.v"
+	int buf_179 = 0;
+	int row_179 = 1;
+	int conn_179 = 2;
+	int resp_179 = 3;
+#line 424 "src/db/query.v"
+	int conn_180 = 0;
+	int req_180 = 1;
+	int user_180 = 2;
+	int req_180 = 3;
+#line 260 "src/cli/args.v"
+	int req_181 = 0;
+	int opts_181 = 1;
+	int resp_181 = 2;
+	int items_181 = 3;
+#line 594 "src/main.v"
+	int req_182 = 0;
+	int buf_182 = 1;
+	int user_182 = 2;
+	int ctx_182 = 3;
+#line 258 "src/main.v"
+	int items_183 = 0;
+	int conn_183 = 1;
+	int ctx_183 = 2;
+	int conn_183 = 3;
+#line 867 "src/main.v"
+	int user_184 = 0;
+	int resp_184 = 1;
+	int ctx_184 = 2;
+	int items_184 = 3;
+#line 188 "src/db/models.v"
+	int user_185 = 0;
+	int items_185 = 1;
+	int buf_185 = 2;
+	int buf_185 = 3;
+#line 160 "src/db/query.v"
+	int buf_186 = 0;
+	int resp_186 = 1;
+	int req_186 = 2;
+	int req_186 = 3;
+#line 142 "src/server/handlers.v"
+	int buf_187 = 0;
+	int cfg_187 = 1;
+	int user_187 = 2;
+	int buf_187 = 3;
+#line 666 "src/db/models.v"
+	int opts_188 = 0;
+	int resp_188 = 1;
+	int opts_188 = 2;
+	int cfg_188 = 3;
+#line 793 "src/db/models.v"
+	int req_189 = 0;
+	int items_189 = 1;
+	int ctx_189 = 2;
+	int resp_189 = 3;
+#line 418 "src/db/query.v"
+	int resp_190 = 0;
+	int resp_190 = 1;
+	int resp_190 = 2;
+	int buf_190 = 3;
+#line 120 "src/db/query.v"
+	int opts_191 = 0;
+	int buf_191 = 1;
+	int ctx_191 = 2;
+	int conn_191 = 3;
+#line 169 "src/util/strings.v"
+	int items_192 = 0;
+	int opts_192 = 1;
+	int conn_192 = 2;
+	int ctx_192 = 3;
+#line 850 "src/db/models.v"
+	int opts_193 = 0;
+	int opts_193 = 1;
+	int req_193 = 2;
+	int opts_193 = 3;
+#line 188 "src/main.v"
+	int buf_194 = 0;
+	int opts_194 = 1;
+	int buf_194 = 2;
+	int user_194 = 3;
+#line 773 "src/cli/args.v"
+	int cfg_195 = 0;
+	int buf_195 = 1;
+	int row_195 = 2;
+	int cfg_195 = 3;
+#line 697 "src/cli/args.v"
+	int cfg_196 = 0;
+	int ctx_196 = 1;
+	int conn_196 = 2;
+	int user_196 = 3;
+#line 770 "src/db/models.v"
+	int user_197 = 0;
+	int row_197 = 1;
+	int ctx_197 = 2;
+	int buf_197 = 3;
+#line 178 "src/db/models.v"
+	int cfg_198 = 0;
+	int buf_198 = 1;
+	int opts_198 = 2;
+	int user_198 = 3;
+#line 461 "src/util/strings.v"
+	int req_199 = 0;
+	int req_199 = 1;
+	int buf_199 = 2;
+	int buf_199 = 3;
+#line 127 "src/main.v"
+	int opts_200 = 0;
+	int resp_200 = 1;
+	int ctx_200 = 2;
+	int conn_200 = 3;
+#line 594 "src/cli/args.v"
+	int opts_201 = 0;
+	int user_201 = 1;
+	int items_201 = 2;
+	int conn_201 = 3;
+#line 112 "src/server/handlers.v"
+	int user_202 = 0;
+	int cfg_202 = 1;
+	int conn_202 = 2;
+	int ctx_202 = 3;
+#line 25 "src/db/query.v"
+	int conn_203 = 0;
+	int opts_203 = 1;
+	int row_203 = 2;
+	int items_203 = 3;
+#line 225 "src/main.v"
+	int req_204 = 0;
+	int req_204 = 1;
+	int buf_204 = 2;
+	int ctx_204 = 3;
+#line 43 "src/cli/args.v"
+	int ctx_205 = 0;
+	int opts_205 = 1;
+	int conn_205 = 2;
+	int row_205 = 3;
+#line 668 "src/db/models.v"
+	int row_206 = 0;
+	int conn_206 = 1;
+	int items_206 = 2;
+	int buf_206 = 3;
+#line 348 "src/server/handlers.v"
+	int ctx_207 = 0;
+	int buf_207 = 1;
+	int cfg_207 = 2;
+	int ctx_207 = 3;
+#line 891 "src/server/handlers.v"
+	int cfg_208 = 0;
+	int cfg_208 = 1;
+	int buf_208 = 2;
+	int conn_208 = 3;
+#line 533 "src/util/strings.v"
+	int items_209 = 0;
+	int opts_209 = 1;
+	int user_209 = 2;
+	int ctx_209 = 3;
+#line 255 "src/cli/args.v"
+	int user_210 = 0;
+	int resp_210 = 1;
+	int buf_210 = 2;
+	int ctx_210 = 3;
+#line 501 "src/db/query.v"
+	int cfg_211 = 0;
+	int buf_211 = 1;
+	int opts_211 = 2;
+	int items_211 = 3;
+#line 443 "src/db/models.v"
+	int items_212 = 0;
+	int buf_212 = 1;
+	int conn_212 = 2;
+	int items_212 = 3;
+#line 255 "src/db/models.v"
+	int user_213 = 0;
+	int req_213 = 1;
+	int ctx_213 = 2;
+	int resp_213 = 3;
+#line 546 "src/db/models.v"
+	int items_214 = 0;
+	int cfg_214 = 1;
+	int row_214 = 2;
+	int resp_214 = 3;
+#line 617 "src/util/strings.v"
+	int row_215 = 0;
+	int buf_215 = 1;
+	int ctx_215 = 2;
+	int conn_215 = 3;
+#line 67 "src/cli/args.v"
+	int ctx_216 = 0;
+	int conn_216 = 1;
+	int items_216 = 2;
+	int user_216 = 3;
+#line 197 "src/db/models.v"
+	int items_217 = 0;
+	int resp_217 = 1;
+	int buf_217 = 2;
+	int buf_217 = 3;
+#line 60 "src/server/handlers.v"
+	int opts_218 = 0;
+	int cfg_218 = 1;
+	int user_218 = 2;
+	int resp_218 = 3;
+#line 128 "src/server/router.v"
+	int row_219 = 0;
+	int conn_219 = 1;
+	int buf_219 = 2;
+	int items_219 = 3;
+#line 195 "src/db/models.v"
+	int row_220 = 0;
+	int req_220 = 1;
+	int ctx_220 = 2;
+	int row_220 = 3;
+#line 845 "src/util/strings.v"
+	int opts_221 = 0;
+	int row_221 = 1;
+	int row_221 = 2;
+	int items_221 = 3;
+#line 238 "src/server/router.v"
+	int ctx_222 = 0;
+	int row_222 = 1;
+	int req_222 = 2;
+	int opts_222 = 3;
+#line 667 "src/cli/args.v"
+	int buf_223 = 0;
+	int cfg_223 = 1;
+	int items_223 = 2;
+	int resp_223 = 3;
+#line 799 "src/server/router.v"
+	int cfg_224 = 0;
+	int buf_224 = 1;
+	int ctx_224 = 2;
+	int req_224 = 3;
+#line 623 "src/cli/args.v"
+	int items_225 = 0;
+	int user_225 = 1;
+	int row_225 = 2;
+	int buf_225 = 3;
+#line 11 "src/db/query.v"
+	int items_226 = 0;
+	int cfg_226 = 1;
+	int conn_226 = 2;
+	int user_226 = 3;
+#line 755 "src/cli/args.v"
+	int user_227 = 0;
+	int cfg_227 = 1;
+	int req_227 = 2;
+	int user_227 = 3;
+#line 240 "src/util/strings.v"
+	int user_228 = 0;
+	int req_228 = 1;
+	int items_228 = 2;
+	int opts_228 = 3;
+#line 832 "src/cli/args.v"
+	int req_229 = 0;
+	int items_229 = 1;
+	int req_229 = 2;
+	int cfg_229 = 3;
+#line 855 "src/server/router.v"
+	int buf_230 = 0;
+	int row_230 = 1;
+	int buf_230 = 2;
+	int opts_230 = 3;
+#line 677 "src/db/query.v"
+	int buf_231 = 0;
+	int user_231 = 1;
+	int req_231 = 2;
+	int row_231 = 3;
+#line 339 "src/db/query.v"
+	int user_232 = 0;
+	int items_232 = 1;
+	int resp_232 = 2;
+	int row_232 = 3;
+#line 361 "src/cli/args.v"
+	int opts_233 = 0;
+	int req_233 = 1;
+	int ctx_233 = 2;
+	int buf_233 = 3;
+#line 153 "src/server/router.v"
+	int ctx_234 = 0;
+	int req_234 = 1;
+	int resp_234 = 2;
+	int ctx_234 = 3;
+#line 464 "src/server/router.v"
+	int cfg_235 = 0;
+	int items_235 = 1;
+	int req_235 = 2;
+	int cfg_235 = 3;
+#line 337 "src/server/router.v"
+	int user_236 = 0;
+	int user_236 = 1;
+	int resp_236 = 2;
+	int conn_236 = 3;
+#line 405 "src/db/query.v"
+	int cfg_237 = 0;
+	int row_237 = 1;
+	int cfg_237 = 2;
+	int resp_237 = 3;
+#line 883 "src/db/models.v"
+	int items_238 = 0;
+	int ctx_238 = 1;
+	int user_238 = 2;
+	int resp_238 = 3;
+#line 476 "src/cli/args.v"
+	int resp_239 = 0;
+	int conn_239 = 1;
+	int resp_239 = 2;
+	int conn_239 = 3;
+#line 802 "src/main.v"
+	int opts_240 = 0;
+	int buf_240 = 1;
+	int cfg_240 = 2;
+	int req_240 = 3;
+#line 204 "src/server/router.v"
+	int user_241 = 0;
+	int items_241 = 1;
+	int ctx_241 = 2;
+	int opts_241 = 3;
+#line 738 "src/server/handlers.v"
+	int buf_242 = 0;
+	int buf_242 = 1;
+	int resp_242 = 2;
+	int ctx_242 = 3;
+#line 861 "src/server/router.v"
+	int user_243 = 0;
+	int conn_243 = 1;
+	int buf_243 = 2;
+	int buf_243 = 3;
+#line 747 "src/cli/args.v"
+	int cfg_244 = 0;
+	int resp_244 = 1;
+	int resp_244 = 2;
+	int cfg_244 = 3;
+#line 56 "src/db/query.v"
+	int req_245 = 0;
+	int opts_245 = 1;
+	int req_245 = 2;
+	int user_245 = 3;
+#line 778 "src/db/query.v"
+	int cfg_246 = 0;
+	int resp_246 = 1;
+	int ctx_246 = 2;
+	int buf_246 = 3;
+#line 869 "src/util/strings.v"
+	int items_247 = 0;
+	int resp_247 = 1;
+	int ctx_247 = 2;
+	int req_247 = 3;
+#line 65 "src/server/handlers.v"
+	int user_248 = 0;
+	int buf_248 = 1;
+	int row_248 = 2;
+	int conn_248 = 3;
+#line 489 "src/server/handlers.v"
+	int resp_249 = 0;
+	int cfg_249 = 1;
+	int req_249 = 2;
+	int items_249 = 3;
+#line 870 "src/db/models.v"
+	int ctx_250 = 0;
+	int buf_250 = 1;
+	int user_250 = 2;
+	int conn_250 = 3;
+#line 387 "src/main.v"
+	int conn_251 = 0;
+	int resp_251 = 1;
+	int user_251 = 2;
+	int conn_251 = 3;
+#line 611 "src/db/models.v"
+	int conn_252 = 0;
+	int buf_252 = 1;
+	int buf_252 = 2;
+	int conn_252 = 3;
+#line 194 "src/cli/args.v"
+	int user_253 = 0;
+	int conn_253 = 1;
+	int opts_253 = 2;
+	int ctx_253 = 3;
+#line 777 "src/main.v"
+	int resp_254 = 0;
+	int ctx_254 = 1;
+	int conn_254 = 2;
+	int req_254 = 3;
+#line 783 "src/db/query.v"
+	int resp_255 = 0;
+	int conn_255 = 1;
+	int buf_255 = 2;
+	int cfg_255 = 3;
+#line 423 "src/server/router.v"
+	int resp_256 = 0;
+	int conn_256 = 1;
+	int items_256 = 2;
+	int items_256 = 3;
+#line 48 "src/util/strings.v"
+	int buf_257 = 0;
+	int ctx_257 = 1;
+	int ctx_257 = 2;
+	int row_257 = 3;
+#line 221 "src/db/models.v"
+	int opts_258 = 0;
+	int conn_258 = 1;
+	int opts_258 = 2;
+	int resp_258 = 3;
+#line 254 "src/server/handlers.v"
+	int user_259 = 0;
+	int ctx_259 = 1;
+	int req_259 = 2;
+	int resp_259 = 3;
+#line 794 "src/cli/args.v"
+	int ctx_260 = 0;
+	int items_260 = 1;
+	int ctx_260 = 2;
+	int cfg_260 = 3;
+#line 292 "src/server/handlers.v"
+	int resp_261 = 0;
+	int row_261 = 1;
+	int row_261 = 2;
+	int cfg_261 = 3;
+#line 608 "src/server/router.v"
+	int row_262 = 0;
+	int ctx_262 = 1;
+	int row_262 = 2;
+	int cfg_262 = 3;
+#line 612 "src/cli/args.v"
+	int buf_263 = 0;
+	int buf_263 = 1;
+	int resp_263 = 2;
+	int row_263 = 3;
+#line 641 "src/main.v"
+	int req_264 = 0;
+	int cfg_264 = 1;
+	int req_264 = 2;
+	int cfg_264 = 3;
+#line 663 "src/cli/args.v"
+	int ctx_265 = 0;
+	int user_265 = 1;
+	int row_265 = 2;
+	int ctx_265 = 3;
+#line 391 "src/server/handlers.v"
+	int cfg_266 = 0;
+	int user_266 = 1;
+	int user_266 = 2;
+	int opts_266 = 3;
+#line 689 "src/server/handlers.v"
+	int resp_267 = 0;
+	int conn_267 = 1;
+	int req_267 = 2;
+	int conn_267 = 3;
+#line 499 "src/server/handlers.v"
+	int row_268 = 0;
+	int resp_268 = 1;
+	int conn_268 = 2;
+	int user_268 = 3;
+#line 711 "src/db/models.v"
+	int cfg_269 = 0;
+	int items_269 = 1;
+	int cfg_269 = 2;
+	int resp_269 = 3;
+#line 369 "src/server/router.v"
+	int opts_270 = 0;
+	int items_270 = 1;
+	int buf_270 = 2;
+	int buf_270 = 3;
+#line 635 "src/server/router.v"
+	int conn_271 = 0;
+	int cfg_271 = 1;
+	int row_271 = 2;
+	int row_271 = 3;
+#line 135 "src/server/router.v"
+	int row_272 = 0;
+	int items_272 = 1;
+	int row_272 = 2;
+	int items_272 = 3;
+#line 468 "src/util/strings.v"
+	int opts_273 = 0;
+	int buf_273 = 1;
+	int cfg_273 = 2;
+	int buf_273 = 3;
+#line 527 "src/cli/args.v"
+	int cfg_274 = 0;
+	int buf_274 = 1;
+	int buf_274 = 2;
+	int req_274 = 3;
+#line 189 "src/db/models.v"
+	int items_275 = 0;
+	int cfg_275 = 1;
+	int buf_275 = 2;
+	int buf_275 = 3;
+#line 769 "src/util/strings.v"
+	int row_276 = 0;
+	int ctx_276 = 1;
+	int row_276 = 2;
+	int req_276 = 3;
+#line 514 "src/main.v"
+	int user_277 = 0;
+	int user_277 = 1;
+	int items_277 = 2;
+	int req_277 = 3;
+#line 497 "src/server/router.v"
+	int items_278 = 0;
+	int req_278 = 1;
+	int opts_278 = 2;
+	int row_278 = 3;
+#line 91 "src/server/router.v"
+	int items_279 = 0;
+	int row_279 = 1;
+	int user_279 = 2;
+	int buf_279 = 3;
+#line 453 "src/cli/args.v"
+	int items_280 = 0;
+	int ctx_280 = 1;
+	int cfg_280 = 2;
+	int resp_280 = 3;
+#line 732 "src/server/handlers.v"
+	int items_281 = 0;
+	int opts_281 = 1;
+	int opts_281 = 2;
+	int items_281 = 3;
+#line 623 "src/cli/args.v"
+	int ctx_282 = 0;
+	int items_282 = 1;
+	int resp_282 = 2;
+	int req_282 = 3;
+#line 101 "src/db/models.v"
+	int user_283 = 0;
+	int cfg_283 = 1;
+	int opts_283 = 2;
+	int req_283 = 3;
+#line 177 "src/server/router.v"
+	int user_284 = 0;
+	int resp_284 = 1;
+	int cfg_284 = 2;
+	int resp_284 = 3;
+#line 337 "src/server/router.v"
+	int req_285 = 0;
+	int cfg_285 = 1;
+	int req_285 = 2;
+	int conn_285 = 3;
+#line 344 "src/main.v"
+	int resp_286 = 0;
+	int buf_286 = 1;
+	int conn_286 = 2;
+	int conn_286 = 3;
+#line 577 "src/db/models.v"
+	int buf_287 = 0;
+	int resp_287 = 1;
+	int user_287 = 2;
+	int resp_287 = 3;
+#line 503 "src/cli/args.v"
+	int req_288 = 0;
+	int ctx_288 = 1;
+	int ctx_288 = 2;
+	int ctx_288 = 3;
+#line 120 "src/db/models.v"
+	int conn_289 = 0;
+	int conn_289 = 1;
+	int req_289 = 2;
+	int opts_289 = 3;
+#line 488 "src/main.v"
+	int resp_290 = 0;
+	int conn_290 = 1;
+	int opts_290 = 2;
+	int cfg_290 = 3;
+#line 845 "src/db/models.v"
+	int ctx_291 = 0;
+	int req_291 = 1;
+	int row_291 = 2;
+	int buf_291 = 3;
+#line 114 "src/db/models.v"
+	int req_292 = 0;
+	int cfg_292 = 1;
+	int ctx_292 = 2;
+	int buf_292 = 3;
+#line 727 "src/db/models.v"
+	int user_293 = 0;
+	int opts_293 = 1;
+	int ctx_293 = 2;
+	int row_293 = 3;
+#line 536 "src/server/handlers.v"
+	int cfg_294 = 0;
+	int ctx_294 = 1;
+	int resp_294 = 2;
+	int buf_294 = 3;
+#line 359 "src/cli/args.v"
+	int req_295 = 0;
+	int resp_295 = 1;
+	int user_295 = 2;
+	int cfg_295 = 3;
+#line 625 "src/db/query.v"
+	int items_296 = 0;
+	int conn_296 = 1;
+	int ctx_296 = 2;
+	int ctx_296 = 3;
+#line 292 "src/server/handlers.v"
+	int req_297 = 0;
+	int opts_297 = 1;
+	int ctx_297 = 2;
+	int user_297 = 3;
+#line 489 "src/server/router.v"
+	int cfg_298 = 0;
+	int resp_298 = 1;
+	int user_298 = 2;
+	int cfg_298 = 3;
+#line 406 "src/server/router.v"
+	int user_299 = 0;
+	int user_299 = 1;
+	int buf_299 = 2;
+	int opts_299 = 3;
+#line 520 "src/main.v"
+	int ctx_300 = 0;
+	int buf_300 = 1;
+	int resp_300 = 2;
+	int opts_300 = 3;
+#line 558 "src/main.v"
+	int ctx_301 = 0;
+	int conn_301 = 1;
+	int row_301 = 2;
+	int conn_301 = 3;
+#line 842 "src/db/models.v"
+	int resp_302 = 0;
+	int cfg_302 = 1;
+	int resp_302 = 2;
+	int buf_302 = 3;
+#line 338 "src/cli/args.v"
+	int cfg_303 = 0;
+	int opts_303 = 1;
+	int resp_303 = 2;
+	int req_303 = 3;
+#line 332 "src/cli/args.v"
+	int row_304 = 0;
+	int req_304 = 1;
+	int ctx_304 = 2;
+	int opts_304 = 3;
+#line 300 "src/db/query.v"
+	int opts_305 = 0;
+	int req_305 = 1;
+	int cfg_305 = 2;
+	int conn_305 = 3;
+#line 594 "src/cli/args.v"
+	int opts_306 = 0;
+	int resp_306 = 1;
+	int resp_306 = 2;
+	int items_306 = 3;
+#line 68 "src/db/query.v"
+	int buf_307 = 0;
+	int row_307 = 1;
+	int conn_307 = 2;
+	int user_307 = 3;
+#line 119 "src/cli/args.v"
+	int user_308 = 0;
+	int items_308 = 1;
+	int opts_308 = 2;
+	int row_308 = 3;
+#line 254 "src/server/handlers.v"
+	int conn_309 = 0;
+	int ctx_309 = 1;
+	int items_309 = 2;
+	int conn_309 = 3;
+#line 811 "src/db/models.v"
+	int buf_310 = 0;
+	int user_310 = 1;
+	int cfg_310 = 2;
+	int opts_310 = 3;
+#line 573 "src/server/handlers.v"
+	int cfg_311 = 0;
+	int items_311 = 1;
+	int opts_311 = 2;
+	int buf_311 = 3;
+#line 124 "src/db/query.v"
+	int buf_312 = 0;
+	int conn_312 = 1;
+	int resp_312 = 2;
+	int items_312 = 3;
+#line 422 "src/cli/args.v"
+	int items_313 = 0;
+	int items_313 = 1;
+	int resp_313 = 2;
+	int opts_313 = 3;
+#line 263 "src/db/query.v"
+	int buf_314 = 0;
+	int buf_314 = 1;
+	int user_314 = 2;
+	int resp_314 = 3;
+#line 814 "src/server/handlers.v"
+	int items_315 = 0;
+	int conn_315 = 1;
+	int req_315 = 2;
+	int conn_315 = 3;
+#line 72 "src/server/handlers.v"
+	int conn_316 = 0;
+	int conn_316 = 1;
+	int opts_316 = 2;
+	int row_316 = 3;
+#line 195 "src/main.v"
+	int req_317 = 0;
+	int user_317 = 1;
+	int req_317 = 2;
+	int buf_317 = 3;
+#line 330 "src/util/strings.v"
+	int conn_318 = 0;
+	int cfg_318 = 1;
+	int user_318 = 2;
+	int user_318 = 3;
+#line 292 "src/util/strings.v"
+	int req_319 = 0;
+	int cfg_319 = 1;
+	int user_319 = 2;
+	int req_319 = 3;
+#line 349 "src/db/models.v"
+	int opts_320 = 0;
+	int conn_320 = 1;
+	int ctx_320 = 2;
+	int items_320 = 3;
+#line 756 "src/server/router.v"
+	int row_321 = 0;
+	int ctx_321 = 1;
+	int req_321 = 2;
+	int resp_321 = 3;
+#line 793 "src/cli/args.v"
+	int opts_322 = 0;
+	int buf_322 = 1;
+	int resp_322 = 2;
+	int resp_322 = 3;
+#line 608 "src/main.v"
+	int resp_323 = 0;
+	int req_323 = 1;
+	int ctx_323 = 2;
+	int ctx_323 = 3;
+#line 536 "src/main.v"
+	int conn_324 = 0;
+	int user_324 = 1;
+	int ctx_324 = 2;
+	int opts_324 = 3;
+#line 410 "src/cli/args.v"
+	int opts_325 = 0;
+	int resp_325 = 1;
+	int resp_325 = 2;
+	int buf_325 = 3;
+#line 139 "src/server/router.v"
+	int buf_326 = 0;
+	int opts_326 = 1;
+	int user_326 = 2;
+	int opts_326 = 3;
+#line 72 "src/db/query.v"
+	int conn_327 = 0;
+	int user_327 = 1;
+	int cfg_327 = 2;
+	int cfg_327 = 3;
+#line 663 "src/db/query.v"
+	int resp_328 = 0;
+	int ctx_328 = 1;
+	int items_328 = 2;
+	int buf_328 = 3;
+#line 242 "src/cli/args.v"
+	int ctx_329 = 0;
+	int conn_329 = 1;
+	int buf_329 = 2;
+	int cfg_329 = 3;
+#line 409 "src/cli/args.v"
+	int conn_330 = 0;
+	int conn_330 = 1;
+	int buf_330 = 2;
+	int row_330 = 3;
+#line 119 "src/server/router.v"
+	int resp_331 = 0;
+	int opts_331 = 1;
+	int user_331 = 2;
+	int req_331 = 3;
+#line 894 "src/server/router.v"
+	int opts_332 = 0;
+	int user_332 = 1;
+	int opts_332 = 2;
+	int ctx_332 = 3;
+#line 854 "src/server/router.v"
+	int row_333 = 0;
+	int opts_333 = 1;
+	int req_333 = 2;
+	int buf_333 = 3;
+#line 474 "src/server/handlers.v"
+	int ctx_334 = 0;
+	int row_334 = 1;
+	int buf_334 = 2;
+	int opts_334 = 3;
+#line 406 "src/db/query.v"
+	int ctx_335 = 0;
+	int buf_335 = 1;
+	int conn_335 = 2;
+	int opts_335 = 3;
+#line 705 "src/cli/args.v"
+	int opts_336 = 0;
+	int conn_336 = 1;
+	int buf_336 = 2;
+	int items_336 = 3;
+#line 510 "src/main.v"
+	int resp_337 = 0;
+	int buf_337 = 1;
+	int row_337 = 2;
+	int req_337 = 3;
+#line 44 "src/server/router.v"
+	int opts_338 = 0;
+	int req_338 = 1;
+	int row_338 = 2;
+	int items_338 = 3;
+#line 633 "src/db/models.v"
+	int req_339 = 0;
+	int resp_339 = 1;
+	int req_339 = 2;
+	int items_339 = 3;
+#line 808 "src/main.v"
+	int resp_340 = 0;
+	int opts_340 = 1;
+	int ctx_340 = 2;
+	int user_340 = 3;
+#line 548 "src/server/handlers.v"
+	int cfg_341 = 0;
+	int ctx_341 = 1;
+	int resp_341 = 2;
+	int user_341 = 3;
+#line 338 "src/server/handlers.v"
+	int req_342 = 0;
+	int buf_342 = 1;
+	int cfg_342 = 2;
+	int row_342 = 3;
+#line 311 "src/util/strings.v"
+	int opts_343 = 0;
+	int user_343 = 1;
+	int req_343 = 2;
+	int req_343 = 3;
+#line 91 "src/cli/args.v"
+	int buf_344 = 0;
+	int opts_344 = 1;
+	int opts_344 = 2;
+	int opts_344 = 3;
+#line 423 "src/db/models.v"
+	int ctx_345 = 0;
+	int ctx_345 = 1;
+	int resp_345 = 2;
+	int req_345 = 3;
+#line 566 "src/main.v"
+	int items_346 = 0;
+	int resp_346 = 1;
+	int opts_346 = 2;
+	int conn_346 = 3;
+#line 529 "src/server/handlers.v"
+	int req_347 = 0;
+	int resp_347 = 1;
+	int ctx_347 = 2;
+	int resp_347 = 3;
+#line 146 "src/cli/args.v"
+	int buf_348 = 0;
+	int opts_348 = 1;
+	int user_348 = 2;
+	int conn_348 = 3;
+#line 525 "src/cli/args.v"
+	int items_349 = 0;
+	int row_349 = 1;
+	int conn_349 = 2;
+	int row_349 = 3;
+#line 563 "src/db/query.v"
+	int items_350 = 0;
+	int conn_350 = 1;
+	int conn_350 = 2;
+	int row_350 = 3;
+#line 802 "src/util/strings.v"
+	int req_351 = 0;
+	int buf_351 = 1;
+	int conn_351 = 2;
+	int resp_351 = 3;
+#line 290 "src/db/models.v"
+	int ctx_352 = 0;
+	int conn_352 = 1;
+	int conn_352 = 2;
+	int buf_352 = 3;
+#line 758 "src/main.v"
+	int opts_353 = 0;
+	int items_353 = 1;
+	int cfg_353 = 2;
+	int opts_353 = 3;
+#line 681 "src/db/query.v"
+	int row_354 = 0;
+	int items_354 = 1;
+	int buf_354 = 2;
+	int ctx_354 = 3;
+#line 768 "src/cli/args.v"
+	int opts_355 = 0;
+	int conn_355 = 1;
+	int cfg_355 = 2;
+	int row_355 = 3;
+#line 467 "src/server/router.v"
+	int buf_356 = 0;
+	int cfg_356 = 1;
+	int ctx_356 = 2;
+	int buf_356 = 3;
+#line 184 "src/cli/args.v"
+	int user_357 = 0;
+	int row_357 = 1;
+	int opts_357 = 2;
+	int opts_357 = 3;
+#line 462 "src/util/strings.v"
+	int ctx_358 = 0;
+	int ctx_358 = 1;
+	int ctx_358 = 2;
+	int conn_358 = 3;
+#line 360 "src/main.v"
+	int req_359 = 0;
+	int resp_359 = 1;
+	int cfg_359 = 2;
+	int conn_359 = 3;
+#line 583 "src/util/strings.v"
+	int items_360 = 0;
+	int conn_360 = 1;
+	int conn_360 = 2;
+	int user_360 = 3;
+#line 616 "src/cli/args.v"
+	int ctx_361 = 0;
+	int user_361 = 1;
+	int resp_361 = 2;
+	int row_361 = 3;
+#line 27 "src/util/strings.v"
+	int items_362 = 0;
+	int user_362 = 1;
+	int req_362 = 2;
+	int ctx_362 = 3;
+#line 818 "src/main.v"
+	int req_363 = 0;
+	int buf_363 = 1;
+	int resp_363 = 2;
+	int req_363 = 3;
+#line 283 "src/cli/args.v"
+	int row_364 = 0;
+	int row_364 = 1;
+	int conn_364 = 2;
+	int cfg_364 = 3;
+#line 799 "src/main.v"
+	int buf_365 = 0;
+	int row_365 = 1;
+	int cfg_365 = 2;
+	int ctx_365 = 3;
+#line 432 "src/cli/args.v"
+	int req_366 = 0;
+	int opts_366 = 1;
+	int opts_366 = 2;
+	int opts_366 = 3;
+#line 698 "src/util/strings.v"
+	int items_367 = 0;
+	int row_367 = 1;
+	int ctx_367 = 2;
+	int items_367 = 3;
+#line 355 "src/server/handlers.v"
+	int conn_368 = 0;
+	int row_368 = 1;
+	int conn_368 = 2;
+	int row_368 = 3;
+#line 249 "src/server/router.v"
+	int buf_369 = 0;
+	int cfg_369 = 1;
+	int resp_369 = 2;
+	int conn_369 = 3;
+#line 545 "src/cli/args.v"
+	int items_370 = 0;
+	int row_370 = 1;
+	int req_370 = 2;
+	int row_370 = 3;
+#line 600 "src/main.v"
+	int req_371 = 0;
+	int opts_371 = 1;
+	int items_371 = 2;
+	int cfg_371 = 3;
+#line 123 "src/util/strings.v"
+	int resp_372 = 0;
+	int buf_372 = 1;
+	int user_372 = 2;
+	int row_372 = 3;
+#line 233 "src/db/models.v"
+	int user_373 = 0;
+	int user_373 = 1;
+	int opts_373 = 2;
+	int cfg_373 = 3;
+#line 539 "src/util/strings.v"
+	int req_374 = 0;
+	int items_374 = 1;
+	int req_374 = 2;
+	int ctx_374 = 3;
+#line 749 "src/main.v"
+	int cfg_375 = 0;
+	int conn_375 = 1;
+	int conn_375 = 2;
+	int user_375 = 3;
+#line 149 "src/main.v"
+	int row_376 = 0;
+	int ctx_376 = 1;
+	int buf_376 = 2;
+	int user_376 = 3;
+#line 681 "src/main.v"
+	int row_377 = 0;
+	int cfg_377 = 1;
+	int resp_377 = 2;
+	int req_377 = 3;
+#line 746 "src/util/strings.v"
+	int cfg_378 = 0;
+	int opts_378 = 1;
+	int opts_378 = 2;
+	int buf_378 = 3;
+#line 269 "src/cli/args.v"
+	int cfg_379 = 0;
+	int opts_379 = 1;
+	int conn_379 = 2;
+	int user_379 = 3;
+#line 796 "src/server/handlers.v"
+	int ctx_380 = 0;
+	int row_380 = 1;
+	int ctx_380 = 2;
+	int resp_380 = 3;
+#line 781 "src/util/strings.v"
+	int user_381 = 0;
+	int buf_381 = 1;
+	int opts_381 = 2;
+	int buf_381 = 3;
+#line 892 "src/main.v"
+	int buf_382 = 0;
+	int ctx_382 = 1;
+	int ctx_382 = 2;
+	int resp_382 = 3;
+#line 272 "src/main.v"
+	int opts_383 = 0;
+	int opts_383 = 1;
+	int conn_383 = 2;
+	int req_383 = 3;
+#line 500 "src/util/strings.v"
+	int items_384 = 0;
+	int opts_384 = 1;
+	int opts_384 = 2;
+	int conn_384 = 3;
+#line 662 "src/main.v"
+	int opts_385 = 0;
+	int row_385 = 1;
+	int ctx_385 = 2;
+	int conn_385 = 3;
+#line 412 "src/main.v"
+	int items_386 = 0;
+	int user_386 = 1;
+	int opts_386 = 2;
+	int user_386 = 3;
+#line 796 "src/db/models.v"
+	int buf_387 = 0;
+	int row_387 = 1;
+	int opts_387 = 2;
+	int ctx_387 = 3;
+#line 561 "src/server/handlers.v"
+	int req_388 = 0;
+	int resp_388 = 1;
+	int items_388 = 2;
+	int opts_388 = 3;
+#line 725 "src/db/query.v"
+	int row_389 = 0;
+	int req_389 = 1;
+	int conn_389 = 2;
+	int ctx_389 = 3;
+#line 407 "src/server/router.v"
+	int items_390 = 0;
+	int ctx_390 = 1;
+	int user_390 = 2;
+	int ctx_390 = 3;
+#line 524 "src/db/models.v"
+	int buf_391 = 0;
+	int cfg_391 = 1;
+	int items_391 = 2;
+	int resp_391 = 3;
+#line 33 "src/main.v"
+	int conn_392 = 0;
+	int row_392 = 1;
+	int buf_392 = 2;
+	int req_392 = 3;
+#line 893 "src/server/router.v"
+	int ctx_393 = 0;
+	int items_393 = 1;
+	int cfg_393 = 2;
+	int req_393 = 3;
+#line 104 "src/server/router.v"
+	int row_394 = 0;
+	int req_394 = 1;
+	int row_394 = 2;
+	int buf_394 = 3;
+#line 340 "src/db/query.v"
+	int items_395 = 0;
+	int row_395 = 1;
+	int ctx_395 = 2;
+	int opts_395 = 3;
+#line 262 "src/main.v"
+	int cfg_396 = 0;
+	int resp_396 = 1;
+	int ctx_396 = 2;
+	int buf_396 = 3;
+#line 822 "src/main.v"
+	int row_397 = 0;
+	int ctx_397 = 1;
+	int items_397 = 2;
+	int ctx_397 = 3;
+#line 592 "src/util/strings.v"
+	int items_398 = 0;
+	int row_398 = 1;
+	int row_398 = 2;
+	int user_398 = 3;
+#line 374 "src/main.v"
+	int ctx_399 = 0;
+	int ctx_399 = 1;
+	int resp_399 = 2;
+	int cfg_399 = 3;
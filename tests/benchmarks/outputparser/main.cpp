@@ -0,0 +1,89 @@
+// Feeds V compiler outputs through VlangOutputParser the way the build step
+// does, line by line, and reports the throughput. Each sample is repeated
+// so that the input grows from a few hundred KB to several MB: the time per
+// line has to stay flat, growing numbers point at quadratic buffering.
+//
+// Usage: vcreator_outputparser_benchmark [data directory] [max repeat]
+
+#include "vcreatoroutputparser.h"
+
+#include <utils/fileutils.h>
+#include <utils/outputformat.h>
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QStringList>
+
+#include <cstdio>
+
+using namespace VCreator::Internal;
+
+struct Run
+{
+    qint64 bytes = 0;
+    int lines = 0;
+    int handled = 0;
+    qint64 nsecs = 0;
+};
+
+static Run parse(const QStringList &lines, int repeat, const QString &dataDirectory)
+{
+    VlangOutputParser parser;
+    Utils::OutputLineParser *lineParser = &parser;
+    lineParser->addSearchDir(Utils::FilePath::fromString(dataDirectory));
+
+    Run run;
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < repeat; ++i) {
+        for (const QString &line : lines) {
+            const Utils::OutputLineParser::Result result
+                    = lineParser->handleLine(line, Utils::StdErrFormat);
+            if (result.status != Utils::OutputLineParser::Status::NotHandled)
+                ++run.handled;
+            run.bytes += line.size();
+            ++run.lines;
+        }
+    }
+    lineParser->flush();
+    run.nsecs = timer.nsecsElapsed();
+    return run;
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    const QStringList arguments = app.arguments();
+    const QString dataDirectory = arguments.value(1, QLatin1String(BENCHMARK_DATA_DIR));
+    const int maxRepeat = arguments.value(2, QLatin1String("100")).toInt();
+
+    const QStringList samples = QDir(dataDirectory).entryList({"*.txt"}, QDir::Files, QDir::Name);
+    if (samples.isEmpty()) {
+        std::fprintf(stderr, "No samples in %s\n", qPrintable(dataDirectory));
+        return 1;
+    }
+
+    std::printf("%-28s %7s %9s %9s %10s %9s\n",
+                "sample", "repeat", "MB", "handled", "ns/line", "MB/s");
+    for (const QString &sample : samples) {
+        QFile file(QDir(dataDirectory).filePath(sample));
+        if (!file.open(QFile::ReadOnly | QFile::Text))
+            continue;
+        // Lines reach the parser with their line feed, as from the build step
+        QStringList lines = QString::fromUtf8(file.readAll()).split(QLatin1Char('\n'),
+                                                                     Qt::SkipEmptyParts);
+        for (QString &line : lines)
+            line.append(QLatin1Char('\n'));
+
+        for (int repeat = 1; repeat <= maxRepeat; repeat *= 10) {
+            const Run run = parse(lines, repeat, dataDirectory);
+            const double megabytes = run.bytes / (1024.0 * 1024.0);
+            std::printf("%-28s %7d %9.2f %9d %10.0f %9.1f\n", qPrintable(sample), repeat,
+                        megabytes, run.handled, double(run.nsecs) / run.lines,
+                        megabytes / (run.nsecs / 1e9));
+        }
+    }
+    return 0;
+}
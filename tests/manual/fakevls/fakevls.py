@@ -0,0 +1,236 @@
+#!/usr/bin/env python3
+"""Scripted stand-in for VLS, speaking LSP on stdin/stdout.
+
+Point the VLS path in Tools > Options > V > Language server at this script
+to exercise the plugin's language client without a V installation:
+
+- announces incremental text sync and applies every didChange range to its
+  copy of the document, reporting a mismatch when a change does not fit
+- answers completion, hover and semantic tokens from the words of the
+  document after a configurable delay
+- honours $/cancelRequest, so coalesced requests show up as cancelled
+
+Round trips are logged by the plugin with
+QT_LOGGING_RULES="qtc.vcreator.vls.debug=true". The script writes what it
+received to stderr, which ends up in the language client's log, and a
+summary of requests, cancellations and sync errors when it exits.
+
+Environment:
+    FAKEVLS_DELAY_MS   delay before answering a request, default 50
+    FAKEVLS_LOG        file to append the message log to instead of stderr
+"""
+
+import json
+import os
+import queue
+import re
+import sys
+import threading
+import time
+from collections import Counter
+
+DELAY = int(os.environ.get("FAKEVLS_DELAY_MS", "50")) / 1000.0
+LOG = open(os.environ["FAKEVLS_LOG"], "a") if os.environ.get("FAKEVLS_LOG") else sys.stderr
+
+TOKEN_TYPES = ["type", "function", "variable", "enumMember"]
+WORD = re.compile(r"[A-Za-z_][A-Za-z0-9_]*")
+KEYWORDS = {
+    "as", "asm", "assert", "atomic", "break", "const", "continue", "defer", "else",
+    "enum", "false", "fn", "for", "go", "goto", "if", "import", "in", "interface",
+    "is", "lock", "match", "module", "mut", "none", "or", "pub", "return", "rlock",
+    "select", "shared", "sizeof", "static", "struct", "true", "type", "union",
+    "unsafe",
+}
+
+documents = {}
+cancelled = set()
+stats = Counter()
+lock = threading.Lock()
+out_lock = threading.Lock()
+
+
+def log(*args):
+    print("fakevls:", *args, file=LOG, flush=True)
+
+
+def read_message(stream):
+    length = None
+    while True:
+        line = stream.readline()
+        if not line:
+            return None
+        line = line.strip()
+        if not line:
+            break
+        name, _, value = line.decode("ascii").partition(":")
+        if name.lower() == "content-length":
+            length = int(value)
+    if length is None:
+        return None
+    return json.loads(stream.read(length).decode("utf-8"))
+
+
+def send(message):
+    message["jsonrpc"] = "2.0"
+    body = json.dumps(message).encode("utf-8")
+    with out_lock:
+        sys.stdout.buffer.write(b"Content-Length: %d\r\n\r\n" % len(body))
+        sys.stdout.buffer.write(body)
+        sys.stdout.buffer.flush()
+
+
+def offset(text, position):
+    # Positions count UTF-16 code units, good enough for ASCII sources
+    lines = text.split("\n")
+    line = position["line"]
+    if line >= len(lines):
+        return len(text)
+    return sum(len(l) + 1 for l in lines[:line]) + min(position["character"], len(lines[line]))
+
+
+def apply_changes(uri, changes):
+    text = documents.get(uri)
+    if text is None:
+        stats["sync errors"] += 1
+        log("didChange for unopened", uri)
+        return
+    for change in changes:
+        if "range" not in change:
+            stats["full syncs"] += 1
+            text = change["text"]
+            continue
+        start = offset(text, change["range"]["start"])
+        end = offset(text, change["range"]["end"])
+        if start > end or ("rangeLength" in change and change["rangeLength"] != end - start):
+            stats["sync errors"] += 1
+            log("range does not fit the document", change["range"])
+        text = text[:start] + change["text"] + text[end:]
+        stats["incremental changes"] += 1
+    documents[uri] = text
+
+
+def word_at(text, position):
+    pos = offset(text, position)
+    for match in WORD.finditer(text):
+        if match.start() <= pos <= match.end():
+            return match.group()
+    return None
+
+
+def completion(params):
+    text = documents.get(params["textDocument"]["uri"], "")
+    words = sorted(set(WORD.findall(text)) - KEYWORDS)
+    return {"isIncomplete": False,
+            "items": [{"label": word, "kind": 6} for word in words]}
+
+
+def hover(params):
+    text = documents.get(params["textDocument"]["uri"], "")
+    word = word_at(text, params["position"])
+    if not word:
+        return None
+    return {"contents": {"kind": "markdown", "value": "`%s` (fakevls)" % word}}
+
+
+def semantic_tokens(params):
+    text = documents.get(params["textDocument"]["uri"], "")
+    data = []
+    previous_line = previous_column = 0
+    for line_number, line in enumerate(text.split("\n")):
+        for match in WORD.finditer(line):
+            word = match.group()
+            if word in KEYWORDS:
+                continue
+            if word[0].isupper():
+                kind = 0
+            elif line[match.end():match.end() + 1] == "(":
+                kind = 1
+            else:
+                continue
+            delta_line = line_number - previous_line
+            delta_column = match.start() - (previous_column if delta_line == 0 else 0)
+            data += [delta_line, delta_column, len(word), kind, 0]
+            previous_line, previous_column = line_number, match.start()
+    return {"data": data}
+
+
+HANDLERS = {
+    "textDocument/completion": completion,
+    "textDocument/hover": hover,
+    "textDocument/semanticTokens/full": semantic_tokens,
+}
+
+
+def worker(requests):
+    while True:
+        message = requests.get()
+        if message is None:
+            return
+        time.sleep(DELAY)
+        with lock:
+            if message["id"] in cancelled:
+                cancelled.discard(message["id"])
+                stats["cancelled"] += 1
+                send({"id": message["id"],
+                      "error": {"code": -32800, "message": "Request cancelled"}})
+                continue
+            result = HANDLERS[message["method"]](message.get("params", {}))
+        send({"id": message["id"], "result": result})
+
+
+def main():
+    requests = queue.Queue()
+    thread = threading.Thread(target=worker, args=(requests,), daemon=True)
+    thread.start()
+
+    while True:
+        message = read_message(sys.stdin.buffer)
+        if message is None:
+            break
+        method = message.get("method")
+        params = message.get("params", {})
+        stats[method] += 1
+        log(method, message.get("id", ""))
+
+        if method == "initialize":
+            send({"id": message["id"], "result": {
+                "capabilities": {
+                    "textDocumentSync": {"openClose": True, "change": 2},
+                    "completionProvider": {"triggerCharacters": ["."]},
+                    "hoverProvider": True,
+                    "semanticTokensProvider": {
+                        "legend": {"tokenTypes": TOKEN_TYPES, "tokenModifiers": []},
+                        "full": True,
+                    },
+                },
+                "serverInfo": {"name": "fakevls"},
+            }})
+        elif method == "shutdown":
+            send({"id": message["id"], "result": None})
+        elif method == "exit":
+            break
+        elif method == "$/cancelRequest":
+            with lock:
+                cancelled.add(params["id"])
+        elif method == "textDocument/didOpen":
+            with lock:
+                documents[params["textDocument"]["uri"]] = params["textDocument"]["text"]
+        elif method == "textDocument/didChange":
+            with lock:
+                apply_changes(params["textDocument"]["uri"], params["contentChanges"])
+        elif method == "textDocument/didClose":
+            with lock:
+                documents.pop(params["textDocument"]["uri"], None)
+        elif method in HANDLERS:
+            requests.put(message)
+        elif "id" in message:
+            send({"id": message["id"],
+                  "error": {"code": -32601, "message": "Method not found"}})
+
+    requests.put(None)
+    thread.join()
+    log("summary", dict(stats))
+
+
+if __name__ == "__main__":
+    main()
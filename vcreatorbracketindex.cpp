@@ -0,0 +1,342 @@
+#include "vcreatorbracketindex.h"
+
+#include <texteditor/textdocumentlayout.h>
+
+#include <QTextBlock>
+#include <QTextDocument>
+
+#include <algorithm>
+#include <functional>
+
+namespace VCreator {
+namespace Internal {
+
+// Minimum of a range without brackets, and the query depth that finds any
+// block with brackets at all.
+static const int NoBracket = 1 << 28;
+static const int AnyBracket = NoBracket - 1;
+
+static bool isOpening(QChar c)
+{
+    return c == QLatin1Char('{') || c == QLatin1Char('(') || c == QLatin1Char('[');
+}
+
+static bool isClosing(QChar c)
+{
+    return c == QLatin1Char('}') || c == QLatin1Char(')') || c == QLatin1Char(']');
+}
+
+static bool isBracket(QChar c)
+{
+    return isOpening(c) || isClosing(c);
+}
+
+BracketIndex::BracketIndex(QTextDocument *document)
+    : QObject(document)
+    , m_document(document)
+{
+    connect(document, &QTextDocument::contentsChange,
+            this, [this](int position, int, int charsAdded) { contentsChanged(position, charsAdded); });
+    if (auto layout = qobject_cast<TextEditor::TextDocumentLayout *>(document->documentLayout())) {
+        connect(layout, &TextEditor::TextDocumentLayout::parenthesesChanged,
+                this, [this](const QTextBlock &block) { m_dirtyBlocks.insert(block.blockNumber()); });
+    }
+}
+
+BracketIndex *BracketIndex::forDocument(QTextDocument *document)
+{
+    if (auto index = document->findChild<BracketIndex *>(QString(), Qt::FindDirectChildrenOnly))
+        return index;
+    return new BracketIndex(document);
+}
+
+int BracketIndex::match(int position)
+{
+    refresh();
+    const QTextBlock block = m_document->findBlock(position);
+    const TextEditor::Parentheses parentheses = TextEditor::TextDocumentLayout::parentheses(block);
+    for (const TextEditor::Parenthesis &parenthesis : parentheses) {
+        if (block.position() + parenthesis.pos != position)
+            continue;
+        if (isOpening(parenthesis.chr))
+            return findClosing(position + 1, depthAt(position));
+        if (isClosing(parenthesis.chr))
+            return findOpening(position, depthAt(position) - 1);
+    }
+    return -1;
+}
+
+QPair<int, int> BracketIndex::enclosing(int position)
+{
+    refresh();
+    const int depth = depthAt(position);
+    if (depth <= 0)
+        return {-1, -1};
+    return {findOpening(position, depth - 1), findClosing(position, depth - 1)};
+}
+
+void BracketIndex::contentsChanged(int position, int charsAdded)
+{
+    if (m_rebuild)
+        return;
+
+    // Blocks in front of the edit keep their numbers, the edited ones are
+    // summarized on the next refresh and the ones behind move by delta
+    const int blockCount = m_document->blockCount();
+    const int delta = blockCount - m_blockCount;
+    const int first = m_document->findBlock(position).blockNumber();
+    const int behind = m_document->findBlock(qMin(position + charsAdded,
+                                                  m_document->characterCount() - 1)).blockNumber() + 1;
+    for (int blockNumber = first; blockNumber < behind; ++blockNumber)
+        m_dirtyBlocks.insert(blockNumber);
+    if (delta == 0)
+        return;
+
+    // The highlighter may have reported blocks before or after the move,
+    // refreshing a block too many is harmless
+    const QSet<int> dirtyBlocks = m_dirtyBlocks;
+    for (const int blockNumber : dirtyBlocks) {
+        if (blockNumber >= behind - delta)
+            m_dirtyBlocks.insert(blockNumber + delta);
+    }
+
+    int size = m_size;
+    while (size < blockCount)
+        size *= 2;
+    const bool grown = size != m_size;
+    if (grown) {
+        QVector<Node> tree(2 * size, Node{0, NoBracket});
+        std::copy(m_tree.cbegin() + m_size, m_tree.cbegin() + m_size + m_blockCount,
+                  tree.begin() + size);
+        m_tree = tree;
+        m_size = size;
+    }
+
+    Node *leaves = m_tree.data() + m_size;
+    if (delta > 0)
+        std::copy_backward(leaves + behind - delta, leaves + m_blockCount, leaves + blockCount);
+    else
+        std::copy(leaves + behind - delta, leaves + m_blockCount, leaves + behind);
+    std::fill(leaves + first, leaves + behind, Node{0, NoBracket});
+    std::fill(leaves + blockCount, leaves + qMax(blockCount, m_blockCount), Node{0, NoBracket});
+
+    // Recombine the ancestors of the moved leaves level by level, all of
+    // them when the tree has grown
+    int lo = m_size + (grown ? 0 : first);
+    int hi = m_size + (grown ? m_size : qMax(blockCount, m_blockCount)) - 1;
+    for (lo /= 2, hi /= 2; lo > 0; lo /= 2, hi /= 2) {
+        for (int node = lo; node <= hi; ++node)
+            m_tree[node] = combine(m_tree.at(2 * node), m_tree.at(2 * node + 1));
+    }
+    m_blockCount = blockCount;
+}
+
+void BracketIndex::refresh()
+{
+    if (m_rebuild) {
+        rebuild();
+        return;
+    }
+    for (const int blockNumber : qAsConst(m_dirtyBlocks)) {
+        if (blockNumber >= 0 && blockNumber < m_blockCount)
+            updateBlock(blockNumber);
+    }
+    m_dirtyBlocks.clear();
+}
+
+void BracketIndex::rebuild()
+{
+    m_size = 1;
+    while (m_size < m_document->blockCount())
+        m_size *= 2;
+    m_tree.fill(Node{0, NoBracket}, 2 * m_size);
+
+    int leaf = m_size;
+    for (QTextBlock block = m_document->firstBlock(); block.isValid(); block = block.next())
+        m_tree[leaf++] = summarize(block);
+    for (int node = m_size - 1; node > 0; --node)
+        m_tree[node] = combine(m_tree.at(2 * node), m_tree.at(2 * node + 1));
+
+    m_blockCount = m_document->blockCount();
+    m_rebuild = false;
+    m_dirtyBlocks.clear();
+}
+
+void BracketIndex::updateBlock(int blockNumber)
+{
+    int node = m_size + blockNumber;
+    m_tree[node] = summarize(m_document->findBlockByNumber(blockNumber));
+    for (node /= 2; node > 0; node /= 2)
+        m_tree[node] = combine(m_tree.at(2 * node), m_tree.at(2 * node + 1));
+}
+
+BracketIndex::Node BracketIndex::summarize(const QTextBlock &block)
+{
+    Node node{0, NoBracket};
+    const TextEditor::Parentheses parentheses = TextEditor::TextDocumentLayout::parentheses(block);
+    for (const TextEditor::Parenthesis &parenthesis : parentheses) {
+        if (!isBracket(parenthesis.chr))
+            continue;
+        node.delta += isOpening(parenthesis.chr) ? 1 : -1;
+        node.minimum = qMin(node.minimum, node.delta);
+    }
+    return node;
+}
+
+BracketIndex::Node BracketIndex::combine(const Node &left, const Node &right)
+{
+    return {left.delta + right.delta, qMin(left.minimum, left.delta + right.minimum)};
+}
+
+int BracketIndex::depthBefore(int blockNumber) const
+{
+    // Sum of the deltas of leaves [0, blockNumber)
+    int depth = 0;
+    for (int lo = m_size, hi = m_size + blockNumber; lo < hi; lo /= 2, hi /= 2) {
+        if (lo & 1)
+            depth += m_tree.at(lo++).delta;
+        if (hi & 1)
+            depth += m_tree.at(--hi).delta;
+    }
+    return depth;
+}
+
+// Depth in front of the character at position
+int BracketIndex::depthAt(int position)
+{
+    const QTextBlock block = m_document->findBlock(position);
+    int depth = depthBefore(block.blockNumber());
+    const TextEditor::Parentheses parentheses = TextEditor::TextDocumentLayout::parentheses(block);
+    for (const TextEditor::Parenthesis &parenthesis : parentheses) {
+        if (block.position() + parenthesis.pos >= position)
+            break;
+        if (isBracket(parenthesis.chr))
+            depth += isOpening(parenthesis.chr) ? 1 : -1;
+    }
+    return depth;
+}
+
+// First bracket at or after from that leaves the depth at or below depth
+int BracketIndex::findClosing(int from, int depth)
+{
+    QTextBlock block = m_document->findBlock(from);
+    for (int pass = 0; pass < 2 && block.isValid(); ++pass) {
+        int running = depthBefore(block.blockNumber());
+        const TextEditor::Parentheses parentheses = TextEditor::TextDocumentLayout::parentheses(block);
+        for (const TextEditor::Parenthesis &parenthesis : parentheses) {
+            if (!isBracket(parenthesis.chr))
+                continue;
+            running += isOpening(parenthesis.chr) ? 1 : -1;
+            if (block.position() + parenthesis.pos >= from && running <= depth)
+                return block.position() + parenthesis.pos;
+        }
+        const int next = firstBlockReaching(block.blockNumber() + 1, depth);
+        if (next < 0)
+            return -1;
+        block = m_document->findBlockByNumber(next);
+    }
+    return -1;
+}
+
+// Opening bracket of the pair ending in front of before, where depth is the
+// depth after that pair: the bracket following the last point in front of
+// before at or below depth.
+int BracketIndex::findOpening(int before, int depth)
+{
+    const QTextBlock block = m_document->findBlock(before);
+
+    const auto lastPointIn = [&](const QTextBlock &b, int end, int *following) {
+        int running = depthBefore(b.blockNumber());
+        bool found = running <= depth;
+        *following = -1;
+        const TextEditor::Parentheses parentheses = TextEditor::TextDocumentLayout::parentheses(b);
+        for (const TextEditor::Parenthesis &parenthesis : parentheses) {
+            const int position = b.position() + parenthesis.pos;
+            if (!isBracket(parenthesis.chr) || position >= end)
+                continue;
+            if (found && *following < 0)
+                *following = position;
+            running += isOpening(parenthesis.chr) ? 1 : -1;
+            if (running <= depth) {
+                found = true;
+                *following = -1;
+            }
+        }
+        return found;
+    };
+
+    int following = -1;
+    if (lastPointIn(block, before, &following))
+        return following;
+
+    int blockNumber = lastBlockReaching(block.blockNumber(), depth);
+    if (blockNumber < 0) {
+        if (depth < 0)
+            return -1;
+        // The document start is the last point, take the first bracket
+        blockNumber = firstBlockReaching(0, AnyBracket);
+    } else {
+        // Only brackets before the last point of that block can be found
+        if (lastPointIn(m_document->findBlockByNumber(blockNumber), before, &following)
+                && following >= 0) {
+            return following;
+        }
+        blockNumber = firstBlockReaching(blockNumber + 1, AnyBracket);
+    }
+    if (blockNumber < 0)
+        return -1;
+
+    const QTextBlock openingBlock = m_document->findBlockByNumber(blockNumber);
+    const TextEditor::Parentheses parentheses = TextEditor::TextDocumentLayout::parentheses(openingBlock);
+    for (const TextEditor::Parenthesis &parenthesis : parentheses) {
+        const int position = openingBlock.position() + parenthesis.pos;
+        if (isBracket(parenthesis.chr))
+            return position < before ? position : -1;
+    }
+    return -1;
+}
+
+int BracketIndex::firstBlockReaching(int fromBlock, int depth) const
+{
+    // Descends into the leftmost subtree whose minimum reaches depth,
+    // base being the absolute depth at the start of the node's range.
+    std::function<int(int, int, int, int)> find = [&](int node, int lo, int hi, int base) {
+        if (hi <= fromBlock)
+            return -1;
+        const Node &n = m_tree.at(node);
+        if (lo >= fromBlock && base + n.minimum > depth)
+            return -1;
+        if (hi - lo == 1)
+            return base + n.minimum <= depth ? lo : -1;
+        const int mid = (lo + hi) / 2;
+        const int result = find(2 * node, lo, mid, base);
+        if (result >= 0)
+            return result;
+        return find(2 * node + 1, mid, hi, base + m_tree.at(2 * node).delta);
+    };
+    const int result = find(1, 0, m_size, 0);
+    return result < m_document->blockCount() ? result : -1;
+}
+
+int BracketIndex::lastBlockReaching(int toBlock, int depth) const
+{
+    // Like firstBlockReaching() from the right, over the blocks before toBlock
+    std::function<int(int, int, int, int)> find = [&](int node, int lo, int hi, int base) {
+        if (lo >= toBlock)
+            return -1;
+        const Node &n = m_tree.at(node);
+        if (hi <= toBlock && base + n.minimum > depth)
+            return -1;
+        if (hi - lo == 1)
+            return base + n.minimum <= depth ? lo : -1;
+        const int mid = (lo + hi) / 2;
+        const int result = find(2 * node + 1, mid, hi, base + m_tree.at(2 * node).delta);
+        if (result >= 0)
+            return result;
+        return find(2 * node, lo, mid, base);
+    };
+    return find(1, 0, m_size, 0);
+}
+
+} // namespace Internal
+} // namespace Vcreator
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <QObject>
+#include <QPair>
+#include <QSet>
+#include <QVector>
+
+QT_BEGIN_NAMESPACE
+class QTextBlock;
+class QTextDocument;
+QT_END_NAMESPACE
+
+namespace VCreator {
+namespace Internal {
+
+// Bracket pairing for a whole document, built on the parentheses the
+// highlighter stores per block. Every block contributes its net bracket
+// depth change and the lowest depth it reaches relative to its start; a
+// segment tree over those answers "next or previous block dropping below
+// depth d" in O(log n). Blocks are refreshed when the highlighter changes
+// their parentheses. Added or removed lines move the leaves behind them and
+// recombine their ancestors, only the edited blocks are summarized again.
+class BracketIndex : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit BracketIndex(QTextDocument *document);
+
+    // Shared by all editors of document
+    static BracketIndex *forDocument(QTextDocument *document);
+
+    // Position of the bracket matching the one at position, or -1.
+    int match(int position);
+
+    // Positions of the innermost bracket pair around position. Either is -1
+    // when unbalanced.
+    QPair<int, int> enclosing(int position);
+
+private:
+    struct Node
+    {
+        int delta = 0;        // depth change over the range
+        int minimum = 0;      // lowest depth after a bracket, relative to the start
+    };
+
+    void contentsChanged(int position, int charsAdded);
+    void refresh();
+    void rebuild();
+    void updateBlock(int blockNumber);
+    static Node summarize(const QTextBlock &block);
+    static Node combine(const Node &left, const Node &right);
+
+    int depthBefore(int blockNumber) const;
+    int depthAt(int position);
+    int findClosing(int position, int depth);
+    int findOpening(int position, int depth);
+    int firstBlockReaching(int fromBlock, int depth) const;
+    int lastBlockReaching(int toBlock, int depth) const;
+
+    QTextDocument *m_document;
+    QVector<Node> m_tree; // leaves start at m_size
+    int m_size = 0;
+    int m_blockCount = 0; // blocks the leaves describe
+    bool m_rebuild = true;
+    QSet<int> m_dirtyBlocks;
+};
+
+} // namespace Internal
+} // namespace Vcreator
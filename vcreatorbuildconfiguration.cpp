@@ -0,0 +1,79 @@
+#include "vcreatorbuildconfiguration.h"
+#include "vcreatorbuildstep.h"
+#include "vcreatorconstants.h"
+
+#include <projectexplorer/buildinfo.h>
+#include <projectexplorer/buildsteplist.h>
+#include <projectexplorer/project.h>
+#include <projectexplorer/target.h>
+
+#include <utils/hostosinfo.h>
+
+using namespace ProjectExplorer;
+
+namespace VCreator {
+namespace Internal {
+
+static const char buildTypeKey[] = "Vcreator.BuildConfiguration.BuildType";
+
+VlangBuildConfiguration::VlangBuildConfiguration(Target *target, Utils::Id id)
+    : BuildConfiguration(target, id)
+{
+    setInitializer([this](const BuildInfo &info) {
+        m_buildType = info.buildType;
+        buildSteps()->appendStep(Constants::C_VLANG_BUILDSTEP_ID);
+        cleanSteps()->appendStep(Constants::C_VLANG_CLEANSTEP_ID);
+        if (auto step = buildSteps()->firstOfType<VlangBuildStep>())
+            step->setProduction(info.buildType == Release);
+    });
+}
+
+Utils::FilePath VlangBuildConfiguration::executable() const
+{
+    QString name = project()->displayName();
+    if (name.isEmpty())
+        name = project()->projectDirectory().fileName();
+    return buildDirectory().pathAppended(Utils::HostOsInfo::withExecutableSuffix(name));
+}
+
+bool VlangBuildConfiguration::fromMap(const QVariantMap &map)
+{
+    m_buildType = BuildType(map.value(buildTypeKey, Unknown).toInt());
+    return BuildConfiguration::fromMap(map);
+}
+
+QVariantMap VlangBuildConfiguration::toMap() const
+{
+    QVariantMap map = BuildConfiguration::toMap();
+    map.insert(buildTypeKey, int(m_buildType));
+    return map;
+}
+
+VlangBuildConfigurationFactory::VlangBuildConfigurationFactory()
+{
+    registerBuildConfiguration<VlangBuildConfiguration>(Constants::C_VLANG_BUILDCONFIGURATION_ID);
+    setSupportedProjectType(Constants::C_VLANG_PROJECT_ID);
+    setSupportedProjectMimeTypeName(Constants::C_VLANG_PROJECT_MIMETYPE);
+
+    setBuildGenerator([](const Kit *k, const Utils::FilePath &projectPath, bool forSetUp) {
+        Q_UNUSED(forSetUp)
+        QList<BuildInfo> result;
+        const Utils::FilePath projectDir = projectPath.parentDir();
+        for (const BuildConfiguration::BuildType type : {BuildConfiguration::Debug,
+                                                         BuildConfiguration::Release}) {
+            BuildInfo info;
+            info.buildType = type;
+            info.typeName = type == BuildConfiguration::Debug
+                    ? VlangBuildConfiguration::tr("Debug")
+                    : VlangBuildConfiguration::tr("Release");
+            info.displayName = info.typeName;
+            info.buildDirectory = BuildConfiguration::buildDirectoryFromTemplate(
+                        projectDir, projectPath, projectDir.fileName(), k, info.typeName, type);
+            result << info;
+        }
+        return result;
+    });
+}
+
+} // namespace Internal
+} // namespace Vcreator
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <projectexplorer/buildconfiguration.h>
+
+namespace VCreator {
+namespace Internal {
+
+class VlangBuildConfiguration : public ProjectExplorer::BuildConfiguration
+{
+    Q_OBJECT
+
+public:
+    VlangBuildConfiguration(ProjectExplorer::Target *target, Utils::Id id);
+
+    BuildType buildType() const override { return m_buildType; }
+
+    // Binary produced by the build step, named after the v.mod module.
+    Utils::FilePath executable() const;
+
+private:
+    bool fromMap(const QVariantMap &map) override;
+    QVariantMap toMap() const override;
+
+    BuildType m_buildType = Unknown;
+};
+
+class VlangBuildConfigurationFactory : public ProjectExplorer::BuildConfigurationFactory
+{
+public:
+    VlangBuildConfigurationFactory();
+};
+
+} // namespace Internal
+} // namespace Vcreator
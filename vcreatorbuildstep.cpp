@@ -0,0 +1,430 @@
+#include "vcreatorbuildstep.h"
+#include "vcreatorbuildconfiguration.h"
+#include "vcreatorconstants.h"
+#include "vcreatorindexer.h"
+#include "vcreatoroutputparser.h"
+#include "vcreatorsettings.h"
+#include "vcreatorsources.h"
+#include "vcreatorsymbolindex.h"
+#include "vcreatortoolchain.h"
+
+#include <projectexplorer/processparameters.h>
+#include <projectexplorer/project.h>
+#include <projectexplorer/projectexplorerconstants.h>
+
+#include <utils/algorithm.h>
+#include <utils/aspects.h>
+#include <utils/outputformatter.h>
+#include <utils/qtcprocess.h>
+#include <utils/runextensions.h>
+
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QFormLayout>
+#include <QLabel>
+#include <QRegularExpression>
+#include <QSet>
+
+using namespace ProjectExplorer;
+
+namespace VCreator {
+namespace Internal {
+
+enum BuildMode { DebugMode, ProductionMode };
+
+struct Dependencies
+{
+    QStringList files;
+    bool complete = true;
+};
+
+// Path of a #flag or #include argument, empty when a placeholder cannot be
+// expanded.
+static QString expandCPath(QString path, const QString &directory, const QString &compilerDirectory)
+{
+    if (path.contains(QLatin1String("@VMODROOT")) || path.contains(QLatin1String("@VROOT"))) {
+        const QString root = findProjectRoot(directory);
+        if (root.isEmpty())
+            return QString();
+        path.replace(QLatin1String("@VMODROOT"), root).replace(QLatin1String("@VROOT"), root);
+    }
+    path.replace(QLatin1String("@VEXEROOT"), compilerDirectory);
+    return QDir::cleanPath(QDir(directory).absoluteFilePath(path));
+}
+
+// C sources, objects and headers filePath pulls in with #flag and quoted
+// #include directives. System headers and libraries are not followed.
+static void addCReferences(const QString &filePath, const QString &text,
+                           const QString &compilerDirectory, Dependencies *dependencies)
+{
+    static const QRegularExpression directive(QLatin1String(R"(^\s*#(flag|include)\s+(.*)$)"),
+                                              QRegularExpression::MultilineOption);
+    static const QRegularExpression whitespace(QLatin1String(R"(\s+)"));
+    static const QStringList suffixes = {"c", "h", "m", "o", "a", "cpp", "cc", "hpp"};
+
+    const QString directory = QFileInfo(filePath).absolutePath();
+    const auto addFile = [dependencies](const QString &file) {
+        if (file.isEmpty() || !QFileInfo(file).isFile())
+            dependencies->complete = false;
+        else
+            dependencies->files.append(file);
+    };
+
+    QStringList includeDirectories{directory};
+    QStringList headers;
+    QRegularExpressionMatchIterator it = directive.globalMatch(text);
+    while (it.hasNext()) {
+        const QRegularExpressionMatch match = it.next();
+        const QString arguments = match.captured(2).trimmed();
+        if (match.captured(1) == QLatin1String("include")) {
+            if (arguments.startsWith(QLatin1Char('"')))
+                headers.append(arguments.mid(1, arguments.indexOf(QLatin1Char('"'), 1) - 1));
+            continue;
+        }
+
+        const QStringList words = arguments.split(whitespace, Qt::SkipEmptyParts);
+        for (int i = 0; i < words.size(); ++i) {
+            const QString &word = words.at(i);
+            if (word == QLatin1String("-I") && i + 1 < words.size()) {
+                includeDirectories.append(expandCPath(words.at(++i), directory, compilerDirectory));
+            } else if (word.startsWith(QLatin1String("-I"))) {
+                includeDirectories.append(expandCPath(word.mid(2), directory, compilerDirectory));
+            } else if (!word.startsWith(QLatin1Char('-'))
+                       && suffixes.contains(QFileInfo(word).suffix())) {
+                QString file = expandCPath(word, directory, compilerDirectory);
+                // V compiles foo.o from the foo.c next to it
+                if (file.endsWith(QLatin1String(".o"))) {
+                    const QString source = file.left(file.size() - 1) + QLatin1Char('c');
+                    if (QFileInfo(source).isFile())
+                        file = source;
+                }
+                addFile(file);
+            }
+        }
+    }
+
+    for (const QString &header : qAsConst(headers)) {
+        QString found;
+        if (header.contains(QLatin1Char('@')) || QDir::isAbsolutePath(header)) {
+            found = expandCPath(header, directory, compilerDirectory);
+        } else {
+            for (const QString &includeDirectory : qAsConst(includeDirectories)) {
+                const QString candidate = includeDirectory + QLatin1Char('/') + header;
+                if (!includeDirectory.isEmpty() && QFileInfo(candidate).isFile()) {
+                    found = QDir::cleanPath(candidate);
+                    break;
+                }
+            }
+        }
+        addFile(found);
+    }
+}
+
+// Files outside sources the build depends on: the V files of all modules
+// imported directly or indirectly, builtin included, and the C files they
+// reference. Incomplete when an import or C file cannot be found.
+static Dependencies collectDependencies(const QStringList &sources, const QString &compilerDirectory)
+{
+    Dependencies dependencies;
+    QSet<QString> scanned;
+    QSet<QString> modules;
+    QStringList pendingFiles = sources;
+    QStringList pendingModules;
+    const QString vlib = ToolchainManager::instance()->vlibDirectory();
+    if (!vlib.isEmpty())
+        pendingModules.append(vlib + QLatin1String("/builtin"));
+
+    while (!pendingFiles.isEmpty() || !pendingModules.isEmpty()) {
+        if (pendingFiles.isEmpty()) {
+            const QString module = pendingModules.takeLast();
+            if (modules.contains(module))
+                continue;
+            modules.insert(module);
+            const QStringList files = vlangModuleFiles(module);
+            dependencies.files.append(files);
+            pendingFiles.append(files);
+            continue;
+        }
+
+        const QString file = pendingFiles.takeLast();
+        if (scanned.contains(file))
+            continue;
+        scanned.insert(file);
+
+        const QString text = readSourceFile(file);
+        const FileIndexPtr index = indexFile(file, SourceTokens(text));
+        for (const Import &import : index->imports) {
+            const QString module = SymbolIndex::instance()->resolveImport(file, import.path);
+            if (module.isEmpty())
+                dependencies.complete = false;
+            else
+                pendingModules.append(module);
+        }
+        addCReferences(file, text, compilerDirectory, &dependencies);
+    }
+    return dependencies;
+}
+
+VlangBuildStep::VlangBuildStep(BuildStepList *bsl, Utils::Id id)
+    : AbstractProcessStep(bsl, id)
+{
+    m_mode = addAspect<Utils::SelectionAspect>();
+    m_mode->setSettingsKey("Vcreator.BuildStep.Mode");
+    m_mode->setDisplayStyle(Utils::SelectionAspect::DisplayStyle::ComboBox);
+    m_mode->setLabelText(tr("Mode:"));
+    m_mode->addOption(tr("Debug (-g)"));
+    m_mode->addOption(tr("Production (-prod)"));
+
+    m_cCompiler = addAspect<Utils::StringAspect>();
+    m_cCompiler->setSettingsKey("Vcreator.BuildStep.CCompiler");
+    m_cCompiler->setDisplayStyle(Utils::StringAspect::LineEditDisplay);
+    m_cCompiler->setLabelText(tr("C compiler (-cc):"));
+    m_cCompiler->setPlaceHolderText(tr("Default"));
+
+    m_arguments = addAspect<Utils::StringAspect>();
+    m_arguments->setSettingsKey("Vcreator.BuildStep.Arguments");
+    m_arguments->setDisplayStyle(Utils::StringAspect::LineEditDisplay);
+    m_arguments->setLabelText(tr("Additional arguments:"));
+
+    m_showTimings = addAspect<Utils::BoolAspect>();
+    m_showTimings->setSettingsKey("Vcreator.BuildStep.ShowTimings");
+    m_showTimings->setLabel(tr("Record phase timings (-show-timings)"),
+                            Utils::BoolAspect::LabelPlacement::AtCheckBox);
+
+    m_regressionThreshold = addAspect<Utils::IntegerAspect>();
+    m_regressionThreshold->setSettingsKey("Vcreator.BuildStep.RegressionThreshold");
+    m_regressionThreshold->setLabelText(tr("Flag builds slower by:"));
+    m_regressionThreshold->setRange(1, 1000);
+    m_regressionThreshold->setDefaultValue(20);
+    m_regressionThreshold->setSuffix("%");
+
+    setCommandLineProvider([this] { return commandLine(); });
+    setWorkingDirectoryProvider([this] { return project()->projectDirectory(); });
+    setSummaryUpdater([this] {
+        ProcessParameters params;
+        setupProcessParameters(&params);
+        return params.summary(displayName());
+    });
+
+    connect(&m_hashWatcher, &QFutureWatcher<QByteArray>::finished,
+            this, &VlangBuildStep::hashingFinished);
+}
+
+void VlangBuildStep::setProduction(bool production)
+{
+    m_mode->setValue(production ? ProductionMode : DebugMode);
+}
+
+Utils::FilePath VlangBuildStep::stampFilePath(const Utils::FilePath &executable)
+{
+    return executable.stringAppended(".vcreator-stamp");
+}
+
+bool VlangBuildStep::init()
+{
+    if (!QFileInfo(VlangSettings::compilerPath().toString()).isExecutable()) {
+        emit addTask(BuildSystemTask(Task::Error,
+                                     tr("The V compiler was not found. Set its path in "
+                                        "Tools > Options > V > Tools.")));
+        emitFaultyConfigurationMessage();
+        return false;
+    }
+    return AbstractProcessStep::init();
+}
+
+void VlangBuildStep::doRun()
+{
+    m_phases.clear();
+
+    // A different compiler binary gives a different result for the same sources.
+    const QFileInfo compiler(VlangSettings::compilerPath().toString());
+    const QByteArray salt = commandLine().toUserOutput().toUtf8()
+            + QByteArray::number(compiler.lastModified().toMSecsSinceEpoch());
+
+    QStringList files = Utils::transform(project()->files(Project::SourceFiles),
+                                         &Utils::FilePath::toString);
+    files = Utils::filtered(files, [](const QString &filePath) {
+        return isVlangSourceFile(filePath) && !isVlangTestFile(filePath);
+    });
+    const QString projectFile = project()->projectFilePath().toString();
+    const QString compilerDirectory = compiler.absolutePath();
+
+    m_hashWatcher.setFuture(Utils::runAsync([files, projectFile, salt, compilerDirectory] {
+        const Dependencies dependencies = collectDependencies(files, compilerDirectory);
+        if (!dependencies.complete)
+            return QByteArray();
+        return contentHash(files + dependencies.files + QStringList(projectFile), salt);
+    }));
+}
+
+void VlangBuildStep::doCancel()
+{
+    if (m_hashWatcher.isRunning()) {
+        m_hashWatcher.cancel();
+        emit finished(false);
+        return;
+    }
+    AbstractProcessStep::doCancel();
+}
+
+void VlangBuildStep::hashingFinished()
+{
+    if (m_hashWatcher.isCanceled())
+        return;
+
+    m_sourceHash = m_hashWatcher.result().toHex();
+    const Utils::FilePath binary = executable();
+    QFile stamp(stampFilePath(binary).toString());
+    if (m_sourceHash.isEmpty()) {
+        emit addOutput(tr("Not all imported modules and C files were found, running the V compiler."),
+                       OutputFormat::NormalMessage);
+    } else if (binary.exists() && stamp.open(QFile::ReadOnly) && stamp.readAll() == m_sourceHash) {
+        emit addOutput(tr("Sources and compiler options are unchanged, skipping the V compiler."),
+                       OutputFormat::NormalMessage);
+        emit finished(true);
+        return;
+    }
+    // The stamp is written next to the binary, neither may exist yet
+    QDir().mkpath(binary.parentDir().toString());
+    AbstractProcessStep::doRun();
+}
+
+void VlangBuildStep::finish(bool success)
+{
+    QFile stamp(stampFilePath(executable()).toString());
+    if (success && !m_sourceHash.isEmpty() && stamp.open(QFile::WriteOnly | QFile::Truncate))
+        stamp.write(m_sourceHash);
+    else
+        stamp.remove();
+    if (success && m_showTimings->value())
+        recordTimings();
+    AbstractProcessStep::finish(success);
+}
+
+void VlangBuildStep::recordTimings()
+{
+    if (m_phases.isEmpty()) {
+        emit addOutput(tr("The V compiler did not report any phase timings."),
+                       OutputFormat::ErrorMessage);
+        return;
+    }
+
+    BuildTiming timing;
+    timing.timestamp = QDateTime::currentDateTime();
+    timing.phases = m_phases;
+    const QStringList regressed = addBuildTiming(project(), timing,
+                                                 int(m_regressionThreshold->value()));
+    emit timingsRecorded();
+
+    QStringList breakdown;
+    const double total = timing.totalMs();
+    for (const BuildPhase &phase : qAsConst(m_phases)) {
+        breakdown.append(tr("%1: %2 ms (%3%)").arg(phase.name)
+                         .arg(phase.ms, 0, 'f', 1)
+                         .arg(total > 0 ? phase.ms / total * 100 : 0, 0, 'f', 0));
+    }
+    emit addOutput(tr("Build phases: %1, total %2 ms").arg(breakdown.join(", "))
+                   .arg(total, 0, 'f', 1), OutputFormat::NormalMessage);
+
+    if (timing.regression) {
+        QString message = tr("Compile time regressed by more than %1% to %2 ms.")
+                .arg(m_regressionThreshold->value()).arg(total, 0, 'f', 1);
+        if (!regressed.isEmpty())
+            message += QLatin1Char(' ') + tr("Slower phases: %1").arg(regressed.join(", "));
+        emit addTask(BuildSystemTask(Task::Warning, message));
+    }
+}
+
+QWidget *VlangBuildStep::createConfigWidget()
+{
+    QWidget *widget = AbstractProcessStep::createConfigWidget();
+    auto layout = qobject_cast<QFormLayout *>(widget->layout());
+    if (!layout)
+        return widget;
+
+    auto label = new QLabel(tr("Timing history:"));
+    auto chart = new BuildTimingsChart(project());
+    layout->addRow(label, chart);
+    const auto updateVisibility = [this, label, chart] {
+        label->setVisible(m_showTimings->value());
+        chart->setVisible(m_showTimings->value());
+        m_regressionThreshold->setEnabled(m_showTimings->value());
+    };
+    updateVisibility();
+    connect(m_showTimings, &Utils::BoolAspect::valueChanged, widget, updateVisibility);
+    connect(this, &VlangBuildStep::timingsRecorded, chart, &BuildTimingsChart::updateTimings);
+    return widget;
+}
+
+void VlangBuildStep::setupOutputFormatter(Utils::OutputFormatter *formatter)
+{
+    formatter->addLineParser(new VlangOutputParser);
+    if (m_showTimings->value()) {
+        formatter->addLineParser(new BuildTimingsParser([this](const BuildPhase &phase) {
+            m_phases.append(phase);
+        }));
+    }
+    formatter->addSearchDir(project()->projectDirectory());
+    AbstractProcessStep::setupOutputFormatter(formatter);
+}
+
+Utils::CommandLine VlangBuildStep::commandLine() const
+{
+    Utils::CommandLine cmd(VlangSettings::compilerPath());
+    cmd.addArg(m_mode->value() == ProductionMode ? "-prod" : "-g");
+    if (m_showTimings->value())
+        cmd.addArg("-show-timings");
+    if (!m_cCompiler->value().isEmpty())
+        cmd.addArgs({"-cc", m_cCompiler->value()});
+    cmd.addArgs(m_arguments->value(), Utils::CommandLine::Raw);
+    cmd.addArgs({"-o", executable().toString(), project()->projectDirectory().toString()});
+    return cmd;
+}
+
+Utils::FilePath VlangBuildStep::executable() const
+{
+    auto bc = qobject_cast<VlangBuildConfiguration *>(buildConfiguration());
+    return bc ? bc->executable() : Utils::FilePath();
+}
+
+VlangCleanStep::VlangCleanStep(BuildStepList *bsl, Utils::Id id)
+    : BuildStep(bsl, id)
+{
+}
+
+bool VlangCleanStep::init()
+{
+    return qobject_cast<VlangBuildConfiguration *>(buildConfiguration()) != nullptr;
+}
+
+void VlangCleanStep::doRun()
+{
+    const Utils::FilePath binary
+            = static_cast<VlangBuildConfiguration *>(buildConfiguration())->executable();
+    QFile::remove(VlangBuildStep::stampFilePath(binary).toString());
+    QFile::remove(binary.toString());
+    emit addOutput(tr("Removed %1").arg(binary.toUserOutput()), OutputFormat::NormalMessage);
+    emit finished(true);
+}
+
+VlangBuildStepFactory::VlangBuildStepFactory()
+{
+    registerStep<VlangBuildStep>(Constants::C_VLANG_BUILDSTEP_ID);
+    setSupportedProjectType(Constants::C_VLANG_PROJECT_ID);
+    setSupportedStepList(ProjectExplorer::Constants::BUILDSTEPS_BUILD);
+    setDisplayName(VlangBuildStep::tr("V Build"));
+}
+
+VlangCleanStepFactory::VlangCleanStepFactory()
+{
+    registerStep<VlangCleanStep>(Constants::C_VLANG_CLEANSTEP_ID);
+    setSupportedProjectType(Constants::C_VLANG_PROJECT_ID);
+    setSupportedStepList(ProjectExplorer::Constants::BUILDSTEPS_CLEAN);
+    setDisplayName(VlangCleanStep::tr("V Clean"));
+    setFlags(BuildStepInfo::Unclonable);
+}
+
+} // namespace Internal
+} // namespace Vcreator
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "vcreatorbuildtimings.h"
+
+#include <projectexplorer/abstractprocessstep.h>
+
+#include <QFutureWatcher>
+
+namespace Utils {
+class BoolAspect;
+class IntegerAspect;
+class SelectionAspect;
+class StringAspect;
+} // namespace Utils
+
+namespace VCreator {
+namespace Internal {
+
+// Runs the V compiler on the project directory. A hash of all sources, the
+// imported modules, the C files they reference and the command line is
+// stored next to the binary, the compiler is not started again while it is
+// unchanged. With timings enabled the phase breakdown of each compiler run
+// is added to the project's timing history.
+class VlangBuildStep : public ProjectExplorer::AbstractProcessStep
+{
+    Q_OBJECT
+
+public:
+    VlangBuildStep(ProjectExplorer::BuildStepList *bsl, Utils::Id id);
+
+    void setProduction(bool production);
+
+    static Utils::FilePath stampFilePath(const Utils::FilePath &executable);
+
+signals:
+    void timingsRecorded();
+
+private:
+    QWidget *createConfigWidget() override;
+    bool init() override;
+    void doRun() override;
+    void doCancel() override;
+    void finish(bool success) override;
+    void setupOutputFormatter(Utils::OutputFormatter *formatter) override;
+
+    void hashingFinished();
+    void recordTimings();
+    Utils::CommandLine commandLine() const;
+    Utils::FilePath executable() const;
+
+    Utils::SelectionAspect *m_mode = nullptr;
+    Utils::StringAspect *m_cCompiler = nullptr;
+    Utils::StringAspect *m_arguments = nullptr;
+    Utils::BoolAspect *m_showTimings = nullptr;
+    Utils::IntegerAspect *m_regressionThreshold = nullptr;
+    QFutureWatcher<QByteArray> m_hashWatcher;
+    QByteArray m_sourceHash;
+    QVector<BuildPhase> m_phases;
+};
+
+// Removes the binary and its build stamp, so the next build runs the compiler.
+class VlangCleanStep : public ProjectExplorer::BuildStep
+{
+    Q_OBJECT
+
+public:
+    VlangCleanStep(ProjectExplorer::BuildStepList *bsl, Utils::Id id);
+
+private:
+    bool init() override;
+    void doRun() override;
+};
+
+class VlangBuildStepFactory : public ProjectExplorer::BuildStepFactory
+{
+public:
+    VlangBuildStepFactory();
+};
+
+class VlangCleanStepFactory : public ProjectExplorer::BuildStepFactory
+{
+public:
+    VlangCleanStepFactory();
+};
+
+} // namespace Internal
+} // namespace Vcreator
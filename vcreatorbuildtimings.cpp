@@ -0,0 +1,238 @@
+#include "vcreatorbuildtimings.h"
+
+#include <projectexplorer/project.h>
+
+#include <QHelpEvent>
+#include <QLocale>
+#include <QPainter>
+#include <QRegularExpression>
+#include <QToolTip>
+
+#include <algorithm>
+
+namespace VCreator {
+namespace Internal {
+
+static const char timingsKey[] = "Vcreator.BuildTimings";
+static const int maxTimings = 50;
+// Median of this many previous builds is the baseline for regressions
+static const int baselineBuilds = 5;
+
+static const int barWidth = 8;
+static const int barSpacing = 2;
+
+double BuildTiming::totalMs() const
+{
+    double total = 0;
+    for (const BuildPhase &phase : phases)
+        total += phase.ms;
+    return total;
+}
+
+double BuildTiming::phaseMs(const QString &name) const
+{
+    for (const BuildPhase &phase : phases) {
+        if (phase.name == name)
+            return phase.ms;
+    }
+    return 0;
+}
+
+QVariantMap BuildTiming::toMap() const
+{
+    QVariantList phaseList;
+    for (const BuildPhase &phase : phases)
+        phaseList.append(QVariantList{phase.name, phase.ms});
+    return {{"Timestamp", timestamp.toMSecsSinceEpoch()},
+            {"Phases", phaseList},
+            {"Regression", regression}};
+}
+
+BuildTiming BuildTiming::fromMap(const QVariantMap &map)
+{
+    BuildTiming timing;
+    timing.timestamp = QDateTime::fromMSecsSinceEpoch(map.value("Timestamp").toLongLong());
+    timing.regression = map.value("Regression").toBool();
+    for (const QVariant &phase : map.value("Phases").toList()) {
+        const QVariantList values = phase.toList();
+        if (values.size() == 2)
+            timing.phases.append({values.at(0).toString(), values.at(1).toDouble()});
+    }
+    return timing;
+}
+
+BuildTimingsParser::BuildTimingsParser(const PhaseHandler &handler)
+    : m_handler(handler)
+{
+}
+
+Utils::OutputLineParser::Result BuildTimingsParser::handleLine(const QString &line,
+                                                                Utils::OutputFormat format)
+{
+    Q_UNUSED(format)
+    static const QRegularExpression nameFirst(R"(^\s*([A-Za-z][\w .-]*?)\s*:\s*([\d.]+)\s*ms\s*$)");
+    static const QRegularExpression timeFirst(R"(^\s*([\d.]+)\s*ms\s+([A-Za-z][\w .:-]*?)\s*$)");
+
+    BuildPhase phase;
+    QRegularExpressionMatch match = nameFirst.match(line);
+    if (match.hasMatch()) {
+        phase = {match.captured(1), match.captured(2).toDouble()};
+    } else {
+        match = timeFirst.match(line);
+        if (match.hasMatch())
+            phase = {match.captured(2), match.captured(1).toDouble()};
+    }
+    // The overall time would count every phase twice
+    if (!phase.name.isEmpty() && !phase.name.startsWith(QLatin1String("total"), Qt::CaseInsensitive))
+        m_handler(phase);
+    return Status::NotHandled;
+}
+
+QVector<BuildTiming> buildTimings(const ProjectExplorer::Project *project)
+{
+    QVector<BuildTiming> timings;
+    if (!project)
+        return timings;
+    for (const QVariant &timing : project->namedSettings(timingsKey).toList())
+        timings.append(BuildTiming::fromMap(timing.toMap()));
+    return timings;
+}
+
+static double median(QVector<double> values)
+{
+    if (values.isEmpty())
+        return 0;
+    std::sort(values.begin(), values.end());
+    const int middle = values.size() / 2;
+    return values.size() % 2 ? values.at(middle) : (values.at(middle - 1) + values.at(middle)) / 2;
+}
+
+QStringList addBuildTiming(ProjectExplorer::Project *project, BuildTiming &timing, int threshold)
+{
+    QVector<BuildTiming> timings = buildTimings(project);
+    const QVector<BuildTiming> previous = timings.mid(qMax(0, timings.size() - baselineBuilds));
+
+    // A single slow build must not become the new normal, hence the median
+    QStringList regressed;
+    const double factor = 1 + threshold / 100.0;
+    if (!previous.isEmpty()) {
+        QVector<double> totals;
+        for (const BuildTiming &before : previous)
+            totals.append(before.totalMs());
+        timing.regression = timing.totalMs() > median(totals) * factor;
+    }
+    if (timing.regression) {
+        for (const BuildPhase &phase : qAsConst(timing.phases)) {
+            QVector<double> values;
+            for (const BuildTiming &before : previous)
+                values.append(before.phaseMs(phase.name));
+            const double baseline = median(values);
+            if (phase.ms > baseline * factor) {
+                regressed.append(BuildTimingsChart::tr("%1 %2 ms (was %3 ms)")
+                                 .arg(phase.name)
+                                 .arg(phase.ms, 0, 'f', 1)
+                                 .arg(baseline, 0, 'f', 1));
+            }
+        }
+    }
+
+    timings.append(timing);
+    QVariantList list;
+    for (int i = qMax(0, timings.size() - maxTimings); i < timings.size(); ++i)
+        list.append(timings.at(i).toMap());
+    project->setNamedSettings(timingsKey, list);
+    return regressed;
+}
+
+static QColor phaseColor(const QString &name)
+{
+    return QColor::fromHsv(int(qHash(name.toLower()) % 360), 120, 210);
+}
+
+BuildTimingsChart::BuildTimingsChart(ProjectExplorer::Project *project, QWidget *parent)
+    : QWidget(parent)
+    , m_project(project)
+{
+    updateTimings();
+}
+
+void BuildTimingsChart::updateTimings()
+{
+    m_timings = buildTimings(m_project);
+    update();
+}
+
+QSize BuildTimingsChart::sizeHint() const
+{
+    return QSize(maxTimings * (barWidth + barSpacing), 60);
+}
+
+int BuildTimingsChart::buildAt(const QPoint &pos) const
+{
+    const int visible = qMin(int(m_timings.size()), width() / (barWidth + barSpacing));
+    const int index = pos.x() / (barWidth + barSpacing);
+    if (index >= visible)
+        return -1;
+    return m_timings.size() - visible + index;
+}
+
+void BuildTimingsChart::paintEvent(QPaintEvent *event)
+{
+    Q_UNUSED(event)
+    QPainter painter(this);
+    painter.fillRect(rect(), palette().base());
+    if (m_timings.isEmpty()) {
+        painter.setPen(palette().color(QPalette::Disabled, QPalette::Text));
+        painter.drawText(rect(), Qt::AlignCenter, tr("No timed builds yet"));
+        return;
+    }
+
+    const int visible = qMin(int(m_timings.size()), width() / (barWidth + barSpacing));
+    const int first = m_timings.size() - visible;
+    double maximum = 0;
+    for (int i = first; i < m_timings.size(); ++i)
+        maximum = qMax(maximum, m_timings.at(i).totalMs());
+    if (maximum <= 0)
+        return;
+
+    for (int i = first; i < m_timings.size(); ++i) {
+        const BuildTiming &timing = m_timings.at(i);
+        const int x = (i - first) * (barWidth + barSpacing);
+        double y = height();
+        for (const BuildPhase &phase : timing.phases) {
+            const double barHeight = phase.ms / maximum * (height() - 1);
+            painter.fillRect(QRectF(x, y - barHeight, barWidth, barHeight), phaseColor(phase.name));
+            y -= barHeight;
+        }
+        if (timing.regression) {
+            painter.setPen(Qt::red);
+            painter.drawRect(QRectF(x, y, barWidth - 1, height() - y - 1));
+        }
+    }
+}
+
+bool BuildTimingsChart::event(QEvent *event)
+{
+    if (event->type() != QEvent::ToolTip)
+        return QWidget::event(event);
+
+    auto helpEvent = static_cast<QHelpEvent *>(event);
+    const int index = buildAt(helpEvent->pos());
+    if (index < 0) {
+        QToolTip::hideText();
+        return true;
+    }
+
+    const BuildTiming &timing = m_timings.at(index);
+    QString text = tr("%1: %2 ms").arg(QLocale().toString(timing.timestamp, QLocale::ShortFormat))
+            .arg(timing.totalMs(), 0, 'f', 1);
+    if (timing.regression)
+        text += QLatin1Char(' ') + tr("(regression)");
+    for (const BuildPhase &phase : timing.phases)
+        text += QLatin1Char('\n') + tr("%1: %2 ms").arg(phase.name).arg(phase.ms, 0, 'f', 1);
+    QToolTip::showText(helpEvent->globalPos(), text, this);
+    return true;
+}
+
+} // namespace Internal
+} // namespace Vcreator
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <projectexplorer/ioutputparser.h>
+
+#include <QDateTime>
+#include <QPointer>
+#include <QVector>
+#include <QWidget>
+
+#include <functional>
+
+namespace ProjectExplorer { class Project; }
+
+namespace VCreator {
+namespace Internal {
+
+struct BuildPhase
+{
+    QString name;
+    double ms = 0;
+};
+
+struct BuildTiming
+{
+    QDateTime timestamp;
+    QVector<BuildPhase> phases;
+    bool regression = false;
+
+    double totalMs() const;
+    double phaseMs(const QString &name) const;
+
+    QVariantMap toMap() const;
+    static BuildTiming fromMap(const QVariantMap &map);
+};
+
+// Picks the phase lines "-show-timings" prints out of the compile output,
+// both "PARSE : 12.3 ms" and "12.3 ms PARSE". The lines are left to the
+// other parsers and stay visible.
+class BuildTimingsParser : public Utils::OutputLineParser
+{
+public:
+    using PhaseHandler = std::function<void(const BuildPhase &)>;
+    explicit BuildTimingsParser(const PhaseHandler &handler);
+
+private:
+    Result handleLine(const QString &line, Utils::OutputFormat format) override;
+
+    PhaseHandler m_handler;
+};
+
+// Timing history of a project's builds, oldest first, kept in the project's
+// named settings.
+QVector<BuildTiming> buildTimings(const ProjectExplorer::Project *project);
+
+// Appends timing to the history and flags it as regression when its total
+// exceeds the median of the previous builds by more than threshold percent.
+// Returns the phases that regressed, empty when the build did not.
+QStringList addBuildTiming(ProjectExplorer::Project *project, BuildTiming &timing, int threshold);
+
+// Stacked bar per recorded build, one color per phase, regressions are
+// outlined in red.
+class BuildTimingsChart : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit BuildTimingsChart(ProjectExplorer::Project *project, QWidget *parent = nullptr);
+
+    void updateTimings();
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+    bool event(QEvent *event) override;
+    QSize sizeHint() const override;
+
+private:
+    int buildAt(const QPoint &pos) const;
+
+    QPointer<ProjectExplorer::Project> m_project;
+    QVector<BuildTiming> m_timings;
+};
+
+} // namespace Internal
+} // namespace Vcreator
@@ -0,0 +1,340 @@
+#include "vcreatorcallhierarchy.h"
+#include "vcreatorplugin.h"
+#include "vcreatorsources.h"
+#include "vcreatorusages.h"
+
+#include <coreplugin/navigationwidget.h>
+#include <texteditor/textdocument.h>
+#include <texteditor/texteditor.h>
+
+#include <QComboBox>
+#include <QFileInfo>
+#include <QTreeWidget>
+#include <QVBoxLayout>
+
+#include <algorithm>
+
+namespace VCreator {
+namespace Internal {
+
+static CallIndex *m_instance = nullptr;
+
+static const char callHierarchyId[] = "Vcreator.CallHierarchy";
+
+static bool isFunction(const Symbol &symbol)
+{
+    return symbol.kind == Symbol::Function || symbol.kind == Symbol::Method;
+}
+
+// File indexes are replaced on every change, compare by location instead
+static bool isSameSymbol(const SymbolRef &a, const SymbolRef &b)
+{
+    return a.file->filePath == b.file->filePath && a.symbol().line == b.symbol().line
+            && a.symbol().name == b.symbol().name;
+}
+
+static QString qualifiedName(const Symbol &symbol)
+{
+    return symbol.receiver.isEmpty() ? symbol.name
+                                     : symbol.receiver + QLatin1Char('.') + symbol.name;
+}
+
+static QVector<SymbolRef> callTargets(const FileIndexPtr &file, const CallSite &call)
+{
+    QVector<SymbolRef> targets = SymbolIndex::instance()->resolve(file->filePath, call.qualifier,
+                                                                  call.name, call.qualified);
+    targets.erase(std::remove_if(targets.begin(), targets.end(), [](const SymbolRef &target) {
+        return !isFunction(target.symbol());
+    }), targets.end());
+    return targets;
+}
+
+// Groups call sites by the function on the other end, in order of appearance
+class CallCollector
+{
+public:
+    void add(const SymbolRef &function, const QString &filePath, const CallSite &call)
+    {
+        const QString key = function.file->filePath + QLatin1Char('|')
+                + QString::number(function.index);
+        auto it = m_indexes.constFind(key);
+        if (it == m_indexes.constEnd()) {
+            it = m_indexes.insert(key, m_calls.size());
+            m_calls.append({function, filePath, call.line, call.column, 0});
+        }
+        ++m_calls[*it].count;
+    }
+
+    QVector<Call> calls() const { return m_calls; }
+
+private:
+    QHash<QString, int> m_indexes;
+    QVector<Call> m_calls;
+};
+
+CallIndex::CallIndex()
+{
+    m_instance = this;
+    connect(SymbolIndex::instance(), &SymbolIndex::filesIndexed, this, &CallIndex::updateFiles);
+    connect(SymbolIndex::instance(), &SymbolIndex::filesRemoved, this, [this](const QStringList &files) {
+        for (const QString &file : files)
+            removeFile(file);
+    });
+}
+
+CallIndex::~CallIndex()
+{
+    m_instance = nullptr;
+}
+
+CallIndex *CallIndex::instance()
+{
+    return m_instance;
+}
+
+void CallIndex::updateFiles(const QStringList &files)
+{
+    for (const QString &filePath : files) {
+        removeFile(filePath);
+        const FileIndexPtr file = SymbolIndex::instance()->file(filePath);
+        if (!file)
+            continue;
+
+        QStringList &names = m_namesByFile[filePath];
+        for (int i = 0; i < file->calls.size(); ++i) {
+            const CallSite &call = file->calls.at(i);
+            if (call.caller < 0)
+                continue;
+            QVector<CallRef> &calls = m_callsByName[call.name];
+            if (calls.isEmpty() || calls.last().file != file)
+                names.append(call.name);
+            calls.append({file, i});
+        }
+    }
+}
+
+void CallIndex::removeFile(const QString &filePath)
+{
+    const QStringList names = m_namesByFile.take(filePath);
+    for (const QString &name : names) {
+        auto calls = m_callsByName.find(name);
+        if (calls == m_callsByName.end())
+            continue;
+        calls->erase(std::remove_if(calls->begin(), calls->end(), [&filePath](const CallRef &call) {
+            return call.file->filePath == filePath;
+        }), calls->end());
+        if (calls->isEmpty())
+            m_callsByName.erase(calls);
+    }
+}
+
+QVector<Call> CallIndex::incomingCalls(const SymbolRef &function) const
+{
+    CallCollector collector;
+    for (const CallRef &ref : m_callsByName.value(function.symbol().name)) {
+        const CallSite &call = ref.file->calls.at(ref.index);
+        const QVector<SymbolRef> targets = callTargets(ref.file, call);
+        const bool callsFunction = std::any_of(targets.cbegin(), targets.cend(),
+                                               [&function](const SymbolRef &target) {
+            return isSameSymbol(target, function);
+        });
+        if (callsFunction)
+            collector.add(SymbolRef{ref.file, call.caller}, ref.file->filePath, call);
+    }
+    return collector.calls();
+}
+
+QVector<Call> CallIndex::outgoingCalls(const SymbolRef &function) const
+{
+    // The index the function was found in may be outdated by now
+    const FileIndexPtr file = SymbolIndex::instance()->file(function.file->filePath);
+    if (!file)
+        return {};
+    int caller = -1;
+    for (int i = 0; i < file->symbols.size() && caller < 0; ++i) {
+        if (isSameSymbol(SymbolRef{file, i}, function))
+            caller = i;
+    }
+
+    CallCollector collector;
+    for (const CallSite &call : file->calls) {
+        if (call.caller != caller || caller < 0)
+            continue;
+        const QVector<SymbolRef> targets = callTargets(file, call);
+        if (!targets.isEmpty())
+            collector.add(targets.first(), file->filePath, call);
+    }
+    return collector.calls();
+}
+
+SymbolRef CallIndex::functionUnderCursor(TextEditor::TextEditorWidget *editor)
+{
+    int start = -1;
+    const QString name = identifierUnderCursor(editor->textCursor(), &start);
+    if (name.isEmpty())
+        return SymbolRef();
+
+    bool qualified = false;
+    const QString qualifier = qualifierAt(editor->document(), start, &qualified);
+    const QVector<SymbolRef> symbols = SymbolIndex::instance()->resolve(
+                editor->textDocument()->filePath().toString(), qualifier, name, qualified);
+    for (const SymbolRef &symbol : symbols) {
+        if (isFunction(symbol.symbol()))
+            return symbol;
+    }
+    return SymbolRef();
+}
+
+enum ItemRole {
+    FileRole = Qt::UserRole,
+    LineRole,
+    ColumnRole,
+    PopulatedRole
+};
+
+// Children are resolved when an item is expanded for the first time, so
+// only the levels that are looked at cost anything.
+class CallHierarchyWidget : public QWidget
+{
+    Q_DECLARE_TR_FUNCTIONS(VCreator::Internal::CallHierarchyWidget)
+
+public:
+    explicit CallHierarchyWidget(QWidget *parent = nullptr);
+
+    QComboBox *directionBox() const { return m_direction; }
+    void setFunction(const SymbolRef &function);
+
+private:
+    void rebuild();
+    QTreeWidgetItem *addFunction(QTreeWidgetItem *parent, const SymbolRef &function);
+    void populate(QTreeWidgetItem *item);
+    bool isIncoming() const { return m_direction->currentIndex() == 0; }
+
+    QTreeWidget *m_tree;
+    QComboBox *m_direction;
+    SymbolRef m_function;
+    QHash<QTreeWidgetItem *, SymbolRef> m_functions;
+};
+
+CallHierarchyWidget::CallHierarchyWidget(QWidget *parent)
+    : QWidget(parent)
+    , m_tree(new QTreeWidget(this))
+    , m_direction(new QComboBox)
+{
+    m_tree->setHeaderHidden(true);
+    m_tree->setFrameStyle(QFrame::NoFrame);
+    m_tree->setUniformRowHeights(true);
+
+    auto layout = new QVBoxLayout(this);
+    layout->setContentsMargins(0, 0, 0, 0);
+    layout->addWidget(m_tree);
+
+    m_direction->addItems({tr("Incoming Calls"), tr("Outgoing Calls")});
+    connect(m_direction, QOverload<int>::of(&QComboBox::currentIndexChanged),
+            this, &CallHierarchyWidget::rebuild);
+
+    connect(m_tree, &QTreeWidget::itemExpanded, this, &CallHierarchyWidget::populate);
+    connect(m_tree, &QTreeWidget::itemActivated, this, [](QTreeWidgetItem *item) {
+        const QString file = item->data(0, FileRole).toString();
+        if (!file.isEmpty())
+            openEditorAt(file, item->data(0, LineRole).toInt(), item->data(0, ColumnRole).toInt());
+    });
+
+    rebuild();
+}
+
+void CallHierarchyWidget::setFunction(const SymbolRef &function)
+{
+    m_function = function;
+    rebuild();
+}
+
+void CallHierarchyWidget::rebuild()
+{
+    m_tree->clear();
+    m_functions.clear();
+    if (!m_function.file) {
+        auto item = new QTreeWidgetItem(m_tree, {tr("No function selected")});
+        item->setDisabled(true);
+        return;
+    }
+
+    QTreeWidgetItem *root = addFunction(nullptr, m_function);
+    const Symbol &symbol = m_function.symbol();
+    root->setData(0, FileRole, m_function.file->filePath);
+    root->setData(0, LineRole, symbol.line);
+    root->setData(0, ColumnRole, symbol.column);
+    root->setExpanded(true);
+}
+
+QTreeWidgetItem *CallHierarchyWidget::addFunction(QTreeWidgetItem *parent, const SymbolRef &function)
+{
+    auto item = parent ? new QTreeWidgetItem(parent) : new QTreeWidgetItem(m_tree);
+    item->setText(0, qualifiedName(function.symbol()));
+    item->setToolTip(0, function.symbol().signature);
+    m_functions.insert(item, function);
+
+    // Recursion ends the branch, the function is already expanded above
+    bool recursive = false;
+    for (QTreeWidgetItem *ancestor = parent; ancestor && !recursive; ancestor = ancestor->parent())
+        recursive = isSameSymbol(m_functions.value(ancestor), function);
+    item->setChildIndicatorPolicy(recursive ? QTreeWidgetItem::DontShowIndicator
+                                            : QTreeWidgetItem::ShowIndicator);
+    item->setData(0, PopulatedRole, recursive);
+    return item;
+}
+
+void CallHierarchyWidget::populate(QTreeWidgetItem *item)
+{
+    if (item->data(0, PopulatedRole).toBool())
+        return;
+    item->setData(0, PopulatedRole, true);
+
+    const SymbolRef function = m_functions.value(item);
+    if (!function.file)
+        return;
+    const QVector<Call> calls = isIncoming() ? CallIndex::instance()->incomingCalls(function)
+                                             : CallIndex::instance()->outgoingCalls(function);
+    for (const Call &call : calls) {
+        QTreeWidgetItem *child = addFunction(item, call.function);
+        QString location = tr("%1:%2").arg(QFileInfo(call.filePath).fileName()).arg(call.line);
+        if (call.count > 1)
+            location = tr("%1, %n calls", nullptr, call.count).arg(location);
+        child->setText(0, tr("%1 (%2)").arg(child->text(0), location));
+        child->setData(0, FileRole, call.filePath);
+        child->setData(0, LineRole, call.line);
+        child->setData(0, ColumnRole, call.column);
+    }
+    if (calls.isEmpty())
+        item->setChildIndicatorPolicy(QTreeWidgetItem::DontShowIndicator);
+}
+
+CallHierarchyFactory::CallHierarchyFactory()
+{
+    setDisplayName(tr("V Call Hierarchy"));
+    setPriority(460);
+    setId(callHierarchyId);
+}
+
+Core::NavigationView CallHierarchyFactory::createWidget()
+{
+    Plugin::ensureLanguageSupport();
+    auto widget = new CallHierarchyWidget;
+    Core::NavigationView view;
+    view.widget = widget;
+    view.dockToolBarWidgets.append(widget->directionBox());
+    return view;
+}
+
+void CallHierarchyFactory::openCallHierarchy(TextEditor::TextEditorWidget *editor)
+{
+    const SymbolRef function = CallIndex::functionUnderCursor(editor);
+    if (!function.file)
+        return;
+    QWidget *widget = Core::NavigationWidget::activateSubWidget(callHierarchyId, Core::Side::Left);
+    if (auto callHierarchy = dynamic_cast<CallHierarchyWidget *>(widget))
+        callHierarchy->setFunction(function);
+}
+
+} // namespace Internal
+} // namespace Vcreator
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "vcreatorsymbolindex.h"
+
+#include <coreplugin/inavigationwidgetfactory.h>
+
+#include <QHash>
+#include <QObject>
+
+namespace TextEditor { class TextEditorWidget; }
+
+namespace VCreator {
+namespace Internal {
+
+struct Call
+{
+    SymbolRef function;     // caller for incoming, callee for outgoing calls
+    QString filePath;       // first call site
+    int line = 0;
+    int column = 0;
+    int count = 0;          // call sites in the caller
+};
+
+// Call sites of all indexed files by called name, kept in sync with the
+// symbol index. Calls are resolved when asked for, one level at a time:
+// by module alias or receiver type where the call site names one, by the
+// method name alone for calls on variables.
+class CallIndex : public QObject
+{
+    Q_OBJECT
+
+public:
+    CallIndex();
+    ~CallIndex() override;
+
+    static CallIndex *instance();
+
+    QVector<Call> incomingCalls(const SymbolRef &function) const;
+    QVector<Call> outgoingCalls(const SymbolRef &function) const;
+
+    // Function or method under the editor's cursor, invalid when there is none
+    static SymbolRef functionUnderCursor(TextEditor::TextEditorWidget *editor);
+
+private:
+    struct CallRef
+    {
+        FileIndexPtr file;
+        int index;
+    };
+
+    void updateFiles(const QStringList &files);
+    void removeFile(const QString &filePath);
+
+    QHash<QString, QVector<CallRef>> m_callsByName;
+    QHash<QString, QStringList> m_namesByFile;
+};
+
+class CallHierarchyFactory : public Core::INavigationWidgetFactory
+{
+    Q_OBJECT
+
+public:
+    CallHierarchyFactory();
+
+    Core::NavigationView createWidget() override;
+
+    // Shows the hierarchy of the function under the editor's cursor
+    static void openCallHierarchy(TextEditor::TextEditorWidget *editor);
+};
+
+} // namespace Internal
+} // namespace Vcreator
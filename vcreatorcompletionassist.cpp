@@ -0,0 +1,389 @@
+#include "vcreatorcompletionassist.h"
+#include "vcreatorlexer.h"
+#include "vcreatorsymbolindex.h"
+#include "vcreatortoolchain.h"
+
+#include <texteditor/codeassist/assistinterface.h>
+#include <texteditor/codeassist/assistproposalitem.h>
+#include <texteditor/codeassist/genericproposal.h>
+#include <texteditor/codeassist/iassistprocessor.h>
+#include <texteditor/completionsettings.h>
+#include <texteditor/texteditorsettings.h>
+#include <utils/utilsicons.h>
+
+#include <QFileInfo>
+#include <QRegularExpression>
+#include <QTextBlock>
+#include <QTextDocument>
+
+using namespace TextEditor;
+
+namespace VCreator {
+namespace Internal {
+
+struct CompletionIcons
+{
+    QIcon keyword;
+    QIcon type;
+    QIcon structType;
+    QIcon enumType;
+    QIcon enumerator;
+    QIcon function;
+    QIcon field;
+    QIcon constant;
+    QIcon module;
+};
+
+// QIcons must be created on the GUI thread, the processor runs on a worker.
+static CompletionIcons createIcons()
+{
+    using namespace Utils::CodeModelIcon;
+    CompletionIcons icons;
+    icons.keyword = iconForType(Keyword);
+    icons.type = iconForType(Class);
+    icons.structType = iconForType(Struct);
+    icons.enumType = iconForType(Enum);
+    icons.enumerator = iconForType(Enumerator);
+    icons.function = iconForType(FuncPublic);
+    icons.field = iconForType(VarPublic);
+    icons.constant = iconForType(Macro);
+    icons.module = iconForType(Namespace);
+    return icons;
+}
+
+// Names sharing only the first letter with the prefix that are scored for
+// subsequence matches, so a short prefix on a large index stays cheap
+static const int maxFuzzyCandidates = 2000;
+
+static bool isIdentifierChar(QChar ch)
+{
+    return ch.isLetterOrNumber() || ch == QLatin1Char('_');
+}
+
+// Case insensitive subsequence match of prefix in name, -1 when there is no
+// match. Prefix matches rank first, then matches on word starts ("jp" for
+// join_path) and runs of consecutive characters.
+static int fuzzyScore(const QString &name, const QString &prefix)
+{
+    if (prefix.isEmpty())
+        return 0;
+    if (name.startsWith(prefix))
+        return 2000 - name.size();
+    if (name.startsWith(prefix, Qt::CaseInsensitive))
+        return 1000 - name.size();
+
+    int score = 0;
+    int previous = -2;
+    int j = 0;
+    for (int i = 0; i < name.size() && j < prefix.size(); ++i) {
+        if (name.at(i).toLower() != prefix.at(j).toLower())
+            continue;
+        const bool wordStart = i == 0 || name.at(i - 1) == QLatin1Char('_')
+                || (name.at(i).isUpper() && name.at(i - 1).isLower());
+        score += wordStart ? 10 : (i == previous + 1 ? 5 : 1);
+        previous = i;
+        ++j;
+    }
+    return j == prefix.size() ? score : -1;
+}
+
+static QString returnType(const QString &signature)
+{
+    QString type = signature.mid(signature.lastIndexOf(QLatin1Char(')')) + 1).trimmed();
+    while (type.startsWith(QLatin1Char('?')) || type.startsWith(QLatin1Char('!'))
+           || type.startsWith(QLatin1Char('&'))) {
+        type.remove(0, 1);
+    }
+    if (type.startsWith(QLatin1Char('(')) || type.startsWith(QLatin1Char('[')))
+        return QString();
+    return type.mid(type.lastIndexOf(QLatin1Char('.')) + 1);
+}
+
+class VlangCompletionAssistProcessor : public IAssistProcessor
+{
+public:
+    VlangCompletionAssistProcessor(const CompletionIcons &icons, int characterThreshold)
+        : m_icons(icons)
+        , m_characterThreshold(characterThreshold)
+    {}
+
+    IAssistProposal *perform(const AssistInterface *interface) override;
+
+private:
+    void completeMembers(const AssistInterface *interface, int dotPosition);
+    void completeNames();
+    QString inferType(const AssistInterface *interface, const QString &variable, int position) const;
+    bool isInCommentOrString(const AssistInterface *interface, int position) const;
+
+    void addSymbol(const SymbolRef &ref, int score);
+    void addItem(const QString &text, const QString &detail, const QIcon &icon, int order);
+
+    CompletionIcons m_icons;
+    int m_characterThreshold;
+    QString m_filePath;
+    QString m_prefix;
+    QSet<QString> m_seen;
+    QList<AssistProposalItemInterface *> m_items;
+};
+
+IAssistProposal *VlangCompletionAssistProcessor::perform(const AssistInterface *interface)
+{
+    QScopedPointer<const AssistInterface> assistInterface(interface);
+
+    const int position = interface->position();
+    int start = position;
+    while (start > 0 && isIdentifierChar(interface->characterAt(start - 1)))
+        --start;
+    m_prefix = interface->textAt(start, position - start);
+    m_filePath = interface->filePath().toString();
+
+    const bool memberAccess = start > 0 && interface->characterAt(start - 1) == QLatin1Char('.');
+    if (interface->reason() == IdleEditor && !memberAccess && m_prefix.size() < m_characterThreshold)
+        return nullptr;
+    if (isInCommentOrString(interface, position))
+        return nullptr;
+
+    if (memberAccess)
+        completeMembers(interface, start - 1);
+    else
+        completeNames();
+
+    if (m_items.isEmpty())
+        return nullptr;
+    return new GenericProposal(start, m_items);
+}
+
+bool VlangCompletionAssistProcessor::isInCommentOrString(const AssistInterface *interface, int position) const
+{
+    const QTextBlock block = interface->textDocument()->findBlock(position);
+    const int column = position - block.position();
+    Scanner scanner;
+    const QList<Token> tokens = scanner(block.text());
+    for (const Token &token : tokens) {
+        if ((token.is(Token::Comment) || token.is(Token::String))
+                && column > token.begin() && column <= token.end()) {
+            return token.is(Token::Comment) || column < token.end();
+        }
+    }
+    return false;
+}
+
+void VlangCompletionAssistProcessor::completeMembers(const AssistInterface *interface, int dotPosition)
+{
+    int start = dotPosition;
+    while (start > 0 && isIdentifierChar(interface->characterAt(start - 1)))
+        --start;
+    const QString qualifier = interface->textAt(start, dotPosition - start);
+    if (qualifier.isEmpty())
+        return;
+
+    SymbolIndex *index = SymbolIndex::instance();
+    const FileIndexPtr file = index->file(m_filePath);
+    if (file) {
+        if (const Import *import = file->importForAlias(qualifier)) {
+            const QString directory = index->resolveImport(m_filePath, import->path);
+            const QVector<SymbolRef> declarations = index->moduleDeclarations(directory);
+            for (const SymbolRef &ref : declarations) {
+                const int score = fuzzyScore(ref.symbol().name, m_prefix);
+                if (ref.symbol().isPublic && score >= 0)
+                    addSymbol(ref, score);
+            }
+            return;
+        }
+    }
+
+    // Enum values and static-like access on a type name, otherwise the
+    // members of the variable's type.
+    QVector<SymbolRef> members = index->members(qualifier);
+    if (members.isEmpty())
+        members = index->members(inferType(interface, qualifier, start));
+    for (const SymbolRef &ref : qAsConst(members)) {
+        const int score = fuzzyScore(ref.symbol().name, m_prefix);
+        if (score >= 0)
+            addSymbol(ref, score);
+    }
+}
+
+QString VlangCompletionAssistProcessor::inferType(const AssistInterface *interface,
+                                                  const QString &variable,
+                                                  int position) const
+{
+    // Only look at the text before the variable, declarations come first
+    const int windowStart = qMax(0, position - 100000);
+    const QString text = interface->textAt(windowStart, position - windowStart);
+    const QString name = QRegularExpression::escape(variable);
+
+    const QRegularExpression literal(QString(R"(\b%1\s*:=\s*&?(?:\w+\.)?(\w+)\s*\{)").arg(name));
+    const QRegularExpression call(QString(R"(\b%1\s*:=\s*(?:(\w+)\.)?(\w+)\s*\()").arg(name));
+    const QRegularExpression typed(QString(R"([(,]\s*(?:mut\s+|shared\s+)?%1\s+&?(?:\w+\.)?([A-Z]\w*))").arg(name));
+
+    int bestStart = -1;
+    QString type;
+    const auto lastMatch = [&text](const QRegularExpression &re) {
+        QRegularExpressionMatch last;
+        QRegularExpressionMatchIterator it = re.globalMatch(text);
+        while (it.hasNext())
+            last = it.next();
+        return last;
+    };
+
+    const QRegularExpressionMatch literalMatch = lastMatch(literal);
+    if (literalMatch.hasMatch() && !Scanner::keywords().contains(literalMatch.captured(1))) {
+        bestStart = literalMatch.capturedStart();
+        type = literalMatch.captured(1);
+    }
+    const QRegularExpressionMatch typedMatch = lastMatch(typed);
+    if (typedMatch.hasMatch() && typedMatch.capturedStart() > bestStart) {
+        bestStart = typedMatch.capturedStart();
+        type = typedMatch.captured(1);
+    }
+    const QRegularExpressionMatch callMatch = lastMatch(call);
+    if (callMatch.hasMatch() && callMatch.capturedStart() > bestStart) {
+        const QVector<SymbolRef> functions = SymbolIndex::instance()->resolve(
+                    m_filePath, callMatch.captured(1), callMatch.captured(2),
+                    callMatch.capturedLength(1) > 0);
+        if (!functions.isEmpty())
+            type = returnType(functions.first().symbol().signature);
+    }
+    return type;
+}
+
+void VlangCompletionAssistProcessor::completeNames()
+{
+    const auto addStatic = [this](const QSet<QString> &names, const QIcon &icon) {
+        for (const QString &name : names) {
+            const int score = fuzzyScore(name, m_prefix);
+            if (score >= 0)
+                addItem(name, QString(), icon, score);
+        }
+    };
+    addStatic(Scanner::keywords(), m_icons.keyword);
+    addStatic(Scanner::builtinTypes(), m_icons.type);
+    addStatic(Scanner::builtinFunctions(), m_icons.function);
+
+    SymbolIndex *index = SymbolIndex::instance();
+    const QString directory = QFileInfo(m_filePath).absolutePath();
+    const QString builtin = ToolchainManager::instance()->vlibDirectory() + QLatin1String("/builtin");
+    const FileIndexPtr file = index->file(m_filePath);
+
+    QSet<QString> selectiveImports;
+    if (file) {
+        for (const Import &import : file->imports) {
+            const int score = fuzzyScore(import.alias, m_prefix);
+            if (score >= 0)
+                addItem(import.alias, import.path, m_icons.module, score);
+            for (const QString &symbol : import.symbols)
+                selectiveImports.insert(symbol);
+        }
+    }
+
+    if (m_prefix.isEmpty()) {
+        const QVector<SymbolRef> declarations = index->moduleDeclarations(directory);
+        for (const SymbolRef &ref : declarations)
+            addSymbol(ref, 0);
+        return;
+    }
+
+    // The trie yields the names starting with the typed prefix. Subsequence
+    // matches ("jp" for join_path) come from a bounded pass over the names
+    // starting with its first letter, the fuzzy score ranks both.
+    QStringList names = index->namesWithPrefix(m_prefix);
+    if (m_prefix.size() > 1) {
+        const QStringList candidates = index->namesWithPrefix(m_prefix.left(1), maxFuzzyCandidates);
+        for (const QString &name : candidates) {
+            if (!name.startsWith(m_prefix, Qt::CaseInsensitive))
+                names.append(name);
+        }
+    }
+    for (const QString &name : qAsConst(names)) {
+        const int score = fuzzyScore(name, m_prefix);
+        if (score < 0)
+            continue;
+        const QVector<SymbolRef> symbols = index->symbols(name);
+        for (const SymbolRef &ref : symbols) {
+            const Symbol &symbol = ref.symbol();
+            if (symbol.isMember())
+                continue;
+            if (ref.file->directory == directory) {
+                // same module ranks above builtins with a similar score
+                addSymbol(ref, score + 50);
+                break;
+            }
+            if (symbol.isPublic && (ref.file->directory == builtin || selectiveImports.contains(name))) {
+                addSymbol(ref, score);
+                break;
+            }
+        }
+    }
+}
+
+void VlangCompletionAssistProcessor::addSymbol(const SymbolRef &ref, int score)
+{
+    const Symbol &symbol = ref.symbol();
+    QIcon icon;
+    switch (symbol.kind) {
+    case Symbol::Function:
+    case Symbol::Method:
+        icon = m_icons.function;
+        break;
+    case Symbol::Struct:
+    case Symbol::Interface:
+    case Symbol::TypeAlias:
+        icon = m_icons.structType;
+        break;
+    case Symbol::Enum:
+        icon = m_icons.enumType;
+        break;
+    case Symbol::EnumValue:
+        icon = m_icons.enumerator;
+        break;
+    case Symbol::Constant:
+    case Symbol::Global:
+        icon = m_icons.constant;
+        break;
+    case Symbol::Field:
+        icon = m_icons.field;
+        break;
+    }
+    addItem(symbol.name, symbol.signature, icon, score);
+}
+
+void VlangCompletionAssistProcessor::addItem(const QString &text, const QString &detail,
+                                             const QIcon &icon, int order)
+{
+    if (m_seen.contains(text))
+        return;
+    m_seen.insert(text);
+
+    auto item = new AssistProposalItem;
+    item->setText(text);
+    item->setDetail(detail);
+    item->setIcon(icon);
+    item->setOrder(order);
+    m_items.append(item);
+}
+
+IAssistProvider::RunType VlangCompletionAssistProvider::runType() const
+{
+    return AsynchronousWithThread;
+}
+
+IAssistProcessor *VlangCompletionAssistProvider::createProcessor() const
+{
+    static const CompletionIcons icons = createIcons();
+    return new VlangCompletionAssistProcessor(
+                icons, TextEditorSettings::completionSettings().m_characterThreshold);
+}
+
+int VlangCompletionAssistProvider::activationCharSequenceLength() const
+{
+    return 1;
+}
+
+bool VlangCompletionAssistProvider::isActivationCharSequence(const QString &sequence) const
+{
+    return sequence == QLatin1String(".");
+}
+
+} // namespace Internal
+} // namespace Vcreator
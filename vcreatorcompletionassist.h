@@ -0,0 +1,21 @@
+#pragma once
+
+#include <texteditor/codeassist/completionassistprovider.h>
+
+namespace VCreator {
+namespace Internal {
+
+class VlangCompletionAssistProvider : public TextEditor::CompletionAssistProvider
+{
+    Q_OBJECT
+
+public:
+    RunType runType() const override;
+    TextEditor::IAssistProcessor *createProcessor() const override;
+
+    int activationCharSequenceLength() const override;
+    bool isActivationCharSequence(const QString &sequence) const override;
+};
+
+} // namespace Internal
+} // namespace Vcreator
@@ -45,5 +45,34 @@ const char C_VLANG_PROJECT_MIMETYPE[] = "text/x-vlang-project";
 
 const char C_VLANG_SETTINGS_GROUP[] = "V";
 
+const char C_VLANG_BUILDCONFIGURATION_ID[] = "Vcreator.BuildConfiguration";
+const char C_VLANG_BUILDSTEP_ID[] = "Vcreator.BuildStep";
+const char C_VLANG_CLEANSTEP_ID[] = "Vcreator.CleanStep";
+const char C_VLANG_RUNCONFIGURATION_ID[] = "Vcreator.RunConfiguration";
+const char C_PROFILE_RUN_MODE[] = "Vcreator.ProfileRunMode";
+const char C_PERF_RUN_MODE[] = "Vcreator.PerfRunMode";
+
+const char C_TASK_FIND_USAGES[] = "Vcreator.Task.FindUsages";
+const char C_TASK_RENAME_SYMBOL[] = "Vcreator.Task.RenameSymbol";
+const char C_TASK_INDEX[] = "Vcreator.Task.Index";
+
+const char C_DIAGNOSTICS_MARK_CATEGORY[] = "Vcreator.Diagnostics";
+const char C_PROFILER_MARK_CATEGORY[] = "Vcreator.Profiler";
+const char C_PERF_MARK_CATEGORY[] = "Vcreator.Perf";
+
+const char C_VLANG_MENU_ID[] = "Vcreator.Menu";
+const char C_ACTION_RUN_TESTS[] = "Vcreator.RunTests";
+const char C_ACTION_RERUN_FAILED_TESTS[] = "Vcreator.RerunFailedTests";
+const char C_ACTION_RUN_AFFECTED_TESTS[] = "Vcreator.RunAffectedTests";
+const char C_ACTION_FIND_IMPLEMENTATIONS[] = "Vcreator.FindImplementations";
+const char C_ACTION_FIND_IMPLEMENTED_INTERFACES[] = "Vcreator.FindImplementedInterfaces";
+const char C_ACTION_OPEN_CALL_HIERARCHY[] = "Vcreator.OpenCallHierarchy";
+const char C_ACTION_JUMP_TO_MATCHING_BRACKET[] = "Vcreator.JumpToMatchingBracket";
+const char C_ACTION_SELECT_ENCLOSING_BLOCK[] = "Vcreator.SelectEnclosingBlock";
+const char C_ACTION_PROFILE[] = "Vcreator.Profile";
+const char C_ACTION_PERF_PROFILE[] = "Vcreator.PerfProfile";
+
+const char C_ENCLOSING_SCOPE_SELECTION[] = "Vcreator.EnclosingScope";
+
 } // namespace Constants
 } // namespace Vcreator
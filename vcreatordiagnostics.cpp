@@ -0,0 +1,325 @@
+#include "vcreatordiagnostics.h"
+#include "vcreatorconstants.h"
+#include "vcreatorimportgraph.h"
+#include "vcreatorsettings.h"
+#include "vcreatorsources.h"
+
+#include <texteditor/textdocument.h>
+#include <texteditor/textmark.h>
+
+#include <utils/runextensions.h>
+#include <utils/theme/theme.h>
+#include <utils/utilsicons.h>
+
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFileInfo>
+#include <QFutureWatcher>
+#include <QProcess>
+#include <QRegularExpression>
+#include <QTemporaryDir>
+#include <QThread>
+
+#include <algorithm>
+
+namespace VCreator {
+namespace Internal {
+
+static VlangDiagnostics *m_instance = nullptr;
+
+class DiagnosticMark : public TextEditor::TextMark
+{
+public:
+    explicit DiagnosticMark(const Diagnostic &diagnostic)
+        : TextEditor::TextMark(Utils::FilePath::fromString(diagnostic.filePath), diagnostic.line,
+                               Constants::C_DIAGNOSTICS_MARK_CATEGORY)
+    {
+        const bool error = diagnostic.severity == Diagnostic::Error;
+        setColor(error ? Utils::Theme::CodeModel_Error_TextMarkColor
+                       : Utils::Theme::CodeModel_Warning_TextMarkColor);
+        setIcon(error ? Utils::Icons::CODEMODEL_ERROR.icon() : Utils::Icons::CODEMODEL_WARNING.icon());
+        setPriority(error ? TextEditor::TextMark::HighPriority
+                          : TextEditor::TextMark::NormalPriority);
+        setLineAnnotation(diagnostic.message);
+        setToolTip(diagnostic.message);
+    }
+};
+
+static VlangDiagnostics::Job prepareJob(const QString &moduleDirectory,
+                                        const QString &projectRoot,
+                                        const QString &compiler,
+                                        const QHash<QString, DocumentSnapshot> &unsaved,
+                                        QStringList importedModules,
+                                        int revision)
+{
+    VlangDiagnostics::Job job;
+    job.moduleDirectory = moduleDirectory;
+    job.checkDirectory = moduleDirectory;
+    job.projectRoot = projectRoot;
+    job.revision = revision;
+
+    QStringList files = vlangModuleFiles(moduleDirectory);
+    for (auto it = unsaved.cbegin(); it != unsaved.cend(); ++it) {
+        if (!files.contains(it.key()))
+            files.append(it.key());
+    }
+    std::sort(files.begin(), files.end());
+
+    if (!unsaved.isEmpty()) {
+        job.overlay.reset(new QTemporaryDir(DocumentSnapshotManager::overlayRoot()
+                                            + QLatin1String("/vcreator-check-XXXXXX")));
+        job.checkDirectory = job.overlay->path();
+    }
+
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(compiler.toUtf8());
+    for (const QString &file : qAsConst(files)) {
+        const auto it = unsaved.constFind(file);
+        const QByteArray contents = it != unsaved.constEnd() ? it->contents()
+                                                             : readSourceFile(file).toUtf8();
+        const QString fileName = QFileInfo(file).fileName();
+        hash.addData(fileName.toUtf8());
+        hash.addData(contents);
+
+        if (job.overlay) {
+            QFile overlayFile(job.overlay->filePath(fileName));
+            if (overlayFile.open(QFile::WriteOnly))
+                overlayFile.write(contents);
+        }
+    }
+
+    // Imports are checked as they are on disk, their files' sizes and
+    // modification times stand in for their contents
+    std::sort(importedModules.begin(), importedModules.end());
+    for (const QString &module : qAsConst(importedModules)) {
+        hash.addData(module.toUtf8());
+        for (const QString &file : vlangModuleFiles(module)) {
+            const QFileInfo info(file);
+            hash.addData(info.fileName().toUtf8());
+            hash.addData(QByteArray::number(info.size()) + ':'
+                         + QByteArray::number(info.lastModified().toMSecsSinceEpoch()));
+        }
+    }
+    job.hash = hash.result();
+    return job;
+}
+
+static QVector<Diagnostic> parseDiagnostics(const QString &output, const VlangDiagnostics::Job &job)
+{
+    static const QRegularExpression diagnostic(
+                R"(^(.+?):(\d+):(?:(\d+):)? (error|warning|notice): (.*)$)",
+                QRegularExpression::MultilineOption);
+
+    const QString overlayPrefix = job.overlay ? QDir::cleanPath(job.checkDirectory) + QLatin1Char('/')
+                                              : QString();
+    QVector<Diagnostic> diagnostics;
+    QRegularExpressionMatchIterator it = diagnostic.globalMatch(output);
+    while (it.hasNext()) {
+        const QRegularExpressionMatch match = it.next();
+        Diagnostic d;
+        d.filePath = QDir::cleanPath(QDir(job.checkDirectory).absoluteFilePath(match.captured(1)));
+        if (!overlayPrefix.isEmpty() && d.filePath.startsWith(overlayPrefix))
+            d.filePath = job.moduleDirectory + d.filePath.mid(overlayPrefix.size() - 1);
+        d.line = match.captured(2).toInt();
+        d.column = match.captured(3).toInt();
+        const QString severity = match.captured(4);
+        d.severity = severity == QLatin1String("error") ? Diagnostic::Error
+                   : severity == QLatin1String("warning") ? Diagnostic::Warning
+                                                          : Diagnostic::Notice;
+        d.message = match.captured(5);
+        diagnostics.append(d);
+    }
+    return diagnostics;
+}
+
+VlangDiagnostics::VlangDiagnostics()
+    : m_maxRunning(qMax(1, QThread::idealThreadCount() / 2))
+    , m_cache(64)
+{
+    m_instance = this;
+    m_futureSynchronizer.setCancelOnWait(true);
+
+    m_idleTimer.setSingleShot(true);
+    m_idleTimer.setInterval(1000);
+    connect(&m_idleTimer, &QTimer::timeout, this, &VlangDiagnostics::checkChangedModules);
+}
+
+VlangDiagnostics::~VlangDiagnostics()
+{
+    for (QProcess *process : m_running.values() + m_exiting.values()) {
+        process->disconnect(this);
+        process->kill();
+        process->waitForFinished(1000);
+    }
+    for (const QVector<TextEditor::TextMark *> &marks : qAsConst(m_marks))
+        qDeleteAll(marks);
+    m_futureSynchronizer.waitForFinished();
+    m_instance = nullptr;
+}
+
+VlangDiagnostics *VlangDiagnostics::instance()
+{
+    return m_instance;
+}
+
+void VlangDiagnostics::watchDocument(TextEditor::TextDocument *document)
+{
+    // Split views share one document
+    if (m_documents.contains(document))
+        return;
+    m_documents.insert(document);
+
+    const auto moduleDirectory = [document] {
+        return document->filePath().toFileInfo().absolutePath();
+    };
+    connect(document, &QObject::destroyed, this, [this, document] {
+        m_documents.remove(document);
+    });
+    connect(document, &TextEditor::TextDocument::contentsChanged, this, [this, moduleDirectory] {
+        moduleChanged(moduleDirectory());
+    });
+    connect(document, &Core::IDocument::saved, this, [this, moduleDirectory] {
+        const QString module = moduleDirectory();
+        moduleChanged(module);
+        // Checks of open importers depend on the saved state of the module
+        for (const QString &importer : ImportGraph::instance()->importingModules(module)) {
+            if (m_marks.contains(importer))
+                moduleChanged(importer);
+        }
+    });
+    moduleChanged(moduleDirectory());
+}
+
+void VlangDiagnostics::moduleChanged(const QString &moduleDirectory)
+{
+    ++m_revisions[moduleDirectory];
+
+    // Whatever is queued or running for the module is outdated now
+    m_queue.erase(std::remove_if(m_queue.begin(), m_queue.end(), [&](const Job &job) {
+        return job.moduleDirectory == moduleDirectory;
+    }), m_queue.end());
+    if (QProcess *process = m_running.take(moduleDirectory)) {
+        m_exiting.insert(process);
+        process->kill();
+    }
+
+    m_changedModules.insert(moduleDirectory);
+    m_idleTimer.start();
+    startNext();
+}
+
+void VlangDiagnostics::checkChangedModules()
+{
+    const QSet<QString> modules = m_changedModules;
+    m_changedModules.clear();
+    for (const QString &moduleDirectory : modules)
+        prepare(moduleDirectory);
+}
+
+void VlangDiagnostics::prepare(const QString &moduleDirectory)
+{
+    const QString compiler = VlangSettings::compilerPath().toString();
+    if (compiler.isEmpty())
+        return;
+
+    const QHash<QString, DocumentSnapshot> unsaved
+            = DocumentSnapshotManager::instance()->modifiedSnapshots(moduleDirectory);
+
+    // Diagnostics change with everything the module imports, directly or not
+    QStringList importedModules;
+    QSet<QString> seen{moduleDirectory};
+    QStringList pending = ImportGraph::instance()->importedModules(moduleDirectory);
+    while (!pending.isEmpty()) {
+        const QString module = pending.takeLast();
+        if (seen.contains(module))
+            continue;
+        seen.insert(module);
+        importedModules.append(module);
+        pending += ImportGraph::instance()->importedModules(module);
+    }
+
+    const QFuture<Job> future = Utils::runAsync(prepareJob, moduleDirectory,
+                                                findProjectRoot(moduleDirectory), compiler,
+                                                unsaved, importedModules,
+                                                m_revisions.value(moduleDirectory));
+    m_futureSynchronizer.addFuture(future);
+
+    auto watcher = new QFutureWatcher<Job>(this);
+    connect(watcher, &QFutureWatcherBase::finished, this, [this, watcher] {
+        if (!watcher->isCanceled())
+            enqueue(watcher->result());
+        watcher->deleteLater();
+    });
+    watcher->setFuture(future);
+}
+
+void VlangDiagnostics::enqueue(const Job &job)
+{
+    if (m_revisions.value(job.moduleDirectory) != job.revision)
+        return;
+
+    if (const QVector<Diagnostic> *cached = m_cache.object(job.hash)) {
+        showDiagnostics(job.moduleDirectory, *cached);
+        return;
+    }
+
+    m_queue.append(job);
+    startNext();
+}
+
+void VlangDiagnostics::startNext()
+{
+    while (m_running.size() + m_exiting.size() < m_maxRunning && !m_queue.isEmpty()) {
+        const Job job = m_queue.takeFirst();
+
+        QStringList arguments{"-check"};
+        if (job.overlay && !job.projectRoot.isEmpty()) {
+            // Imports are still resolved from the real project
+            arguments << "-path" << QString("@vlib|@vmodules|%1|%1/modules").arg(job.projectRoot);
+        }
+        arguments << job.checkDirectory;
+
+        auto process = new QProcess(this);
+        process->setProcessChannelMode(QProcess::MergedChannels);
+        process->setWorkingDirectory(job.checkDirectory);
+        connect(process, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished),
+                this, [this, process, job] { processFinished(process, job); });
+        connect(process, &QProcess::errorOccurred, this, [this, process, job](QProcess::ProcessError error) {
+            if (error == QProcess::FailedToStart)
+                processFinished(process, job);
+        });
+        m_running.insert(job.moduleDirectory, process);
+        process->start(VlangSettings::compilerPath().toString(), arguments);
+    }
+}
+
+void VlangDiagnostics::processFinished(QProcess *process, const Job &job)
+{
+    process->deleteLater();
+    const bool current = m_running.value(job.moduleDirectory) == process;
+    if (current)
+        m_running.remove(job.moduleDirectory);
+    m_exiting.remove(process);
+
+    if (process->exitStatus() == QProcess::NormalExit && process->error() != QProcess::FailedToStart) {
+        const QVector<Diagnostic> diagnostics
+                = parseDiagnostics(QString::fromUtf8(process->readAll()), job);
+        m_cache.insert(job.hash, new QVector<Diagnostic>(diagnostics));
+        if (current && m_revisions.value(job.moduleDirectory) == job.revision)
+            showDiagnostics(job.moduleDirectory, diagnostics);
+    }
+    startNext();
+}
+
+void VlangDiagnostics::showDiagnostics(const QString &moduleDirectory,
+                                       const QVector<Diagnostic> &diagnostics)
+{
+    QVector<TextEditor::TextMark *> &marks = m_marks[moduleDirectory];
+    qDeleteAll(marks);
+    marks.clear();
+    for (const Diagnostic &diagnostic : diagnostics)
+        marks.append(new DiagnosticMark(diagnostic));
+}
+
+} // namespace Internal
+} // namespace Vcreator
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <utils/futuresynchronizer.h>
+
+#include <QCache>
+#include <QHash>
+#include <QObject>
+#include <QSet>
+#include <QSharedPointer>
+#include <QTimer>
+#include <QVector>
+
+QT_BEGIN_NAMESPACE
+class QProcess;
+class QTemporaryDir;
+QT_END_NAMESPACE
+
+namespace TextEditor {
+class TextDocument;
+class TextMark;
+} // namespace TextEditor
+
+namespace VCreator {
+namespace Internal {
+
+struct Diagnostic
+{
+    enum Severity { Error, Warning, Notice };
+
+    QString filePath;
+    int line = 0;   // 1-based
+    int column = 0; // 1-based, 0 when unknown
+    Severity severity = Error;
+    QString message;
+};
+
+// Runs "v -check" on the module of an edited document once edits go idle.
+// Unsaved documents are written to a temporary overlay directory, a check
+// that is overtaken by a newer edit is killed, results are cached by the
+// module's contents and the state of its imports and shown as text marks.
+// Only a bounded number of compiler processes run at the same time, killed
+// ones count until they have exited, the rest are queued.
+class VlangDiagnostics : public QObject
+{
+    Q_OBJECT
+
+public:
+    VlangDiagnostics();
+    ~VlangDiagnostics() override;
+
+    static VlangDiagnostics *instance();
+
+    void watchDocument(TextEditor::TextDocument *document);
+
+    struct Job
+    {
+        QString moduleDirectory;
+        QString checkDirectory;
+        QString projectRoot;
+        QByteArray hash;
+        QSharedPointer<QTemporaryDir> overlay;
+        int revision = 0;
+    };
+
+private:
+    void moduleChanged(const QString &moduleDirectory);
+    void checkChangedModules();
+    void prepare(const QString &moduleDirectory);
+    void enqueue(const Job &job);
+    void startNext();
+    void processFinished(QProcess *process, const Job &job);
+    void showDiagnostics(const QString &moduleDirectory, const QVector<Diagnostic> &diagnostics);
+
+    QSet<TextEditor::TextDocument *> m_documents;
+    QSet<QString> m_changedModules;
+    QHash<QString, int> m_revisions;
+    QTimer m_idleTimer;
+
+    QVector<Job> m_queue;
+    QHash<QString, QProcess *> m_running;
+    QSet<QProcess *> m_exiting; // killed, but not finished yet
+    int m_maxRunning = 1;
+
+    QCache<QByteArray, QVector<Diagnostic>> m_cache;
+    QHash<QString, QVector<TextEditor::TextMark *>> m_marks;
+    Utils::FutureSynchronizer m_futureSynchronizer;
+};
+
+} // namespace Internal
+} // namespace Vcreator
@@ -1,17 +1,192 @@
 #include "vcreatoreditor.h"
+#include "vcreatorbracketindex.h"
+#include "vcreatorcallhierarchy.h"
+#include "vcreatordiagnostics.h"
+#include "vcreatorfolding.h"
+#include "vcreatorformatter.h"
 #include "vcreatorhighlighter.h"
+#include "vcreatorcompletionassist.h"
 #include "vcreatorconstants.h"
+#include "vcreatorhoverhandler.h"
+#include "vcreatorimplementations.h"
 #include "vcreatorindenter.h"
+#include "vcreatorplugin.h"
+#include "vcreatorsemantichighlighter.h"
+#include "vcreatorsources.h"
+#include "vcreatorsymbolindex.h"
+#include "vcreatorusages.h"
+#include "ide.h"
 
 #include <coreplugin/actionmanager/actionmanager.h>
 #include <coreplugin/actionmanager/commandbutton.h>
 
+#include <texteditor/fontsettings.h>
 #include <texteditor/textdocument.h>
 #include <texteditor/texteditoractionhandler.h>
 
+#include <QFileInfo>
+
 namespace VCreator {
 namespace Internal {
 
+void VlangEditorWidget::finalizeInitialization()
+{
+    // Keep the index in sync with unsaved changes, so navigation and hover
+    // see what is on screen.
+    m_updateIndexTimer.setSingleShot(true);
+    m_updateIndexTimer.setInterval(500);
+    connect(&m_updateIndexTimer, &QTimer::timeout, this, &VlangEditorWidget::updateIndex);
+    connect(textDocument(), &TextEditor::TextDocument::contentsChanged,
+            &m_updateIndexTimer, QOverload<>::of(&QTimer::start));
+    m_updateIndexTimer.start();
+
+    m_semanticHighlighter = new VlangSemanticHighlighter(this);
+
+    DocumentSnapshotManager::instance()->watchDocument(textDocument());
+    VlangDiagnostics::instance()->watchDocument(textDocument());
+
+    m_bracketIndex = BracketIndex::forDocument(document());
+    FoldingUpdater::forDocument(document());
+    m_enclosingScopeTimer.setSingleShot(true);
+    m_enclosingScopeTimer.setInterval(50);
+    connect(&m_enclosingScopeTimer, &QTimer::timeout, this, &VlangEditorWidget::updateEnclosingScope);
+    connect(this, &QPlainTextEdit::cursorPositionChanged,
+            &m_enclosingScopeTimer, QOverload<>::of(&QTimer::start));
+}
+
+void VlangEditorWidget::jumpToMatchingBracket()
+{
+    const int position = textCursor().position();
+    int target = -1;
+    int match = m_bracketIndex->match(position);
+    if (match >= 0) {
+        // From an opening bracket to behind its partner, from a closing one to the front
+        target = match > position ? match + 1 : match;
+    } else if (position > 0 && (match = m_bracketIndex->match(position - 1)) >= 0) {
+        target = match > position ? match + 1 : match;
+    } else {
+        target = m_bracketIndex->enclosing(position).first;
+    }
+
+    if (target >= 0) {
+        QTextCursor cursor = textCursor();
+        cursor.setPosition(target);
+        setTextCursor(cursor);
+    }
+}
+
+void VlangEditorWidget::selectEnclosingBlock()
+{
+    QTextCursor cursor = textCursor();
+    QPair<int, int> block = m_bracketIndex->enclosing(cursor.selectionStart());
+    // Repeating the action grows the selection to the next outer block
+    if (cursor.hasSelection() && block.first == cursor.selectionStart()
+            && block.second + 1 == cursor.selectionEnd()) {
+        block = m_bracketIndex->enclosing(block.first);
+    }
+    if (block.first < 0 || block.second < 0)
+        return;
+
+    cursor.setPosition(block.first);
+    cursor.setPosition(block.second + 1, QTextCursor::KeepAnchor);
+    setTextCursor(cursor);
+}
+
+void VlangEditorWidget::updateEnclosingScope()
+{
+    const QPair<int, int> block = m_bracketIndex->enclosing(textCursor().position());
+    QList<QTextEdit::ExtraSelection> selections;
+    if (block.first >= 0 && block.second >= 0) {
+        const QTextCharFormat format
+                = textDocument()->fontSettings().toTextCharFormat(TextEditor::C_PARENTHESES);
+        for (const int position : {block.first, block.second}) {
+            QTextEdit::ExtraSelection selection;
+            selection.cursor = QTextCursor(document());
+            selection.cursor.setPosition(position);
+            selection.cursor.setPosition(position + 1, QTextCursor::KeepAnchor);
+            selection.format = format;
+            selections.append(selection);
+        }
+    }
+    setExtraSelections(Constants::C_ENCLOSING_SCOPE_SELECTION, selections);
+}
+
+void VlangEditorWidget::updateIndex()
+{
+    const QString filePath = textDocument()->filePath().toString();
+    if (filePath.isEmpty())
+        return;
+
+    SymbolIndex *index = SymbolIndex::instance();
+    if (!index->file(filePath) && !textDocument()->isModified()) {
+        // Not part of an indexed project, index the whole module
+        QStringList files = vlangModuleFiles(QFileInfo(filePath).absolutePath());
+        if (!files.contains(filePath))
+            files.append(filePath);
+        index->indexFiles(files);
+    } else {
+        index->indexDocument(DocumentSnapshotManager::instance()->snapshot(filePath));
+    }
+}
+
+void VlangEditorWidget::findLinkAt(const QTextCursor &cursor,
+                                   Utils::ProcessLinkCallback &&processLinkCallback,
+                                   bool resolveTarget,
+                                   bool inNextSplit)
+{
+    Q_UNUSED(resolveTarget)
+    Q_UNUSED(inNextSplit)
+
+    int start = -1;
+    const QString name = identifierUnderCursor(cursor, &start);
+    if (name.isEmpty())
+        return processLinkCallback(Utils::Link());
+
+    bool qualified = false;
+    const QString qualifier = qualifierAt(document(), start, &qualified);
+    const QVector<SymbolRef> symbols = SymbolIndex::instance()->resolve(
+                textDocument()->filePath().toString(), qualifier, name, qualified);
+    if (symbols.isEmpty())
+        return processLinkCallback(Utils::Link());
+
+    const SymbolRef &target = symbols.first();
+// TODO: Remove after Qt Creator 5.0 release
+#if QTCREATOR_VERSION >= QTCREATOR_VERSION_CHECK(4,82,0)
+    Utils::Link link(Utils::FilePath::fromString(target.file->filePath),
+                     target.symbol().line, target.symbol().column);
+#else
+    Utils::Link link(target.file->filePath, target.symbol().line, target.symbol().column);
+#endif
+    link.linkTextStart = start;
+    link.linkTextEnd = start + name.length();
+    processLinkCallback(link);
+}
+
+void VlangEditorWidget::findUsages()
+{
+    VlangUsages::findUsages(this);
+}
+
+void VlangEditorWidget::renameSymbolUnderCursor()
+{
+    VlangUsages::renameSymbol(this);
+}
+
+void VlangEditorWidget::findImplementations()
+{
+    ImplementationIndex::findImplementations(this);
+}
+
+void VlangEditorWidget::findImplementedInterfaces()
+{
+    ImplementationIndex::findImplementedInterfaces(this);
+}
+
+void VlangEditorWidget::openCallHierarchy()
+{
+    CallHierarchyFactory::openCallHierarchy(this);
+}
+
 EditorFactory::EditorFactory()
 {
     addMimeType("application/x-vlang");
@@ -21,15 +196,20 @@ EditorFactory::EditorFactory()
 
     setEditorActionHandlers(TextEditor::TextEditorActionHandler::Format
                             | TextEditor::TextEditorActionHandler::UnCommentSelection
-                            | TextEditor::TextEditorActionHandler::UnCollapseAll);
+                            | TextEditor::TextEditorActionHandler::UnCollapseAll
+                            | TextEditor::TextEditorActionHandler::FollowSymbolUnderCursor
+                            | TextEditor::TextEditorActionHandler::FindUsage
+                            | TextEditor::TextEditorActionHandler::RenameSymbol);
 
     setDocumentCreator([] {
+        Plugin::ensureLanguageSupport();
         auto td = new TextEditor::TextDocument(Constants::C_VLANG_EDITOR_ID);
         td->setMimeType("application/x-vlang");
+        td->setFormatter(new VlangFormatter);
         return td;
     });
     setEditorWidgetCreator([]{
-        auto tw = new TextEditor::TextEditorWidget;
+        auto tw = new VlangEditorWidget;
         tw->setLanguageSettingsId(Constants::C_VLANGUAGE_ID);
         return tw;
     });
@@ -37,6 +217,8 @@ EditorFactory::EditorFactory()
         return new VlangIndenter(doc);
     });
     setSyntaxHighlighterCreator([] { return new VlangHighlighter(); });
+    addHoverHandler(new VlangHoverHandler);
+    setCompletionAssistProvider(new VlangCompletionAssistProvider);
     setCommentDefinition(Utils::CommentDefinition::CppStyle);
     setUseGenericHighlighter(false);
     setParenthesesMatchingEnabled(true);
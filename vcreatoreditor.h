@@ -2,9 +2,43 @@
 
 #include <texteditor/texteditor.h>
 
+#include <QTimer>
+
 namespace VCreator {
 namespace Internal {
 
+class BracketIndex;
+class VlangSemanticHighlighter;
+
+class VlangEditorWidget : public TextEditor::TextEditorWidget
+{
+public:
+    void findUsages() override;
+    void renameSymbolUnderCursor() override;
+
+    void findImplementations();
+    void findImplementedInterfaces();
+    void openCallHierarchy();
+    void jumpToMatchingBracket();
+    void selectEnclosingBlock();
+
+protected:
+    void finalizeInitialization() override;
+    void findLinkAt(const QTextCursor &cursor,
+                    Utils::ProcessLinkCallback &&processLinkCallback,
+                    bool resolveTarget = true,
+                    bool inNextSplit = false) override;
+
+private:
+    void updateIndex();
+    void updateEnclosingScope();
+
+    QTimer m_updateIndexTimer;
+    QTimer m_enclosingScopeTimer;
+    BracketIndex *m_bracketIndex = nullptr;
+    VlangSemanticHighlighter *m_semanticHighlighter = nullptr;
+};
+
 class EditorFactory : public TextEditor::TextEditorFactory
 {
 public:
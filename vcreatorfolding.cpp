@@ -0,0 +1,188 @@
+#include "vcreatorfolding.h"
+#include "vcreatorlexer.h"
+
+#include <texteditor/textdocumentlayout.h>
+#include <utils/runextensions.h>
+
+#include <QSet>
+#include <QTextDocument>
+
+namespace VCreator {
+namespace Internal {
+
+// Blocks written back per event loop iteration
+static const int BatchSize = 2000;
+
+static bool opensStructuralBlock(const SourceTokens &tokens, const Token &token)
+{
+    static const QSet<QString> keywords = {
+        "fn", "struct", "enum", "interface", "union", "match"
+    };
+    static const QSet<QString> compileTime = { "$if", "$else", "$for" };
+
+    const QString text = tokens.textOf(token).toString();
+    if (token.is(Token::Keyword))
+        return keywords.contains(text);
+    return text.startsWith(QLatin1Char('$')) && compileTime.contains(text);
+}
+
+// Last line of the region ending with the token at index, the closing line
+// is only folded away when nothing but comments follows the brace
+static int regionEnd(const SourceTokens &tokens, int index)
+{
+    const QVector<Token> &all = tokens.tokens();
+    const int line = tokens.lineAt(all.at(index).offset);
+    for (int i = index + 1; i < all.size() && tokens.lineAt(all.at(i).offset) == line; ++i) {
+        if (all.at(i).isNot(Token::Comment))
+            return line - 1;
+    }
+    return line;
+}
+
+QVector<int> foldingIndents(const QString &text)
+{
+    const SourceTokens tokens(text);
+    const int lineCount = tokens.lineCount();
+
+    // Each region (start, end) raises the indent of lines start + 1 .. end
+    QVector<int> delta(lineCount + 2, 0);
+    auto addRegion = [&delta](int start, int end) {
+        if (end <= start)
+            return;
+        ++delta[start + 1];
+        --delta[end + 1];
+    };
+
+    QVector<QPair<int, bool>> braces; // opening line, structural
+    bool pending = false;
+    const QVector<Token> &all = tokens.tokens();
+    for (int i = 0; i < all.size(); ++i) {
+        const Token &token = all.at(i);
+        switch (token.kind) {
+        case Token::LeftBrace:
+            braces.append({tokens.lineAt(token.offset), pending});
+            pending = false;
+            break;
+        case Token::RightBrace:
+            if (!braces.isEmpty()) {
+                const QPair<int, bool> open = braces.takeLast();
+                if (open.second)
+                    addRegion(open.first, regionEnd(tokens, i));
+            }
+            pending = false;
+            break;
+        default:
+            if (opensStructuralBlock(tokens, token))
+                pending = true;
+            break;
+        }
+    }
+
+    int commentStart = 0;
+    for (int line = 1; line <= lineCount; ++line) {
+        const bool inside = tokens.lineEndState(line) & Scanner::MultiLineMask;
+        if (inside && !commentStart)
+            commentStart = line;
+        else if (!inside && commentStart) {
+            addRegion(commentStart, line);
+            commentStart = 0;
+        }
+    }
+    if (commentStart)
+        addRegion(commentStart, lineCount);
+
+    QVector<int> indents(lineCount);
+    int indent = 0;
+    for (int line = 1; line <= lineCount; ++line) {
+        indent += delta.at(line);
+        indents[line - 1] = indent;
+    }
+    return indents;
+}
+
+FoldingUpdater::FoldingUpdater(QTextDocument *document)
+    : QObject(document)
+    , m_document(document)
+{
+    m_updateTimer.setSingleShot(true);
+    m_updateTimer.setInterval(300);
+    m_applyTimer.setSingleShot(true);
+    m_applyTimer.setInterval(0);
+
+    connect(&m_updateTimer, &QTimer::timeout, this, &FoldingUpdater::startUpdate);
+    connect(&m_applyTimer, &QTimer::timeout, this, &FoldingUpdater::applyBatch);
+    connect(document, &QTextDocument::contentsChange, this, &FoldingUpdater::onContentsChange);
+    connect(&m_watcher, &QFutureWatcherBase::finished, this, [this] {
+        if (m_watcher.isCanceled() || m_revision != m_document->revision())
+            return;
+        m_indents = m_watcher.result();
+        m_nextBlock = m_document->firstBlock();
+        m_changed = false;
+        applyBatch();
+    });
+
+    if (!document->isEmpty())
+        startUpdate();
+}
+
+FoldingUpdater *FoldingUpdater::forDocument(QTextDocument *document)
+{
+    if (auto updater = document->findChild<FoldingUpdater *>(QString(), Qt::FindDirectChildrenOnly))
+        return updater;
+    return new FoldingUpdater(document);
+}
+
+void FoldingUpdater::onContentsChange(int position, int charsRemoved, int charsAdded)
+{
+    Q_UNUSED(charsRemoved)
+
+    // New lines take over the indent of the line they were split from until
+    // the regions are recomputed, so fold markers do not flicker while typing
+    QTextBlock block = m_document->findBlock(position);
+    const int indent = TextEditor::TextDocumentLayout::foldingIndent(block);
+    const QTextBlock last = m_document->findBlock(position + charsAdded);
+    for (block = block.next(); block.isValid() && block.blockNumber() <= last.blockNumber();
+         block = block.next()) {
+        if (!TextEditor::TextDocumentLayout::textUserData(block))
+            TextEditor::TextDocumentLayout::setFoldingIndent(block, indent);
+    }
+
+    m_applyTimer.stop();
+    m_updateTimer.start();
+}
+
+void FoldingUpdater::startUpdate()
+{
+    m_revision = m_document->revision();
+    m_watcher.setFuture(Utils::runAsync(foldingIndents, m_document->toPlainText()));
+}
+
+void FoldingUpdater::applyBatch()
+{
+    if (m_revision != m_document->revision())
+        return;
+
+    for (int count = 0; m_nextBlock.isValid() && count < BatchSize; ++count) {
+        const int line = m_nextBlock.blockNumber();
+        const int indent = line < m_indents.size() ? m_indents.at(line) : 0;
+        if (TextEditor::TextDocumentLayout::foldingIndent(m_nextBlock) != indent) {
+            TextEditor::TextDocumentLayout::setFoldingIndent(m_nextBlock, indent);
+            m_changed = true;
+        }
+        m_nextBlock = m_nextBlock.next();
+    }
+
+    if (m_nextBlock.isValid()) {
+        m_applyTimer.start();
+        return;
+    }
+
+    m_indents.clear();
+    if (m_changed) {
+        if (auto layout = qobject_cast<TextEditor::TextDocumentLayout *>(m_document->documentLayout()))
+            layout->requestExtraAreaUpdate();
+    }
+}
+
+} // namespace Internal
+} // namespace Vcreator
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <QFutureWatcher>
+#include <QObject>
+#include <QTextBlock>
+#include <QTimer>
+#include <QVector>
+
+QT_BEGIN_NAMESPACE
+class QTextDocument;
+QT_END_NAMESPACE
+
+namespace VCreator {
+namespace Internal {
+
+// Folding indent per line (index 0 is line 1) for the structural regions of
+// text: fn, struct, enum, interface, union and match bodies, $if/$else/$for
+// blocks and multi-line comments and strings. Other braces do not fold.
+QVector<int> foldingIndents(const QString &text);
+
+// Keeps the folding indents of a document up to date. The regions are
+// computed from a snapshot on a worker thread after typing pauses and are
+// written back in batches, so large files never block the editor and the
+// indents are already in place when collapsing everything.
+class FoldingUpdater : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit FoldingUpdater(QTextDocument *document);
+
+    // Shared by all editors of document
+    static FoldingUpdater *forDocument(QTextDocument *document);
+
+private:
+    void onContentsChange(int position, int charsRemoved, int charsAdded);
+    void startUpdate();
+    void applyBatch();
+
+    QTextDocument *m_document;
+    QTimer m_updateTimer;
+    QTimer m_applyTimer;
+    QFutureWatcher<QVector<int>> m_watcher;
+    int m_revision = -1;
+
+    QVector<int> m_indents;
+    QTextBlock m_nextBlock;
+    bool m_changed = false;
+};
+
+} // namespace Internal
+} // namespace Vcreator
@@ -0,0 +1,154 @@
+#include "vcreatorformatter.h"
+#include "vcreatorsettings.h"
+#include "vcreatorsources.h"
+
+#include <coreplugin/documentmanager.h>
+#include <texteditor/textdocument.h>
+
+#include <utils/differ.h>
+#include <utils/runextensions.h>
+
+#include <QFutureWatcher>
+#include <QPointer>
+#include <QProcess>
+#include <QSet>
+#include <QTemporaryFile>
+#include <QTextCursor>
+#include <QTextDocument>
+
+namespace VCreator {
+namespace Internal {
+
+static const int formatTimeoutMs = 30000;
+
+// Documents formatBeforeSave() saves again itself after formatting
+static QSet<Core::IDocument *> m_formattedSaves;
+
+static Utils::ChangeSet formatText(const QString &compiler, const QString &text, int timeout)
+{
+    if (compiler.isEmpty())
+        return Utils::ChangeSet();
+
+    QTemporaryFile file(DocumentSnapshotManager::overlayRoot()
+                        + QLatin1String("/vcreator-fmt-XXXXXX.v"));
+    if (!file.open())
+        return Utils::ChangeSet();
+    file.write(text.toUtf8());
+    file.close();
+
+    QProcess process;
+    process.start(compiler, {"fmt", file.fileName()});
+    if (!process.waitForFinished(timeout)) {
+        process.kill();
+        process.waitForFinished();
+        return Utils::ChangeSet();
+    }
+    // v fmt refuses files with syntax errors, leave those alone
+    if (process.exitStatus() != QProcess::NormalExit || process.exitCode() != 0)
+        return Utils::ChangeSet();
+
+    return lineDiff(text, QString::fromUtf8(process.readAllStandardOutput()));
+}
+
+Utils::ChangeSet lineDiff(const QString &before, const QString &after)
+{
+    Utils::ChangeSet changes;
+    if (before == after || after.isEmpty())
+        return changes;
+
+    Utils::Differ differ;
+    differ.setDiffMode(Utils::Differ::LineMode);
+    const QList<Utils::Diff> diffs = differ.diff(before, after);
+
+    int position = 0;
+    for (int i = 0; i < diffs.size();) {
+        if (diffs.at(i).command == Utils::Diff::Equal) {
+            position += diffs.at(i).text.size();
+            ++i;
+            continue;
+        }
+
+        // A run of deletions and insertions becomes one replacement
+        int removed = 0;
+        QString inserted;
+        for (; i < diffs.size() && diffs.at(i).command != Utils::Diff::Equal; ++i) {
+            if (diffs.at(i).command == Utils::Diff::Delete)
+                removed += diffs.at(i).text.size();
+            else
+                inserted += diffs.at(i).text;
+        }
+        if (removed == 0)
+            changes.insert(position, inserted);
+        else if (inserted.isEmpty())
+            changes.remove(position, position + removed);
+        else
+            changes.replace(position, position + removed, inserted);
+        position += removed;
+    }
+    return changes;
+}
+
+QFutureWatcher<Utils::ChangeSet> *VlangFormatter::format(const QTextCursor &cursor,
+                                                         const TextEditor::TabSettings &tabSettings)
+{
+    Q_UNUSED(tabSettings)
+
+    // v fmt has no notion of ranges, the whole document is formatted
+    QTextDocument *document = cursor.document();
+    const QString text = document->toPlainText();
+    const QString compiler = VlangSettings::compilerPath().toString();
+
+    // TextDocument applies whatever the returned watcher delivers. Changes
+    // for a revision the user has typed over are reported as canceled.
+    QFutureInterface<Utils::ChangeSet> result;
+    result.reportStarted();
+    auto watcher = new QFutureWatcher<Utils::ChangeSet>;
+    watcher->setFuture(result.future());
+
+    auto formatting = new QFutureWatcher<Utils::ChangeSet>(watcher);
+    const QPointer<QTextDocument> guard(document);
+    const int revision = document->revision();
+    QObject::connect(formatting, &QFutureWatcherBase::finished, watcher,
+                     [formatting, guard, revision, result]() mutable {
+        if (formatting->isCanceled() || !guard || guard->revision() != revision)
+            result.reportCanceled();
+        else
+            result.reportResult(formatting->result());
+        result.reportFinished();
+    });
+    formatting->setFuture(Utils::runAsync(formatText, compiler, text, formatTimeoutMs));
+    return watcher;
+}
+
+void VlangFormatter::formatBeforeSave(Core::IDocument *document)
+{
+    auto textDocument = qobject_cast<TextEditor::TextDocument *>(document);
+    if (!textDocument || !VlangSettings::formatOnSave() || m_formattedSaves.contains(document)
+            || !isVlangSourceFile(textDocument->filePath().toString())) {
+        return;
+    }
+
+    // The document is saved as it is, v fmt runs on a worker thread and the
+    // document is saved once more with its result. Nothing is applied when
+    // the user has edited the document in the meantime.
+    const QPointer<TextEditor::TextDocument> guard(textDocument);
+    const int revision = textDocument->document()->revision();
+    auto watcher = new QFutureWatcher<Utils::ChangeSet>;
+    QObject::connect(watcher, &QFutureWatcherBase::finished, [watcher, guard, revision] {
+        watcher->deleteLater();
+        if (!guard || guard->document()->revision() != revision)
+            return;
+        const Utils::ChangeSet changes = watcher->result();
+        if (changes.isEmpty())
+            return;
+        guard->applyChangeSet(changes);
+        m_formattedSaves.insert(guard);
+        Core::DocumentManager::saveDocument(guard);
+        m_formattedSaves.remove(guard);
+    });
+    watcher->setFuture(Utils::runAsync(formatText, VlangSettings::compilerPath().toString(),
+                                       textDocument->plainText(), VlangSettings::formatTimeout()));
+}
+
+} // namespace Internal
+} // namespace Vcreator
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <texteditor/formatter.h>
+
+#include <utils/changeset.h>
+
+namespace Core { class IDocument; }
+
+namespace VCreator {
+namespace Internal {
+
+// Formats documents with "v fmt" on a worker thread. The formatter output is
+// turned into a line diff against the document, so only the changed lines
+// are replaced and the result is a single undo step.
+class VlangFormatter : public TextEditor::Formatter
+{
+public:
+    QFutureWatcher<Utils::ChangeSet> *format(const QTextCursor &cursor,
+                                             const TextEditor::TabSettings &tabSettings) override;
+
+    // Connected to EditorManager::aboutToSave. Formats in the background and
+    // saves the formatted document again, gives up after formatTimeout().
+    static void formatBeforeSave(Core::IDocument *document);
+};
+
+// Changes turning before into after, made of whole replaced lines.
+Utils::ChangeSet lineDiff(const QString &before, const QString &after);
+
+} // namespace Internal
+} // namespace Vcreator
@@ -13,7 +13,6 @@ namespace Internal {
 VlangHighlighter::VlangHighlighter()
     :
       m_braceDepth(0),
-      m_foldingIndent(0),
       m_inMultilineComment(false)
 {
     m_currentBlockParentheses.reserve(20);
@@ -159,13 +158,7 @@ int VlangHighlighter::onBlockStart()
 {
     m_currentBlockParentheses.clear();
     m_braceDepth = 0;
-    m_foldingIndent = 0;
     m_inMultilineComment = false;
-    if (TextEditor::TextBlockUserData *userData = TextEditor::TextDocumentLayout::textUserData(currentBlock())) {
-        userData->setFoldingIndent(0);
-        userData->setFoldingStartIncluded(false);
-        userData->setFoldingEndIncluded(false);
-    }
 
     int state = 0;
     int previousState = previousBlockState();
@@ -174,7 +167,6 @@ int VlangHighlighter::onBlockStart()
         m_braceDepth = (previousState >> 8);
         m_inMultilineComment = ((state & Scanner::MultiLineMask) == Scanner::MultiLineComment);
     }
-    m_foldingIndent = m_braceDepth;
 
     return state;
 }
@@ -183,30 +175,22 @@ void VlangHighlighter::onBlockEnd(int state)
 {
     setCurrentBlockState((m_braceDepth << 8) | state);
     TextEditor::TextDocumentLayout::setParentheses(currentBlock(), m_currentBlockParentheses);
-    TextEditor::TextDocumentLayout::setFoldingIndent(currentBlock(), m_foldingIndent);
 }
 
 void VlangHighlighter::onOpeningParenthesis(QChar parenthesis, int pos, bool atStart)
 {
-    if (parenthesis == QLatin1Char('{') || parenthesis == QLatin1Char('[') || parenthesis == QLatin1Char('(')) {
+    Q_UNUSED(atStart)
+    if (parenthesis == QLatin1Char('{') || parenthesis == QLatin1Char('[') || parenthesis == QLatin1Char('('))
         ++m_braceDepth;
-        // if a folding block opens at the beginning of a line, treat the entire line
-        // as if it were inside the folding block
-        if (atStart)
-            TextEditor::TextDocumentLayout::userData(currentBlock())->setFoldingStartIncluded(true);
-    }
     m_currentBlockParentheses.push_back(TextEditor::Parenthesis(TextEditor::Parenthesis::Opened, parenthesis, pos));
 }
 
 void VlangHighlighter::onClosingParenthesis(QChar parenthesis, int pos, bool atEnd)
 {
-    if (parenthesis == QLatin1Char('}') || parenthesis == QLatin1Char(']') || parenthesis == QLatin1Char(')')) {
+    Q_UNUSED(atEnd)
+    // Folding regions are maintained by FoldingUpdater from the token stream
+    if (parenthesis == QLatin1Char('}') || parenthesis == QLatin1Char(']') || parenthesis == QLatin1Char(')'))
         --m_braceDepth;
-        if (atEnd)
-            TextEditor::TextDocumentLayout::userData(currentBlock())->setFoldingEndIncluded(true);
-        else
-            m_foldingIndent = qMin(m_braceDepth, m_foldingIndent); // folding indent is the minimum brace depth of a block
-    }
     m_currentBlockParentheses.push_back(TextEditor::Parenthesis(TextEditor::Parenthesis::Closed, parenthesis, pos));
 }
 
@@ -31,7 +31,6 @@ protected:
 private:
 //    bool m_qmlEnabled;
     int m_braceDepth;
-    int m_foldingIndent;
     bool m_inMultilineComment;
 
     Scanner m_scanner;
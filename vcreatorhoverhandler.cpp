@@ -0,0 +1,50 @@
+#include "vcreatorhoverhandler.h"
+#include "vcreatorsymbolindex.h"
+#include "vcreatorusages.h"
+
+#include <texteditor/textdocument.h>
+#include <texteditor/texteditor.h>
+
+#include <QTextCursor>
+
+namespace VCreator {
+namespace Internal {
+
+static QString toolTipForSymbol(const SymbolRef &ref)
+{
+    const Symbol &symbol = ref.symbol();
+    QString toolTip = QLatin1String("<pre>") + symbol.signature.toHtmlEscaped() + QLatin1String("</pre>");
+    if (ref.file->module != QLatin1String("main"))
+        toolTip += QLatin1String("<i>module ") + ref.file->module.toHtmlEscaped() + QLatin1String("</i>");
+    if (!symbol.doc.isEmpty()) {
+        toolTip += QLatin1String("<p>")
+                + symbol.doc.toHtmlEscaped().replace(QLatin1Char('\n'), QLatin1String("<br>"))
+                + QLatin1String("</p>");
+    }
+    return toolTip;
+}
+
+void VlangHoverHandler::identifyMatch(TextEditor::TextEditorWidget *editorWidget,
+                                      int pos,
+                                      ReportPriority report)
+{
+    QTextCursor cursor(editorWidget->document());
+    cursor.setPosition(pos);
+
+    int start = -1;
+    const QString name = identifierUnderCursor(cursor, &start);
+    if (!name.isEmpty()) {
+        bool qualified = false;
+        const QString qualifier = qualifierAt(editorWidget->document(), start, &qualified);
+        const QVector<SymbolRef> symbols = SymbolIndex::instance()->resolve(
+                    editorWidget->textDocument()->filePath().toString(), qualifier, name, qualified);
+        if (!symbols.isEmpty()) {
+            setToolTip(toolTipForSymbol(symbols.first()));
+            setPriority(Priority_Tooltip);
+        }
+    }
+    report(priority());
+}
+
+} // namespace Internal
+} // namespace Vcreator
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <texteditor/basehoverhandler.h>
+
+namespace VCreator {
+namespace Internal {
+
+class VlangHoverHandler : public TextEditor::BaseHoverHandler
+{
+private:
+    void identifyMatch(TextEditor::TextEditorWidget *editorWidget,
+                       int pos,
+                       ReportPriority report) override;
+};
+
+} // namespace Internal
+} // namespace Vcreator
@@ -0,0 +1,272 @@
+#include "vcreatorimplementations.h"
+#include "vcreatorsources.h"
+#include "vcreatorusages.h"
+
+#include <coreplugin/editormanager/editormanager.h>
+#include <coreplugin/find/searchresultwindow.h>
+#include <texteditor/textdocument.h>
+#include <texteditor/texteditor.h>
+
+#include <algorithm>
+
+namespace VCreator {
+namespace Internal {
+
+static ImplementationIndex *m_instance = nullptr;
+
+// Types are module scoped, methods can only be declared in the type's module
+static QString typeKey(const QString &directory, QString name)
+{
+    // Generic receivers: fn (s Stack<T>) push()
+    for (int i = 0; i < name.size(); ++i) {
+        if (name.at(i) == QLatin1Char('<') || name.at(i) == QLatin1Char('[')) {
+            name.truncate(i);
+            break;
+        }
+    }
+    return directory + QLatin1Char('|') + name;
+}
+
+static QString typeKey(const SymbolRef &type)
+{
+    return typeKey(type.file->directory, type.symbol().name);
+}
+
+static bool isTypeDeclaration(const Symbol &symbol)
+{
+    switch (symbol.kind) {
+    case Symbol::Struct:
+    case Symbol::Enum:
+    case Symbol::Interface:
+    case Symbol::TypeAlias:
+        return true;
+    default:
+        return false;
+    }
+}
+
+static void decrement(QHash<QString, QHash<QString, int>> &sets,
+                      QHash<QString, QSet<QString>> &byMethod,
+                      const QString &key, const QString &method)
+{
+    auto set = sets.find(key);
+    if (set == sets.end())
+        return;
+    auto count = set->find(method);
+    if (count == set->end() || --count.value() > 0)
+        return;
+    set->erase(count);
+    if (set->isEmpty())
+        sets.erase(set);
+
+    auto owners = byMethod.find(method);
+    if (owners != byMethod.end()) {
+        owners->remove(key);
+        if (owners->isEmpty())
+            byMethod.erase(owners);
+    }
+}
+
+ImplementationIndex::ImplementationIndex()
+{
+    m_instance = this;
+    connect(SymbolIndex::instance(), &SymbolIndex::filesIndexed,
+            this, &ImplementationIndex::updateFiles);
+    connect(SymbolIndex::instance(), &SymbolIndex::filesRemoved, this, [this](const QStringList &files) {
+        for (const QString &file : files)
+            removeFile(file);
+    });
+}
+
+ImplementationIndex::~ImplementationIndex()
+{
+    m_instance = nullptr;
+}
+
+ImplementationIndex *ImplementationIndex::instance()
+{
+    return m_instance;
+}
+
+void ImplementationIndex::updateFiles(const QStringList &files)
+{
+    for (const QString &filePath : files) {
+        removeFile(filePath);
+        if (const FileIndexPtr file = SymbolIndex::instance()->file(filePath))
+            addFile(file);
+    }
+}
+
+void ImplementationIndex::addFile(const FileIndexPtr &file)
+{
+    // Interface methods are indexed as members of the interface
+    QSet<QString> interfaces;
+    for (const Symbol &symbol : file->symbols) {
+        if (symbol.kind == Symbol::Interface)
+            interfaces.insert(symbol.name);
+    }
+
+    FileEntry &entry = m_files[file->filePath];
+    for (int i = 0; i < file->symbols.size(); ++i) {
+        const Symbol &symbol = file->symbols.at(i);
+        if (isTypeDeclaration(symbol)) {
+            const QString key = typeKey(file->directory, symbol.name);
+            m_declarations.insert(key, SymbolRef{file, i});
+            entry.declarations.append(key);
+            continue;
+        }
+        if (symbol.kind != Symbol::Method)
+            continue;
+
+        const QString key = typeKey(file->directory, symbol.receiver);
+        if (interfaces.contains(symbol.receiver)) {
+            ++m_interfaceMethods[key][symbol.name];
+            m_interfacesByMethod[symbol.name].insert(key);
+            entry.requirements.append({key, symbol.name});
+        } else {
+            ++m_methodSets[key][symbol.name];
+            m_typesByMethod[symbol.name].insert(key);
+            entry.methods.append({key, symbol.name});
+        }
+    }
+}
+
+void ImplementationIndex::removeFile(const QString &filePath)
+{
+    const FileEntry entry = m_files.take(filePath);
+    for (const QPair<QString, QString> &method : entry.methods)
+        decrement(m_methodSets, m_typesByMethod, method.first, method.second);
+    for (const QPair<QString, QString> &requirement : entry.requirements)
+        decrement(m_interfaceMethods, m_interfacesByMethod, requirement.first, requirement.second);
+    for (const QString &key : entry.declarations) {
+        const auto declaration = m_declarations.constFind(key);
+        if (declaration != m_declarations.constEnd() && declaration->file->filePath == filePath)
+            m_declarations.erase(declaration);
+    }
+}
+
+QVector<SymbolRef> ImplementationIndex::implementations(const SymbolRef &interfaceType) const
+{
+    QVector<SymbolRef> result;
+    const QStringList methods = m_interfaceMethods.value(typeKey(interfaceType)).keys();
+    if (methods.isEmpty()) {
+        // Every type implements the empty interfaceType
+        for (const SymbolRef &declaration : m_declarations) {
+            if (declaration.symbol().kind != Symbol::Interface)
+                result.append(declaration);
+        }
+        return result;
+    }
+
+    // Intersect starting with the rarest method, the candidates only shrink
+    QVector<const QSet<QString> *> owners;
+    for (const QString &method : methods) {
+        const auto types = m_typesByMethod.constFind(method);
+        if (types == m_typesByMethod.constEnd())
+            return result;
+        owners.append(&types.value());
+    }
+    std::sort(owners.begin(), owners.end(), [](const QSet<QString> *a, const QSet<QString> *b) {
+        return a->size() < b->size();
+    });
+    QSet<QString> types = *owners.first();
+    for (int i = 1; i < owners.size() && !types.isEmpty(); ++i)
+        types.intersect(*owners.at(i));
+
+    for (const QString &type : qAsConst(types)) {
+        const auto declaration = m_declarations.constFind(type);
+        if (declaration != m_declarations.constEnd())
+            result.append(*declaration);
+    }
+    return result;
+}
+
+QVector<SymbolRef> ImplementationIndex::implementedInterfaces(const SymbolRef &type) const
+{
+    QVector<SymbolRef> result;
+    const QHash<QString, int> methods = m_methodSets.value(typeKey(type));
+
+    // Only interfaces asking for one of the type's methods can match
+    QSet<QString> candidates;
+    for (auto method = methods.cbegin(); method != methods.cend(); ++method)
+        candidates.unite(m_interfacesByMethod.value(method.key()));
+
+    for (const QString &interfaceType : qAsConst(candidates)) {
+        const QHash<QString, int> required = m_interfaceMethods.value(interfaceType);
+        const bool implemented = std::all_of(required.keyBegin(), required.keyEnd(),
+                                             [&methods](const QString &method) {
+            return methods.contains(method);
+        });
+        const auto declaration = m_declarations.constFind(interfaceType);
+        if (implemented && declaration != m_declarations.constEnd())
+            result.append(*declaration);
+    }
+    return result;
+}
+
+static SymbolRef typeUnderCursor(TextEditor::TextEditorWidget *editor)
+{
+    int start = -1;
+    const QString name = identifierUnderCursor(editor->textCursor(), &start);
+    if (name.isEmpty())
+        return SymbolRef();
+
+    bool qualified = false;
+    const QString qualifier = qualifierAt(editor->document(), start, &qualified);
+    const QVector<SymbolRef> symbols = SymbolIndex::instance()->resolve(
+                editor->textDocument()->filePath().toString(), qualifier, name, qualified);
+    for (const SymbolRef &symbol : symbols) {
+        if (isTypeDeclaration(symbol.symbol()))
+            return symbol;
+    }
+    return SymbolRef();
+}
+
+static void showTypes(const QString &label, const QString &name, QVector<SymbolRef> types)
+{
+    std::sort(types.begin(), types.end(), [](const SymbolRef &a, const SymbolRef &b) {
+        return a.symbol().name < b.symbol().name;
+    });
+
+    Core::SearchResult *search = Core::SearchResultWindow::instance()->startNewSearch(
+                label, QString(), name, Core::SearchResultWindow::SearchOnly,
+                Core::SearchResultWindow::PreserveCaseDisabled);
+    QObject::connect(search, &Core::SearchResult::activated, [](const Core::SearchResultItem &item) {
+        Core::EditorManager::openEditorAtSearchResult(item);
+    });
+
+    QHash<QString, QStringList> lines;
+    for (const SymbolRef &type : qAsConst(types)) {
+        const QString &filePath = type.file->filePath;
+        auto fileLines = lines.find(filePath);
+        if (fileLines == lines.end())
+            fileLines = lines.insert(filePath, readSourceFile(filePath).split(QLatin1Char('\n')));
+        const Symbol &symbol = type.symbol();
+        search->addResult(filePath, symbol.line, fileLines->value(symbol.line - 1),
+                          symbol.column, symbol.name.size());
+    }
+    search->finishSearch(false);
+    Core::SearchResultWindow::instance()->popup(Core::IOutputPane::ModeSwitch
+                                                | Core::IOutputPane::WithFocus);
+}
+
+void ImplementationIndex::findImplementations(TextEditor::TextEditorWidget *editor)
+{
+    const SymbolRef interfaceType = typeUnderCursor(editor);
+    if (!interfaceType.file || interfaceType.symbol().kind != Symbol::Interface)
+        return;
+    showTypes(tr("V Implementations:"), interfaceType.symbol().name,
+              instance()->implementations(interfaceType));
+}
+
+void ImplementationIndex::findImplementedInterfaces(TextEditor::TextEditorWidget *editor)
+{
+    const SymbolRef type = typeUnderCursor(editor);
+    if (!type.file || type.symbol().kind == Symbol::Interface)
+        return;
+    showTypes(tr("V Implemented Interfaces:"), type.symbol().name,
+              instance()->implementedInterfaces(type));
+}
+
+} // namespace Internal
+} // namespace Vcreator
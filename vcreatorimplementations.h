@@ -0,0 +1,62 @@
+#pragma once
+
+#include "vcreatorsymbolindex.h"
+
+#include <QHash>
+#include <QObject>
+#include <QSet>
+
+namespace TextEditor { class TextEditorWidget; }
+
+namespace VCreator {
+namespace Internal {
+
+// Method sets of all indexed types and the methods every interface asks
+// for, kept up to date file by file from the symbol index. V types satisfy
+// interfaces implicitly, so both directions are set queries: the types
+// implementing an interface are the intersection of the types having each
+// of its methods. Only method names are compared, not their signatures,
+// interface fields and embedded interfaces are not considered.
+class ImplementationIndex : public QObject
+{
+    Q_OBJECT
+
+public:
+    ImplementationIndex();
+    ~ImplementationIndex() override;
+
+    static ImplementationIndex *instance();
+
+    // Declarations of the types implementing interfaceType, which must be an
+    // interface declaration from the symbol index
+    QVector<SymbolRef> implementations(const SymbolRef &interfaceType) const;
+    // Declarations of the non-empty interfaces type implements
+    QVector<SymbolRef> implementedInterfaces(const SymbolRef &type) const;
+
+    static void findImplementations(TextEditor::TextEditorWidget *editor);
+    static void findImplementedInterfaces(TextEditor::TextEditorWidget *editor);
+
+private:
+    struct FileEntry
+    {
+        QVector<QPair<QString, QString>> methods;       // type key, method
+        QVector<QPair<QString, QString>> requirements;  // interface key, method
+        QStringList declarations;
+    };
+
+    void updateFiles(const QStringList &files);
+    void addFile(const FileIndexPtr &file);
+    void removeFile(const QString &filePath);
+
+    QHash<QString, FileEntry> m_files;
+    QHash<QString, SymbolRef> m_declarations;
+    // type -> method -> number of declarations, methods may be redeclared
+    // in another file while the first one is not reindexed yet
+    QHash<QString, QHash<QString, int>> m_methodSets;
+    QHash<QString, QHash<QString, int>> m_interfaceMethods;
+    QHash<QString, QSet<QString>> m_typesByMethod;
+    QHash<QString, QSet<QString>> m_interfacesByMethod;
+};
+
+} // namespace Internal
+} // namespace Vcreator
@@ -0,0 +1,267 @@
+#include "vcreatorimportgraph.h"
+#include "vcreatorsymbolindex.h"
+
+#include <utils/runextensions.h>
+
+#include <QFileInfo>
+#include <QFutureWatcher>
+#include <QtConcurrent>
+
+#include <algorithm>
+#include <functional>
+
+namespace VCreator {
+namespace Internal {
+
+static ImportGraph *m_instance = nullptr;
+
+static QVector<ImportEdge> resolveImports(const FileIndexPtr &file)
+{
+    const SymbolIndex *index = SymbolIndex::instance();
+    QVector<ImportEdge> edges;
+    for (const Import &import : file->imports) {
+        ImportEdge edge;
+        edge.file = file->filePath;
+        edge.importPath = import.path;
+        edge.alias = import.alias;
+        edge.line = import.line;
+        edge.target = index->resolveImport(file->filePath, import.path);
+        // import os { join_path } is used through either name
+        edge.unused = !file->qualifiers.contains(import.alias)
+                && std::none_of(import.symbols.cbegin(), import.symbols.cend(),
+                                [&file](const QString &symbol) {
+                                    return file->usedSymbols.contains(symbol);
+                                });
+        edges.append(edge);
+    }
+    return edges;
+}
+
+static void resolveFiles(QFutureInterface<QVector<ImportEdge>> &futureInterface,
+                         const QVector<FileIndexPtr> &files)
+{
+    const QVector<QVector<ImportEdge>> edges
+            = QtConcurrent::blockingMapped<QVector<QVector<ImportEdge>>>(files, resolveImports);
+    QVector<ImportEdge> result;
+    for (const QVector<ImportEdge> &fileEdges : edges)
+        result += fileEdges;
+    futureInterface.reportResult(result);
+}
+
+ImportGraph::ImportGraph()
+{
+    m_instance = this;
+    m_futureSynchronizer.setCancelOnWait(true);
+
+    m_changedTimer.setSingleShot(true);
+    m_changedTimer.setInterval(100);
+    connect(&m_changedTimer, &QTimer::timeout, this, &ImportGraph::graphChanged);
+
+    connect(SymbolIndex::instance(), &SymbolIndex::filesIndexed, this, &ImportGraph::update);
+    connect(SymbolIndex::instance(), &SymbolIndex::filesRemoved, this, [this](const QStringList &files) {
+        for (const QString &file : files) {
+            m_generations.remove(file);
+            removeFile(file);
+        }
+        m_cyclesValid = false;
+        m_changedTimer.start();
+    });
+}
+
+ImportGraph::~ImportGraph()
+{
+    m_futureSynchronizer.waitForFinished();
+    m_instance = nullptr;
+}
+
+ImportGraph *ImportGraph::instance()
+{
+    return m_instance;
+}
+
+void ImportGraph::update(const QStringList &files)
+{
+    QVector<FileIndexPtr> indexed;
+    for (const QString &file : files) {
+        if (const FileIndexPtr fileIndex = SymbolIndex::instance()->file(file))
+            indexed.append(fileIndex);
+    }
+
+    const int generation = ++m_generation;
+    for (const QString &file : files)
+        m_generations.insert(file, generation);
+
+    const QFuture<QVector<ImportEdge>> future = Utils::runAsync(resolveFiles, indexed);
+    m_futureSynchronizer.addFuture(future);
+
+    auto watcher = new QFutureWatcher<QVector<ImportEdge>>(this);
+    connect(watcher, &QFutureWatcherBase::finished, this, [this, watcher, files, generation] {
+        if (!watcher->isCanceled() && watcher->future().resultCount() > 0)
+            apply(watcher->result(), files, generation);
+        watcher->deleteLater();
+    });
+    watcher->setFuture(future);
+}
+
+void ImportGraph::apply(const QVector<ImportEdge> &edges, const QStringList &files, int generation)
+{
+    // A run started later may finish first, its edges must not be replaced
+    QSet<QString> current;
+    for (const QString &file : files) {
+        if (m_generations.value(file) == generation)
+            current.insert(file);
+    }
+    if (current.isEmpty())
+        return;
+
+    for (const QString &file : qAsConst(current))
+        removeFile(file);
+
+    for (const QString &file : qAsConst(current)) {
+        const QString module = QFileInfo(file).absolutePath();
+        ++m_moduleFileCount[module];
+        m_fileImports.insert(file, {});
+    }
+
+    for (const ImportEdge &edge : edges) {
+        if (!current.contains(edge.file))
+            continue;
+        m_fileImports[edge.file].append(edge);
+        if (edge.target.isEmpty())
+            continue;
+        const QString module = QFileInfo(edge.file).absolutePath();
+        m_importers[edge.target].insert(edge.file);
+        ++m_moduleImports[module][edge.target];
+        ++m_moduleImporters[edge.target][module];
+    }
+
+    m_cyclesValid = false;
+    m_changedTimer.start();
+}
+
+void ImportGraph::removeFile(const QString &file)
+{
+    const auto it = m_fileImports.find(file);
+    if (it == m_fileImports.end())
+        return;
+
+    const QString module = QFileInfo(file).absolutePath();
+    const auto decrement = [](QHash<QString, QHash<QString, int>> &hash,
+                              const QString &outer, const QString &inner) {
+        auto counts = hash.find(outer);
+        if (counts == hash.end())
+            return;
+        if (--(*counts)[inner] <= 0)
+            counts->remove(inner);
+        if (counts->isEmpty())
+            hash.erase(counts);
+    };
+
+    for (const ImportEdge &edge : qAsConst(*it)) {
+        if (edge.target.isEmpty())
+            continue;
+        auto importers = m_importers.find(edge.target);
+        if (importers != m_importers.end()) {
+            importers->remove(file);
+            if (importers->isEmpty())
+                m_importers.erase(importers);
+        }
+        decrement(m_moduleImports, module, edge.target);
+        decrement(m_moduleImporters, edge.target, module);
+    }
+    m_fileImports.erase(it);
+
+    if (--m_moduleFileCount[module] <= 0)
+        m_moduleFileCount.remove(module);
+}
+
+QVector<ImportEdge> ImportGraph::imports(const QString &file) const
+{
+    return m_fileImports.value(file);
+}
+
+QStringList ImportGraph::importedModules(const QString &moduleDirectory) const
+{
+    return m_moduleImports.value(moduleDirectory).keys();
+}
+
+QSet<QString> ImportGraph::importingFiles(const QString &moduleDirectory) const
+{
+    return m_importers.value(moduleDirectory);
+}
+
+QStringList ImportGraph::importingModules(const QString &moduleDirectory) const
+{
+    return m_moduleImporters.value(moduleDirectory).keys();
+}
+
+QStringList ImportGraph::modules() const
+{
+    return m_moduleFileCount.keys();
+}
+
+QVector<QStringList> ImportGraph::cycles() const
+{
+    if (m_cyclesValid)
+        return m_cycles;
+
+    // Tarjan's strongly connected components over the module graph
+    struct State { int index = -1; int lowLink = 0; bool onStack = false; };
+    QHash<QString, State> states;
+    QStringList stack;
+    int nextIndex = 0;
+    m_cycles.clear();
+
+    std::function<void(const QString &)> connect = [&](const QString &module) {
+        State &state = states[module];
+        state.index = state.lowLink = nextIndex++;
+        state.onStack = true;
+        stack.append(module);
+
+        const QHash<QString, int> targets = m_moduleImports.value(module);
+        for (auto it = targets.cbegin(); it != targets.cend(); ++it) {
+            const QString &target = it.key();
+            if (states.value(target).index == -1) {
+                connect(target);
+                states[module].lowLink = qMin(states[module].lowLink, states[target].lowLink);
+            } else if (states[target].onStack) {
+                states[module].lowLink = qMin(states[module].lowLink, states[target].index);
+            }
+        }
+
+        if (states[module].lowLink == states[module].index) {
+            QStringList component;
+            QString member;
+            do {
+                member = stack.takeLast();
+                states[member].onStack = false;
+                component.append(member);
+            } while (member != module);
+            if (component.size() > 1 || m_moduleImports.value(module).contains(module))
+                m_cycles.append(component);
+        }
+    };
+
+    for (auto it = m_moduleImports.cbegin(); it != m_moduleImports.cend(); ++it) {
+        if (states.value(it.key()).index == -1)
+            connect(it.key());
+    }
+
+    m_cyclesValid = true;
+    return m_cycles;
+}
+
+QVector<ImportEdge> ImportGraph::unusedImports() const
+{
+    QVector<ImportEdge> result;
+    for (const QVector<ImportEdge> &edges : m_fileImports) {
+        for (const ImportEdge &edge : edges) {
+            if (edge.unused)
+                result.append(edge);
+        }
+    }
+    return result;
+}
+
+} // namespace Internal
+} // namespace Vcreator
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "vcreatorindexer.h"
+
+#include <utils/futuresynchronizer.h>
+
+#include <QHash>
+#include <QObject>
+#include <QSet>
+#include <QTimer>
+
+namespace VCreator {
+namespace Internal {
+
+struct ImportEdge
+{
+    QString file;
+    QString importPath;
+    QString alias;
+    QString target; // module directory, empty when unresolved
+    int line = 0;
+    bool unused = false;
+};
+
+// Module level import graph of the indexed V files. Modules are keyed by
+// directory. Imports are resolved on worker threads whenever files are
+// (re)indexed, only the edges of those files are replaced.
+// Queries are answered from hashes and must be made on the GUI thread.
+class ImportGraph : public QObject
+{
+    Q_OBJECT
+
+public:
+    ImportGraph();
+    ~ImportGraph() override;
+
+    static ImportGraph *instance();
+
+    QVector<ImportEdge> imports(const QString &file) const;
+    QStringList importedModules(const QString &moduleDirectory) const;
+    QSet<QString> importingFiles(const QString &moduleDirectory) const;
+    QStringList importingModules(const QString &moduleDirectory) const;
+    QStringList modules() const;
+
+    // Strongly connected groups of modules importing each other.
+    QVector<QStringList> cycles() const;
+    QVector<ImportEdge> unusedImports() const;
+
+signals:
+    void graphChanged();
+
+private:
+    void update(const QStringList &files);
+    void apply(const QVector<ImportEdge> &edges, const QStringList &files, int generation);
+    void removeFile(const QString &file);
+
+    QHash<QString, QVector<ImportEdge>> m_fileImports;
+    QHash<QString, QSet<QString>> m_importers;                 // target -> files
+    QHash<QString, QHash<QString, int>> m_moduleImports;      // module -> target -> count
+    QHash<QString, QHash<QString, int>> m_moduleImporters;    // target -> module -> count
+    QHash<QString, int> m_moduleFileCount;
+
+    // Results of an update only count for files no newer update was started for
+    int m_generation = 0;
+    QHash<QString, int> m_generations;
+
+    mutable bool m_cyclesValid = false;
+    mutable QVector<QStringList> m_cycles;
+
+    QTimer m_changedTimer;
+    Utils::FutureSynchronizer m_futureSynchronizer;
+};
+
+} // namespace Internal
+} // namespace Vcreator
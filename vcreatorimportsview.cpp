@@ -0,0 +1,228 @@
+#include "vcreatorimportsview.h"
+#include "vcreatorimportgraph.h"
+#include "vcreatorplugin.h"
+#include "vcreatorsources.h"
+
+#include <projectexplorer/project.h>
+#include <projectexplorer/session.h>
+#include <utils/algorithm.h>
+#include <utils/utilsicons.h>
+
+#include <QDir>
+#include <QFileInfo>
+#include <QHeaderView>
+#include <QScrollBar>
+#include <QTreeWidget>
+#include <QTreeWidgetItemIterator>
+#include <QVBoxLayout>
+
+#include <algorithm>
+
+namespace VCreator {
+namespace Internal {
+
+enum ItemRole {
+    FileRole = Qt::UserRole,
+    LineRole
+};
+
+class ImportsWidget : public QWidget
+{
+    Q_DECLARE_TR_FUNCTIONS(VCreator::Internal::ImportsWidget)
+
+public:
+    explicit ImportsWidget(QWidget *parent = nullptr);
+
+private:
+    void rebuild();
+    void saveState();
+    void restoreState(QTreeWidgetItem *item, const QString &parentPath);
+    QString displayName(const QString &moduleDirectory) const;
+    QTreeWidgetItem *addEdge(QTreeWidgetItem *parent, const ImportEdge &edge);
+
+    QTreeWidget *m_tree;
+    QStringList m_projectDirectories;
+
+    // Items are identified by their texts from the top level down
+    QHash<QString, bool> m_expanded;
+    QString m_currentPath;
+};
+
+static QString itemPath(const QTreeWidgetItem *item)
+{
+    QString path = item->text(0);
+    for (const QTreeWidgetItem *parent = item->parent(); parent; parent = parent->parent())
+        path.prepend(parent->text(0) + QLatin1Char('\n'));
+    return path;
+}
+
+ImportsWidget::ImportsWidget(QWidget *parent)
+    : QWidget(parent)
+    , m_tree(new QTreeWidget(this))
+{
+    m_tree->setHeaderHidden(true);
+    m_tree->setFrameStyle(QFrame::NoFrame);
+    m_tree->setUniformRowHeights(true);
+
+    auto layout = new QVBoxLayout(this);
+    layout->setContentsMargins(0, 0, 0, 0);
+    layout->addWidget(m_tree);
+
+    connect(m_tree, &QTreeWidget::itemActivated, this, [](QTreeWidgetItem *item) {
+        const QString file = item->data(0, FileRole).toString();
+        if (!file.isEmpty())
+            openEditorAt(file, item->data(0, LineRole).toInt());
+    });
+    connect(ImportGraph::instance(), &ImportGraph::graphChanged, this, &ImportsWidget::rebuild);
+
+    rebuild();
+}
+
+QString ImportsWidget::displayName(const QString &moduleDirectory) const
+{
+    for (const QString &projectDirectory : m_projectDirectories) {
+        if (moduleDirectory == projectDirectory)
+            return QFileInfo(projectDirectory).fileName();
+        if (moduleDirectory.startsWith(projectDirectory + QLatin1Char('/')))
+            return QDir(projectDirectory).relativeFilePath(moduleDirectory).replace(QLatin1Char('/'), QLatin1Char('.'));
+    }
+    return QDir::toNativeSeparators(moduleDirectory);
+}
+
+QTreeWidgetItem *ImportsWidget::addEdge(QTreeWidgetItem *parent, const ImportEdge &edge)
+{
+    auto item = new QTreeWidgetItem(parent);
+    QString text = edge.importPath;
+    if (edge.alias != edge.importPath.mid(edge.importPath.lastIndexOf(QLatin1Char('.')) + 1))
+        text += tr(" as %1").arg(edge.alias);
+    item->setText(0, tr("%1 (%2:%3)").arg(text, QFileInfo(edge.file).fileName()).arg(edge.line));
+    item->setToolTip(0, edge.target.isEmpty() ? tr("Module not found")
+                                              : QDir::toNativeSeparators(edge.target));
+    item->setData(0, FileRole, edge.file);
+    item->setData(0, LineRole, edge.line);
+    if (edge.unused || edge.target.isEmpty())
+        item->setIcon(0, Utils::Icons::WARNING.icon());
+    return item;
+}
+
+void ImportsWidget::rebuild()
+{
+    const ImportGraph *graph = ImportGraph::instance();
+
+    m_projectDirectories.clear();
+    const QList<ProjectExplorer::Project *> projects = ProjectExplorer::SessionManager::projects();
+    for (const ProjectExplorer::Project *project : projects)
+        m_projectDirectories.append(project->projectDirectory().toString());
+
+    const auto isProjectModule = [this](const QString &module) {
+        for (const QString &directory : qAsConst(m_projectDirectories)) {
+            if (module == directory || module.startsWith(directory + QLatin1Char('/')))
+                return true;
+        }
+        return false;
+    };
+
+    saveState();
+    const int scrollPosition = m_tree->verticalScrollBar()->value();
+    m_tree->clear();
+
+    const QVector<QStringList> cycles = graph->cycles();
+    if (!cycles.isEmpty()) {
+        auto cyclesItem = new QTreeWidgetItem(m_tree, {tr("Import Cycles")});
+        cyclesItem->setIcon(0, Utils::Icons::CRITICAL.icon());
+        for (const QStringList &cycle : cycles) {
+            QStringList names;
+            for (const QString &module : cycle)
+                names.append(displayName(module));
+            names.append(names.first());
+            new QTreeWidgetItem(cyclesItem, {names.join(QLatin1String(" → "))});
+        }
+        cyclesItem->setExpanded(true);
+    }
+
+    const QVector<ImportEdge> unused = graph->unusedImports();
+    QHash<QString, QVector<ImportEdge>> unusedByModule;
+    for (const ImportEdge &edge : unused)
+        unusedByModule[QFileInfo(edge.file).absolutePath()].append(edge);
+
+    QStringList modules = Utils::filtered(graph->modules(), isProjectModule);
+    std::sort(modules.begin(), modules.end(), [this](const QString &a, const QString &b) {
+        return displayName(a) < displayName(b);
+    });
+
+    for (const QString &module : qAsConst(modules)) {
+        auto moduleItem = new QTreeWidgetItem(m_tree, {displayName(module)});
+        moduleItem->setToolTip(0, QDir::toNativeSeparators(module));
+
+        const QStringList imported = graph->importedModules(module);
+        if (!imported.isEmpty()) {
+            auto importsItem = new QTreeWidgetItem(moduleItem, {tr("Imports")});
+            for (const QString &target : imported)
+                new QTreeWidgetItem(importsItem, {displayName(target)});
+        }
+
+        const QStringList importers = graph->importingModules(module);
+        if (!importers.isEmpty()) {
+            auto importersItem = new QTreeWidgetItem(moduleItem, {tr("Imported By")});
+            for (const QString &importer : importers)
+                new QTreeWidgetItem(importersItem, {displayName(importer)});
+        }
+
+        const QVector<ImportEdge> moduleUnused = unusedByModule.value(module);
+        if (!moduleUnused.isEmpty()) {
+            auto unusedItem = new QTreeWidgetItem(moduleItem, {tr("Unused Imports")});
+            unusedItem->setIcon(0, Utils::Icons::WARNING.icon());
+            for (const ImportEdge &edge : moduleUnused)
+                addEdge(unusedItem, edge);
+            moduleItem->setIcon(0, Utils::Icons::WARNING.icon());
+        }
+    }
+
+    for (int i = 0; i < m_tree->topLevelItemCount(); ++i)
+        restoreState(m_tree->topLevelItem(i), QString());
+    m_tree->verticalScrollBar()->setValue(scrollPosition);
+}
+
+// The tree is rebuilt whenever the graph changes, the expanded items and
+// the current one are carried over to the new items with the same texts
+void ImportsWidget::saveState()
+{
+    const QTreeWidgetItem *current = m_tree->currentItem();
+    m_currentPath = current ? itemPath(current) : QString();
+    m_expanded.clear();
+    for (QTreeWidgetItemIterator it(m_tree); *it; ++it) {
+        if ((*it)->childCount() > 0)
+            m_expanded.insert(itemPath(*it), (*it)->isExpanded());
+    }
+}
+
+void ImportsWidget::restoreState(QTreeWidgetItem *item, const QString &parentPath)
+{
+    const QString path = parentPath.isEmpty() ? item->text(0)
+                                              : parentPath + QLatin1Char('\n') + item->text(0);
+    const auto expanded = m_expanded.constFind(path);
+    if (expanded != m_expanded.constEnd())
+        item->setExpanded(*expanded);
+    if (path == m_currentPath)
+        m_tree->setCurrentItem(item);
+    for (int i = 0; i < item->childCount(); ++i)
+        restoreState(item->child(i), path);
+}
+
+ImportsViewFactory::ImportsViewFactory()
+{
+    setDisplayName(tr("V Imports"));
+    setPriority(450);
+    setId("Vcreator.ImportsView");
+}
+
+Core::NavigationView ImportsViewFactory::createWidget()
+{
+    Plugin::ensureLanguageSupport();
+    Core::NavigationView view;
+    view.widget = new ImportsWidget;
+    return view;
+}
+
+} // namespace Internal
+} // namespace Vcreator
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <coreplugin/inavigationwidgetfactory.h>
+
+namespace VCreator {
+namespace Internal {
+
+class ImportsViewFactory : public Core::INavigationWidgetFactory
+{
+    Q_OBJECT
+
+public:
+    ImportsViewFactory();
+
+    Core::NavigationView createWidget() override;
+};
+
+} // namespace Internal
+} // namespace Vcreator
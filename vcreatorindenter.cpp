@@ -5,7 +5,10 @@
 #include <texteditor/icodestylepreferences.h>
 #include <texteditor/tabsettings.h>
 #include <texteditor/simplecodestylepreferences.h>
-#include <texteditor/tabsettings.h>
+
+#include <QTextCursor>
+#include <QTextDocument>
+
 namespace VCreator {
 namespace Internal {
 
@@ -16,64 +19,145 @@ VlangIndenter::VlangIndenter(QTextDocument *doc) : TextEditor::TextIndenter(doc)
 
 bool VlangIndenter::isElectricCharacter(const QChar &ch) const
 {
-    return ch == '{';
+    return ch == '}' || ch == ')' || ch == ']';
 }
 
 void VlangIndenter::indentBlock(const QTextBlock &block, const QChar &typedChar, const TextEditor::TabSettings &settings, int cursorPositionInEditor)
 {
-    const QString currentLine = block.text();
+    Q_UNUSED(typedChar)
+    Q_UNUSED(cursorPositionInEditor)
 
-    const QTextBlock previousBlock = block.previous();
-    const QString previousLine = previousBlock.text();
-    const int previousState = previousBlock.userState();
+    const int indentation = indentationFor(block, settings);
+    if (indentation >= 0)
+        settings.indentLine(block, indentation);
+}
 
-    if (!previousBlock.isValid()) {
-        settings.indentLine(block, 0);
-        return;
-    }
+void VlangIndenter::indent(const QTextCursor &cursor, const QChar &typedChar, const TextEditor::TabSettings &tabSettings, int cursorPositionInEditor)
+{
+    if (cursor.hasSelection())
+        indentRange(cursor, tabSettings);
+    else
+        indentBlock(cursor.block(), typedChar, tabSettings, cursorPositionInEditor);
+}
+
+void VlangIndenter::reindent(const QTextCursor &cursor, const TextEditor::TabSettings &tabSettings, int cursorPositionInEditor)
+{
+    indent(cursor, QChar::Null, tabSettings, cursorPositionInEditor);
+}
 
-    // Calculate indentation
-    int indentation = 0;
-    if (rightTrimmed(currentLine).isEmpty()) {
-        // Current line is empty so we calculate indentation based on previous line
-        const int indentationDiff = calculateIndentationDiff(previousLine, previousState, settings.m_indentSize);
-        indentation = settings.indentationColumn(previousLine) + indentationDiff;
+// Each line only looks at lines above it, which are already reindented by
+// the time it is reached, so the whole range is a single pass. The
+// highlighter only catches up after the edit block, so nothing used here
+// may depend on positions within a line.
+void VlangIndenter::indentRange(const QTextCursor &cursor, const TextEditor::TabSettings &settings)
+{
+    QTextBlock block = m_doc->findBlock(cursor.selectionStart());
+    const QTextBlock end = m_doc->findBlock(cursor.selectionEnd()).next();
+
+    QTextCursor editCursor(m_doc);
+    editCursor.beginEditBlock();
+    for (; block.isValid() && block != end; block = block.next()) {
+        if (isBlank(block))
+            continue;
+        const int indentation = indentationFor(block, settings);
+        if (indentation >= 0)
+            settings.indentLine(block, indentation);
     }
-    else {
-        // We don't change indentation if the line is already indented.
-        // This is safer but sub optimal
-        indentation = settings.indentationColumn(block.text());
+    editCursor.endEditBlock();
+}
+
+int VlangIndenter::indentationFor(const QTextBlock &block, const TextEditor::TabSettings &settings) const
+{
+    if (startsInMultiLineToken(block))
+        return -1;
+
+    QTextBlock previous = block.previous();
+    while (previous.isValid() && isBlank(previous))
+        previous = previous.previous();
+    if (!previous.isValid())
+        return 0;
+
+    // A statement spanning a multi-line string or comment is indented by
+    // its first line
+    QTextBlock statement = previous;
+    while (startsInMultiLineToken(statement) && statement.previous().isValid())
+        statement = statement.previous();
+
+    const int statementDepth = qMax(0, depthAtStart(statement) - leadingClosers(statement));
+    const int opened = depthAtEnd(previous) - statementDepth;
+
+    int indentation = settings.indentationColumn(statement.text());
+    if (opened > 0) {
+        // Several brackets opened on one line, like "foo(fn () {", are
+        // still one level
+        indentation += settings.m_indentSize;
+    } else if (opened < 0) {
+        // The line closed a bracket of an earlier line, as in the last line
+        // of a call spanning lines. Continue at the line that opened it.
+        const int depth = depthAtEnd(previous);
+        indentation = 0;
+        for (QTextBlock b = statement.previous(); b.isValid(); b = b.previous()) {
+            if (isBlank(b) || startsInMultiLineToken(b))
+                continue;
+            if (depthAtStart(b) - leadingClosers(b) <= depth) {
+                indentation = settings.indentationColumn(b.text());
+                break;
+            }
+        }
     }
 
-    // Sets indentation
-    settings.indentLine(block, std::max(0, indentation));
+    if (leadingClosers(block) > 0)
+        indentation -= settings.m_indentSize;
+
+    return qMax(0, indentation);
 }
 
-bool VlangIndenter::startsBlock(const QString &line, int state) const
+bool VlangIndenter::isBlank(const QTextBlock &block)
 {
-    return false;
+    const QString text = block.text();
+    for (const QChar c : text) {
+        if (!c.isSpace())
+            return false;
+    }
+    return true;
 }
 
-bool VlangIndenter::endsBlock(const QString &line, int state) const
+bool VlangIndenter::startsInMultiLineToken(const QTextBlock &block)
 {
-    return false;
+    const QTextBlock previous = block.previous();
+    if (!previous.isValid() || previous.userState() == -1)
+        return false;
+    return (previous.userState() & Scanner::MultiLineMask) != Scanner::Normal;
 }
 
-int VlangIndenter::calculateIndentationDiff(const QString &previousLine, int previousState, int indentSize) const
+// The highlighter stores (bracket depth << 8) | scanner state per block
+int VlangIndenter::depthAtEnd(const QTextBlock &block)
 {
-    return 0;
+    const int state = block.userState();
+    return state == -1 ? 0 : qMax(0, state >> 8);
 }
 
-QString VlangIndenter::rightTrimmed(const QString &str)
+int VlangIndenter::depthAtStart(const QTextBlock &block)
 {
-    int n = str.size() - 1;
-    for (; n >= 0; --n) {
-        if (!str.at(n).isSpace())
-            return str.left(n + 1);
-    }
-    return QString();
+    const QTextBlock previous = block.previous();
+    return previous.isValid() ? depthAtEnd(previous) : 0;
 }
 
+// Number of closing brackets the line starts with, as in "})". Read from
+// the text: the stored parentheses still have their positions from before a
+// reindent. Lines starting inside a string or comment are never asked.
+int VlangIndenter::leadingClosers(const QTextBlock &block)
+{
+    const QString text = block.text();
+    int closers = 0;
+    for (const QChar c : text) {
+        if (c == '}' || c == ')' || c == ']')
+            ++closers;
+        else if (!c.isSpace())
+            break;
+    }
+    return closers;
+}
 
 } // namespace Internal
 } // namespace Vcreator
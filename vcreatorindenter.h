@@ -5,6 +5,10 @@
 namespace VCreator {
 namespace Internal {
 
+// Indents from the state the highlighter stores per block: the scanner state
+// and bracket depth at the end of the block. Apart from the closing brackets
+// a line starts with nothing is rescanned, a line is indented from its
+// predecessor alone.
 class VlangIndenter : public TextEditor::TextIndenter
 {
 public:
@@ -17,15 +21,26 @@ public:
                      const TextEditor::TabSettings &settings,
                      int cursorPositionInEditor = -1) override;
 
-private:
-    bool startsBlock(const QString &line, int state) const;
-    bool endsBlock(const QString &line, int state) const;
+    void indent(const QTextCursor &cursor,
+                const QChar &typedChar,
+                const TextEditor::TabSettings &tabSettings,
+                int cursorPositionInEditor = -1) override;
 
-    int calculateIndentationDiff(const QString &previousLine,
-                                 int previousState,
-                                 int indentSize) const;
+    void reindent(const QTextCursor &cursor,
+                  const TextEditor::TabSettings &tabSettings,
+                  int cursorPositionInEditor = -1) override;
 
-    static QString rightTrimmed(const QString &str);
+private:
+    // Returns -1 for lines whose indentation is content, like the inside
+    // of a multi-line string.
+    int indentationFor(const QTextBlock &block, const TextEditor::TabSettings &settings) const;
+    void indentRange(const QTextCursor &cursor, const TextEditor::TabSettings &settings);
+
+    static bool isBlank(const QTextBlock &block);
+    static bool startsInMultiLineToken(const QTextBlock &block);
+    static int depthAtStart(const QTextBlock &block);
+    static int depthAtEnd(const QTextBlock &block);
+    static int leadingClosers(const QTextBlock &block);
 };
 
 } // namespace Internal
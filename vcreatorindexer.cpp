@@ -0,0 +1,479 @@
+#include "vcreatorindexer.h"
+#include "vcreatorlexer.h"
+
+#include <QFileInfo>
+#include <QHash>
+#include <QRegularExpression>
+#include <QSet>
+
+namespace VCreator {
+namespace Internal {
+
+const Import *FileIndex::importForAlias(const QString &alias) const
+{
+    for (const Import &import : imports) {
+        if (import.alias == alias)
+            return &import;
+    }
+    return nullptr;
+}
+
+namespace {
+
+class Indexer
+{
+public:
+    Indexer(const QString &filePath, const SourceTokens &source);
+
+    FileIndexPtr run();
+
+private:
+    const Token &at(int i) const { return i < m_tokens.size() ? m_tokens.at(i) : m_eof; }
+    QStringView text(int i) const { return m_source.textOf(at(i)); }
+    int line(int i) const { return i < m_lines.size() ? m_lines.at(i) : -1; }
+    bool startsLine(int i) const { return i == 0 || line(i - 1) != line(i); }
+
+    bool isKeyword(int i, QLatin1String keyword) const
+    { return at(i).is(Token::Keyword) && text(i) == keyword; }
+
+    // builtin function names like free or print are valid method and field names
+    bool isName(int i) const
+    { return at(i).is(Token::Identifier) || at(i).is(Token::Function); }
+
+    bool isTypeName(int i) const
+    { return isName(i) || at(i).is(Token::BuiltinType); }
+
+    int skipBalanced(int i) const;
+
+    int parseTopLevel(int i);
+    int parseImport(int i);
+    int parseFunction(int i);
+    int parseTypeDeclaration(int i, Symbol::Kind kind);
+    int parseValues(int i, Symbol::Kind kind);
+    void parseMember(int i);
+    void addCall(int nameToken);
+
+    void collectQualifiers();
+    void addSymbol(int nameToken, Symbol::Kind kind, const QString &receiver = QString());
+    QString docBefore(int line) const;
+    QString signatureAt(int line) const;
+
+    const SourceTokens &m_source;
+    QVector<Token> m_tokens; // without comments
+    QVector<int> m_lines;
+    QHash<int, QString> m_commentLines;
+    QSet<int> m_attributeLines;
+    QSet<int> m_importLines;
+    Token m_eof;
+    QSharedPointer<FileIndex> m_index;
+
+    bool m_public = false;
+    bool m_publicMembers = false;
+    QString m_container;
+    Symbol::Kind m_containerKind = Symbol::Struct;
+    int m_containerDepth = -1;
+    int m_pendingFunction = -1; // declared, body not entered yet
+    int m_function = -1;
+    int m_functionDepth = -1;
+};
+
+Indexer::Indexer(const QString &filePath, const SourceTokens &source)
+    : m_source(source)
+    , m_eof(source.text().length(), 0, Token::EndOfFile)
+    , m_index(new FileIndex)
+{
+    m_index->filePath = filePath;
+    m_index->directory = QFileInfo(filePath).absolutePath();
+
+    const QVector<Token> &tokens = source.tokens();
+    m_tokens.reserve(tokens.size());
+    m_lines.reserve(tokens.size());
+
+    int previousLine = 0;
+    for (const Token &token : tokens) {
+        const int tokenLine = source.lineAt(token.offset);
+        if (token.is(Token::Comment)) {
+            const QStringView comment = source.textOf(token);
+            if (tokenLine != previousLine && comment.startsWith(QLatin1String("//"))) {
+                QString docLine = comment.mid(2).toString();
+                if (docLine.startsWith(QLatin1Char(' ')))
+                    docLine.remove(0, 1);
+                m_commentLines.insert(tokenLine, docLine);
+            }
+        } else {
+            m_tokens.append(token);
+            m_lines.append(tokenLine);
+        }
+        previousLine = tokenLine;
+    }
+}
+
+FileIndexPtr Indexer::run()
+{
+    int depth = 0;
+    int i = 0;
+    while (i < m_tokens.size()) {
+        const Token &token = at(i);
+        if (token.is(Token::LeftBrace)) {
+            if (depth == 0 && m_pendingFunction >= 0) {
+                m_function = m_pendingFunction;
+                m_functionDepth = 1;
+                m_pendingFunction = -1;
+            }
+            ++depth;
+            ++i;
+        } else if (token.is(Token::RightBrace)) {
+            --depth;
+            if (depth <= m_containerDepth) {
+                m_container.clear();
+                m_containerDepth = -1;
+            }
+            if (depth < m_functionDepth) {
+                m_function = -1;
+                m_functionDepth = -1;
+            }
+            ++i;
+        } else if (depth == 0) {
+            i = parseTopLevel(i);
+        } else {
+            if (m_containerDepth >= 0 && depth == m_containerDepth + 1 && startsLine(i))
+                parseMember(i);
+            else if (m_function >= 0 && isName(i) && at(i + 1).is(Token::LeftParenthesis))
+                addCall(i);
+            ++i;
+        }
+    }
+    collectQualifiers();
+    return m_index;
+}
+
+void Indexer::collectQualifiers()
+{
+    static const QRegularExpression interpolated(R"(([A-Za-z_]\w*)\s*\.)");
+    QSet<QString> selective;
+    for (const Import &import : qAsConst(m_index->imports)) {
+        for (const QString &symbol : import.symbols)
+            selective.insert(symbol);
+    }
+    for (int i = 0; i < m_tokens.size(); ++i) {
+        if (m_importLines.contains(line(i)))
+            continue;
+        if (at(i).is(Token::String)) {
+            // '${os.args}' uses os as well
+            const QStringView string = text(i);
+            if (!string.contains(QLatin1Char('$')))
+                continue;
+            QRegularExpressionMatchIterator it = interpolated.globalMatch(string.toString());
+            while (it.hasNext())
+                m_index->qualifiers.insert(it.next().captured(1));
+        } else if (isTypeName(i) && at(i + 1).is(Token::Dot)) {
+            m_index->qualifiers.insert(text(i).toString());
+        } else if (!selective.isEmpty() && isTypeName(i)
+                   && (i == 0 || !at(i - 1).is(Token::Dot))) {
+            // Interpolated uses of selectively imported names are missed
+            const QString name = text(i).toString();
+            if (selective.contains(name))
+                m_index->usedSymbols.insert(name);
+        }
+    }
+}
+
+int Indexer::skipBalanced(int i) const
+{
+    const Token::Kind open = at(i).kind;
+    const Token::Kind close = open == Token::LeftParenthesis ? Token::RightParenthesis
+                            : open == Token::LeftBracket ? Token::RightBracket
+                                                         : Token::RightBrace;
+    int depth = 0;
+    for (; i < m_tokens.size(); ++i) {
+        if (at(i).is(open)) {
+            ++depth;
+        } else if (at(i).is(close)) {
+            if (--depth == 0)
+                return i + 1;
+        }
+    }
+    return i;
+}
+
+int Indexer::parseTopLevel(int i)
+{
+    if (isKeyword(i, QLatin1String("pub"))) {
+        m_public = true;
+        return i + 1;
+    }
+    if (at(i).is(Token::LeftBracket) && startsLine(i)) {
+        // attribute like [inline] between the doc comment and the declaration
+        m_attributeLines.insert(line(i));
+        return skipBalanced(i);
+    }
+
+    if (at(i).is(Token::Keyword)) {
+        const QStringView keyword = text(i);
+        if (keyword == QLatin1String("module") && isName(i + 1)) {
+            m_index->module = text(i + 1).toString();
+            return i + 2;
+        }
+        if (keyword == QLatin1String("import"))
+            return parseImport(i);
+        if (keyword == QLatin1String("fn"))
+            return parseFunction(i);
+        if (keyword == QLatin1String("struct") || keyword == QLatin1String("union"))
+            return parseTypeDeclaration(i, Symbol::Struct);
+        if (keyword == QLatin1String("enum"))
+            return parseTypeDeclaration(i, Symbol::Enum);
+        if (keyword == QLatin1String("interface"))
+            return parseTypeDeclaration(i, Symbol::Interface);
+        if (keyword == QLatin1String("type"))
+            return parseTypeDeclaration(i, Symbol::TypeAlias);
+        if (keyword == QLatin1String("const"))
+            return parseValues(i, Symbol::Constant);
+        if (keyword == QLatin1String("__global"))
+            return parseValues(i, Symbol::Global);
+    }
+
+    m_public = false;
+    return i + 1;
+}
+
+int Indexer::parseImport(int i)
+{
+    Import import;
+    import.line = line(i);
+    m_importLines.insert(import.line);
+
+    int j = i + 1;
+    while (isTypeName(j)) {
+        if (!import.path.isEmpty())
+            import.path.append(QLatin1Char('.'));
+        import.alias = text(j).toString();
+        import.path.append(import.alias);
+        if (!at(j + 1).is(Token::Dot))
+            break;
+        j += 2;
+    }
+    ++j;
+
+    if (isKeyword(j, QLatin1String("as")) && isName(j + 1)) {
+        import.alias = text(j + 1).toString();
+        j += 2;
+    }
+
+    if (at(j).is(Token::LeftBrace)) {
+        const int end = skipBalanced(j);
+        for (int k = j + 1; k < end - 1; ++k) {
+            if (isTypeName(k))
+                import.symbols.append(text(k).toString());
+        }
+        j = end;
+    }
+
+    if (!import.path.isEmpty())
+        m_index->imports.append(import);
+    return j;
+}
+
+int Indexer::parseFunction(int i)
+{
+    int j = i + 1;
+    QString receiver;
+    if (at(j).is(Token::LeftParenthesis)) {
+        // fn (mut r Foo) name(): the type is the second name in the receiver
+        const int end = skipBalanced(j);
+        int names = 0;
+        for (int k = j + 1; k < end - 1; ++k) {
+            if (isTypeName(k) && ++names == 2) {
+                receiver = text(k).toString();
+                break;
+            }
+        }
+        j = end;
+    }
+
+    // operator overloads and C/JS declarations like fn C.puts() are skipped
+    if (!isName(j) || at(j + 1).is(Token::Dot)) {
+        m_public = false;
+        return j;
+    }
+
+    addSymbol(j, receiver.isEmpty() ? Symbol::Function : Symbol::Method, receiver);
+    const int function = m_index->symbols.size() - 1;
+
+    // Skip the signature up to the body, parameters hold keywords like mut,
+    // shared or fn types that are no declarations
+    int k = j + 1;
+    while (k < m_tokens.size()) {
+        if (at(k).is(Token::LeftBrace)) {
+            m_pendingFunction = function;
+            return k;
+        }
+        if (at(k).is(Token::LeftParenthesis) || at(k).is(Token::LeftBracket))
+            k = skipBalanced(k);
+        else if (startsLine(k) || at(k).is(Token::RightBrace))
+            break; // declared without a body
+        else
+            ++k;
+    }
+    return k;
+}
+
+int Indexer::parseTypeDeclaration(int i, Symbol::Kind kind)
+{
+    const int j = i + 1;
+    if (!isName(j) || at(j + 1).is(Token::Dot)) {
+        m_public = false;
+        return j;
+    }
+
+    if (kind != Symbol::TypeAlias) {
+        m_container = text(j).toString();
+        m_containerKind = kind;
+        m_containerDepth = 0;
+        m_publicMembers = false;
+    }
+    addSymbol(j, kind);
+    return j + 1;
+}
+
+int Indexer::parseValues(int i, Symbol::Kind kind)
+{
+    const int j = i + 1;
+    if (!at(j).is(Token::LeftParenthesis)) {
+        if (isName(j))
+            addSymbol(j, kind);
+        else
+            m_public = false;
+        return j + 1;
+    }
+
+    // const ( a = 1 b = 2 ), values may span several lines
+    const bool isPublic = m_public;
+    const int end = skipBalanced(j);
+    int nesting = 0;
+    for (int k = j + 1; k < end - 1; ++k) {
+        switch (at(k).kind) {
+        case Token::LeftParenthesis:
+        case Token::LeftBracket:
+        case Token::LeftBrace:
+            ++nesting;
+            break;
+        case Token::RightParenthesis:
+        case Token::RightBracket:
+        case Token::RightBrace:
+            --nesting;
+            break;
+        default:
+            if (nesting == 0 && startsLine(k) && isName(k)) {
+                m_public = isPublic;
+                addSymbol(k, kind);
+            }
+            break;
+        }
+    }
+    m_public = false;
+    return end;
+}
+
+void Indexer::parseMember(int i)
+{
+    if (isKeyword(i, QLatin1String("pub"))) {
+        m_publicMembers = true;
+        return;
+    }
+    if (isKeyword(i, QLatin1String("mut")) && at(i + 1).is(Token::Colon)) {
+        m_publicMembers = false;
+        return;
+    }
+    if (!isName(i))
+        return;
+
+    const bool sameLine = line(i + 1) == line(i);
+    m_public = m_publicMembers || m_containerKind == Symbol::Interface;
+    switch (m_containerKind) {
+    case Symbol::Struct:
+        // a lone type name is an embedded struct, not a field
+        if (sameLine && !at(i + 1).is(Token::Colon))
+            addSymbol(i, Symbol::Field, m_container);
+        break;
+    case Symbol::Interface:
+        if (at(i + 1).is(Token::LeftParenthesis))
+            addSymbol(i, Symbol::Method, m_container);
+        else if (sameLine)
+            addSymbol(i, Symbol::Field, m_container);
+        break;
+    case Symbol::Enum:
+        m_public = true;
+        addSymbol(i, Symbol::EnumValue, m_container);
+        break;
+    default:
+        break;
+    }
+    m_public = false;
+}
+
+void Indexer::addCall(int nameToken)
+{
+    CallSite call;
+    call.name = text(nameToken).toString();
+    call.caller = m_function;
+    call.line = line(nameToken);
+    call.column = at(nameToken).offset - m_source.lineStart(call.line);
+    if (nameToken > 0 && at(nameToken - 1).is(Token::Dot)) {
+        call.qualified = true;
+        // a.b.c() has no single name to resolve c against
+        if (nameToken > 1 && isTypeName(nameToken - 2)
+                && (nameToken < 3 || !at(nameToken - 3).is(Token::Dot))) {
+            call.qualifier = text(nameToken - 2).toString();
+        }
+    }
+    m_index->calls.append(call);
+}
+
+void Indexer::addSymbol(int nameToken, Symbol::Kind kind, const QString &receiver)
+{
+    Symbol symbol;
+    symbol.name = text(nameToken).toString();
+    symbol.receiver = receiver;
+    symbol.kind = kind;
+    symbol.isPublic = m_public;
+    symbol.line = line(nameToken);
+    symbol.column = at(nameToken).offset - m_source.lineStart(symbol.line);
+    symbol.signature = signatureAt(symbol.line);
+    symbol.doc = docBefore(symbol.line);
+    m_index->symbols.append(symbol);
+    m_public = false;
+}
+
+QString Indexer::docBefore(int line) const
+{
+    int docLine = line - 1;
+    while (m_attributeLines.contains(docLine))
+        --docLine;
+
+    QStringList lines;
+    for (auto it = m_commentLines.constFind(docLine); it != m_commentLines.constEnd();
+         it = m_commentLines.constFind(--docLine)) {
+        lines.prepend(it.value());
+    }
+    return lines.join(QLatin1Char('\n'));
+}
+
+QString Indexer::signatureAt(int line) const
+{
+    QString signature = m_source.lineText(line).trimmed();
+    if (signature.endsWith(QLatin1Char('{'))) {
+        signature.chop(1);
+        signature = signature.trimmed();
+    }
+    return signature;
+}
+
+} // anonymous namespace
+
+FileIndexPtr indexFile(const QString &filePath, const SourceTokens &tokens)
+{
+    return Indexer(filePath, tokens).run();
+}
+
+} // namespace Internal
+} // namespace Vcreator
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <QSet>
+#include <QSharedPointer>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+namespace VCreator {
+namespace Internal {
+
+class SourceTokens;
+
+struct Symbol
+{
+    enum Kind {
+        Function,
+        Method,
+        Struct,
+        Enum,
+        Interface,
+        TypeAlias,
+        Constant,
+        Global,
+        Field,
+        EnumValue
+    };
+
+    QString name;
+    QString receiver; // owning type of methods, fields and enum values
+    QString signature;
+    QString doc;
+    Kind kind = Function;
+    bool isPublic = false;
+    int line = 0;   // 1-based
+    int column = 0; // 0-based
+
+    bool isMember() const { return !receiver.isEmpty(); }
+};
+
+struct Import
+{
+    QString path;        // "net.http"
+    QString alias;       // "http", or the name given with "as"
+    QStringList symbols; // selective import: import os { join_path }
+    int line = 0;
+};
+
+// name( inside a function body. Casts like Foo(x) are recorded as well,
+// they do not resolve to a function.
+struct CallSite
+{
+    QString name;
+    QString qualifier;      // module alias or type name in "qualifier.name()"
+    bool qualified = false; // also set for calls on expressions, foo().bar()
+    int caller = -1;        // index of the enclosing function in symbols
+    int line = 0;   // 1-based
+    int column = 0; // 0-based
+};
+
+struct FileIndex
+{
+    QString filePath;
+    QString directory; // a V module is a directory
+    QString module = QLatin1String("main");
+    QVector<Import> imports;
+    QVector<Symbol> symbols;
+    QSet<QString> qualifiers; // names used as "name." outside of imports
+    QSet<QString> usedSymbols; // selectively imported names used outside of imports
+    QVector<CallSite> calls;
+
+    const Import *importForAlias(const QString &alias) const;
+};
+
+using FileIndexPtr = QSharedPointer<const FileIndex>;
+
+// Extracts the module, imports, declarations and call sites of a V source file.
+// Doc comments are the // lines directly above a declaration.
+FileIndexPtr indexFile(const QString &filePath, const SourceTokens &tokens);
+
+} // namespace Internal
+} // namespace Vcreator
@@ -3,6 +3,8 @@
 #include "QRegularExpression"
 #include <QSet>
 
+#include <algorithm>
+
 namespace VCreator {
 namespace Internal {
 
@@ -339,10 +341,63 @@ QList<Token> Scanner::operator()(const QString &text, int startState)
     return tokens;
 }
 
-//bool VlangScanner::isKeyword(const QString &text) const
-//{
-//    return keywords.contains(text);
-//}
+SourceTokens::SourceTokens(const QString &text)
+    : m_text(text)
+{
+    Scanner scanner;
+    int state = Scanner::Normal;
+    int start = 0;
+    while (start <= m_text.length()) {
+        int end = m_text.indexOf(QLatin1Char('\n'), start);
+        if (end == -1)
+            end = m_text.length();
+
+        m_lineStarts.append(start);
+        const QList<Token> lineTokens = scanner(m_text.mid(start, end - start), state);
+        state = scanner.state();
+        m_lineEndStates.append(state);
+        for (const Token &token : lineTokens)
+            m_tokens.append(Token(start + token.offset, token.length, token.kind));
+
+        start = end + 1;
+    }
+}
+
+QString SourceTokens::lineText(int line) const
+{
+    const int start = lineStart(line);
+    const int end = line < lineCount() ? lineStart(line + 1) - 1 : m_text.length();
+    QString result = m_text.mid(start, end - start);
+    if (result.endsWith(QLatin1Char('\r')))
+        result.chop(1);
+    return result;
+}
+
+int SourceTokens::lineAt(int offset) const
+{
+    const auto it = std::upper_bound(m_lineStarts.cbegin(), m_lineStarts.cend(), offset);
+    return int(it - m_lineStarts.cbegin());
+}
+
+bool Scanner::isKeyword(const QString &text) const
+{
+    return vKeywords.contains(text);
+}
+
+const QSet<QString> &Scanner::keywords()
+{
+    return vKeywords;
+}
+
+const QSet<QString> &Scanner::builtinTypes()
+{
+    return vBuiltinTypes;
+}
+
+const QSet<QString> &Scanner::builtinFunctions()
+{
+    return vBuiltinFn;
+}
 
 
 
@@ -1,7 +1,10 @@
 #pragma once
 
 #include <QList>
+#include <QSet>
 #include <QString>
+#include <QStringView>
+#include <QVector>
 
 namespace VCreator {
 namespace Internal {
@@ -71,10 +74,46 @@ public:
 
     bool isKeyword(const QString &text) const;
 
+    static const QSet<QString> &keywords();
+    static const QSet<QString> &builtinTypes();
+    static const QSet<QString> &builtinFunctions();
+
 private:
     int _state;
     bool _scanComments: 1;
 };
 
+// Tokens of a whole source file. The scanner works line by line, so the
+// multi-line state is carried over and token offsets are made relative to
+// the start of the text.
+class SourceTokens
+{
+public:
+    explicit SourceTokens(const QString &text);
+
+    const QString &text() const { return m_text; }
+    const QVector<Token> &tokens() const { return m_tokens; }
+
+    QStringView textOf(const Token &token) const
+    { return QStringView(m_text).mid(token.offset, token.length); }
+
+    int lineCount() const { return m_lineStarts.size(); }
+    int lineStart(int line) const { return m_lineStarts.at(line - 1); }
+    QString lineText(int line) const;
+
+    // Lines are 1-based, columns are 0-based like in the text editor.
+    int lineAt(int offset) const;
+    int columnAt(int offset) const { return offset - lineStart(lineAt(offset)); }
+
+    // Scanner state at the end of line, see Scanner::MultiLineMask.
+    int lineEndState(int line) const { return m_lineEndStates.at(line - 1); }
+
+private:
+    QString m_text;
+    QVector<Token> m_tokens;
+    QVector<int> m_lineStarts;
+    QVector<int> m_lineEndStates;
+};
+
 } // namespace Internal
 } // namespace Vcreator
@@ -0,0 +1,94 @@
+#include "vcreatoroutputparser.h"
+#include "vcreatorsources.h"
+
+#include <QRegularExpression>
+
+using namespace ProjectExplorer;
+
+namespace VCreator {
+namespace Internal {
+
+// Source excerpt lines look like "   12 |     foo()" or "      |     ^".
+static bool isContextLine(const QString &line)
+{
+    const int bar = line.indexOf(QLatin1Char('|'));
+    if (bar <= 0)
+        return false;
+    for (int i = 0; i < bar; ++i) {
+        const QChar c = line.at(i);
+        if (c != QLatin1Char(' ') && !c.isDigit())
+            return false;
+    }
+    return true;
+}
+
+static Task::TaskType taskType(QStringView severity)
+{
+    if (severity == QLatin1String("error"))
+        return Task::Error;
+    if (severity == QLatin1String("warning"))
+        return Task::Warning;
+    return Task::Unknown;
+}
+
+OutputTaskParser::Result VlangOutputParser::handleLine(const QString &line, Utils::OutputFormat type)
+{
+    Q_UNUSED(type)
+
+    if (!m_task.isNull() && isContextLine(line)) {
+        m_task.details.append(line);
+        ++m_lines;
+        return Status::InProgress;
+    }
+    flush();
+
+    // Most lines are not diagnostics, keep the regular expression off them.
+    if (!line.contains(QLatin1String(": error: "))
+            && !line.contains(QLatin1String(": warning: "))
+            && !line.contains(QLatin1String(": notice: "))) {
+        return Status::NotHandled;
+    }
+
+    static const QRegularExpression diagnostic(
+                R"(^(.+?):(\d+):(?:(\d+):)? (error|warning|notice): (.*)$)");
+    const QRegularExpressionMatch match = diagnostic.match(line);
+    if (!match.hasMatch())
+        return Status::NotHandled;
+
+    Utils::FilePath filePath = absoluteFilePath(Utils::FilePath::fromUserInput(match.captured(1)));
+    int lineNumber = match.captured(2).toInt();
+    QString description = match.captured(5);
+    LinkSpecs linkSpecs;
+
+    if (isVlangSourceFile(filePath.toString())) {
+        addLinkSpecForAbsoluteFilePath(linkSpecs, filePath, lineNumber, match, 1);
+    } else {
+        QString sourceFile;
+        int sourceLine = 0;
+        if (m_generatedLines.map(filePath.toString(), lineNumber, &sourceFile, &sourceLine)) {
+            description = tr("C compiler: %1").arg(description);
+            filePath = Utils::FilePath::fromString(sourceFile);
+            lineNumber = sourceLine;
+        } else {
+            addLinkSpecForAbsoluteFilePath(linkSpecs, filePath, lineNumber, match, 1);
+        }
+    }
+
+    m_task = CompileTask(taskType(match.captured(4)), description, filePath, lineNumber);
+    m_lines = 1;
+    return {Status::InProgress, linkSpecs};
+}
+
+void VlangOutputParser::flush()
+{
+    if (m_task.isNull())
+        return;
+
+    const Task task = m_task;
+    m_task.clear();
+    scheduleTask(task, m_lines, 1);
+    m_lines = 0;
+}
+
+} // namespace Internal
+} // namespace Vcreator
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "vcreatorsources.h"
+
+#include <projectexplorer/ioutputparser.h>
+#include <projectexplorer/task.h>
+
+namespace VCreator {
+namespace Internal {
+
+// Turns "file.v:line:col: error: ..." diagnostics of the V compiler into
+// tasks. The source excerpt printed below a diagnostic becomes the task
+// details. Errors of the C backend in generated files are moved to the V
+// line recorded by the nearest #line directive, when the file was kept.
+class VlangOutputParser : public ProjectExplorer::OutputTaskParser
+{
+    Q_OBJECT
+
+public:
+    VlangOutputParser() = default;
+
+private:
+    Result handleLine(const QString &line, Utils::OutputFormat type) override;
+    void flush() override;
+
+    ProjectExplorer::Task m_task;
+    int m_lines = 0;
+    GeneratedLineMap m_generatedLines;
+};
+
+} // namespace Internal
+} // namespace Vcreator
@@ -0,0 +1,337 @@
+#include "vcreatorperf.h"
+#include "vcreatorconstants.h"
+#include "vcreatorprofiler.h"
+#include "vcreatorsources.h"
+
+#include <projectexplorer/project.h>
+#include <projectexplorer/projectexplorer.h>
+#include <texteditor/textmark.h>
+#include <utils/environment.h>
+#include <utils/qtcprocess.h>
+#include <utils/runextensions.h>
+#include <utils/theme/theme.h>
+
+#include <QDir>
+#include <QFile>
+#include <QRegularExpression>
+#include <QStringTokenizer>
+
+#include <algorithm>
+
+namespace VCreator {
+namespace Internal {
+
+static PerfProfiler *m_instance = nullptr;
+
+// Lines with at least this share of the samples get a mark
+static const double hotLineShare = 0.01;
+static const int maxHotLines = 50;
+static const int sampleFrequency = 999;
+static const int scriptTimeoutMs = 5 * 60 * 1000;
+
+class PerfLineMark : public TextEditor::TextMark
+{
+public:
+    PerfLineMark(const QString &filePath, int line, int samples, double share)
+        : TextEditor::TextMark(Utils::FilePath::fromString(filePath), line,
+                               Constants::C_PERF_MARK_CATEGORY)
+    {
+        setColor(Utils::Theme::CodeModel_Warning_TextMarkColor);
+        setPriority(TextEditor::TextMark::LowPriority);
+        const QString text = PerfProfiler::tr("%n samples (%1%)", nullptr, samples)
+                .arg(share * 100, 0, 'f', 1);
+        setLineAnnotation(text);
+        setToolTip(text);
+    }
+};
+
+namespace {
+
+struct Frame
+{
+    QString function;
+    QString filePath;
+    int line = 0;
+};
+
+class ProfileBuilder
+{
+public:
+    ProfileBuilder()
+    {
+        m_profile.nodes.append({});
+        m_profile.nodes[0].function = QLatin1String("all");
+    }
+
+    // Frames are innermost first, as perf prints the call chain
+    void addSample(const QVector<Frame> &frames)
+    {
+        if (frames.isEmpty())
+            return;
+        ++m_profile.sampleCount;
+        ++m_profile.nodes[0].samples;
+
+        int node = 0;
+        for (auto frame = frames.crbegin(); frame != frames.crend(); ++frame) {
+            node = child(node, *frame);
+            ++m_profile.nodes[node].samples;
+        }
+
+        for (const Frame &frame : frames) {
+            if (frame.line > 0) {
+                ++m_profile.lineHits[frame.filePath][frame.line];
+                break;
+            }
+        }
+    }
+
+    PerfProfile take() { return std::move(m_profile); }
+
+private:
+    int child(int parent, const Frame &frame)
+    {
+        for (int index : qAsConst(m_profile.nodes.at(parent).children)) {
+            PerfProfile::Node &node = m_profile.nodes[index];
+            if (node.function != frame.function)
+                continue;
+            if (node.line == 0 && frame.line > 0) {
+                node.filePath = frame.filePath;
+                node.line = frame.line;
+            }
+            return index;
+        }
+        PerfProfile::Node node;
+        node.function = frame.function;
+        node.filePath = frame.filePath;
+        node.line = frame.line;
+        m_profile.nodes.append(node);
+        m_profile.nodes[parent].children.append(m_profile.nodes.size() - 1);
+        return m_profile.nodes.size() - 1;
+    }
+
+    PerfProfile m_profile;
+};
+
+} // namespace
+
+PerfProfile parsePerfScript(const QString &output)
+{
+    // "    4005d6 main__foo+0x16 (/path/to/binary)" followed by "  main.v:12"
+    static const QRegularExpression frameLine(R"(^\s*[0-9a-f]+\s+(\S+?)(?:\+0x[0-9a-f]+)?(?:\s+\(.*\))?\s*$)");
+    static const QRegularExpression sourceLine(R"(^\s*(\S+):(\d+)\s*$)");
+
+    GeneratedLineMap generatedLines;
+    ProfileBuilder builder;
+    QVector<Frame> frames;
+    for (const QStringView line : qTokenize(output, QLatin1Char('\n'))) {
+        if (line.trimmed().isEmpty()) {
+            builder.addSample(frames);
+            frames.clear();
+            continue;
+        }
+
+        const QString text = line.toString();
+        QRegularExpressionMatch match = sourceLine.match(text);
+        if (match.hasMatch() && !frames.isEmpty()) {
+            Frame &frame = frames.last();
+            const QString filePath = match.captured(1);
+            const int lineNumber = match.captured(2).toInt();
+            if (isVlangSourceFile(filePath)) {
+                frame.filePath = filePath;
+                frame.line = lineNumber;
+            } else {
+                generatedLines.map(filePath, lineNumber, &frame.filePath, &frame.line);
+            }
+            continue;
+        }
+
+        match = frameLine.match(text);
+        if (match.hasMatch()) {
+            Frame frame;
+            frame.function = match.captured(1) == QLatin1String("[unknown]")
+                    ? QString() : demangle(match.captured(1)).toString();
+            if (frame.function.isEmpty())
+                frame.function = PerfProfiler::tr("[unknown]");
+            frames.append(frame);
+        }
+    }
+    builder.addSample(frames);
+    return builder.take();
+}
+
+static void resolveSamples(QFutureInterface<PerfProfile> &futureInterface, const QString &dataFile)
+{
+    QProcess process;
+    process.start(QLatin1String("perf"), {"script", "-i", dataFile, "-F", "ip,sym,srcline"});
+    if (!process.waitForFinished(scriptTimeoutMs)) {
+        process.kill();
+        process.waitForFinished();
+        return;
+    }
+    const QByteArray output = process.readAllStandardOutput();
+    QFile::remove(dataFile);
+    if (!futureInterface.isCanceled())
+        futureInterface.reportResult(parsePerfScript(QString::fromLocal8Bit(output)));
+}
+
+PerfRunner::PerfRunner(ProjectExplorer::RunControl *runControl)
+    : RunWorker(runControl)
+{
+    setId("VlangPerfRunner");
+
+    connect(&m_process, &QProcess::readyReadStandardOutput, this, [this] {
+        appendMessage(QString::fromLocal8Bit(m_process.readAllStandardOutput()), Utils::StdOutFormat);
+    });
+    connect(&m_process, &QProcess::readyReadStandardError, this, [this] {
+        appendMessage(QString::fromLocal8Bit(m_process.readAllStandardError()), Utils::StdErrFormat);
+    });
+    connect(&m_process, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished),
+            this, &PerfRunner::recordFinished);
+    // No finished() follows, the run would never stop
+    connect(&m_process, &QProcess::errorOccurred, this, [this](QProcess::ProcessError error) {
+        if (error == QProcess::FailedToStart)
+            reportFailure(tr("Could not start perf: %1").arg(m_process.errorString()));
+    });
+
+    connect(&m_watcher, &QFutureWatcher<PerfProfile>::finished, this, [this] {
+        if (m_watcher.isCanceled() || m_watcher.future().resultCount() == 0) {
+            reportFailure(tr("Resolving the perf samples failed."));
+            return;
+        }
+        const PerfProfile profile = m_watcher.result();
+        if (profile.sampleCount == 0) {
+            appendMessage(tr("No samples were recorded.") + QLatin1Char('\n'),
+                          Utils::ErrorMessageFormat);
+        } else {
+            appendMessage(tr("Resolved %n samples.", nullptr, profile.sampleCount)
+                          + QLatin1Char('\n'), Utils::NormalMessageFormat);
+            PerfProfiler::instance()->setProfile(profile);
+        }
+        reportStopped();
+    });
+}
+
+PerfRunner::~PerfRunner()
+{
+    m_watcher.cancel();
+    m_watcher.waitForFinished();
+}
+
+void PerfRunner::start()
+{
+    const ProjectExplorer::Runnable &runnable = runControl()->runnable();
+    const Utils::FilePath perf = runnable.environment.searchInPath(QLatin1String("perf"));
+    if (perf.isEmpty()) {
+        // There is no bundled sampler, perf is the only backend for now
+        reportFailure(tr("perf was not found in PATH. Install it to sample V applications, "
+                         "or use \"Profile V Application\" for the instrumented profile."));
+        return;
+    }
+
+    m_dataFile = QDir(runnable.executable.parentDir().toString())
+            .absoluteFilePath(runnable.executable.fileName() + ".perf.data");
+    QStringList arguments = {"record", "-g", "-F", QString::number(sampleFrequency),
+                             "-o", m_dataFile, "--", runnable.executable.toString()};
+    arguments += Utils::QtcProcess::splitArgs(runnable.commandLineArguments);
+    appendMessage(tr("Sampling %1: %2 %3").arg(runControl()->project()->displayName(),
+                                               perf.toUserOutput(), arguments.join(' '))
+                  + QLatin1Char('\n'), Utils::NormalMessageFormat);
+
+    m_stopped = false;
+    m_process.setProcessEnvironment(runnable.environment.toProcessEnvironment());
+    m_process.setWorkingDirectory(runnable.workingDirectory);
+    m_process.start(perf.toString(), arguments);
+    reportStarted();
+}
+
+void PerfRunner::stop()
+{
+    if (m_watcher.isRunning()) {
+        m_watcher.cancel();
+        return;
+    }
+    if (m_process.state() == QProcess::NotRunning) {
+        reportStopped();
+        return;
+    }
+    // perf record handles SIGTERM like SIGINT and writes what it has so far,
+    // the samples are still resolved
+    m_stopped = true;
+    m_process.terminate();
+}
+
+void PerfRunner::recordFinished(int exitCode, QProcess::ExitStatus status)
+{
+    appendMessage(tr("perf exited with code %1").arg(exitCode) + QLatin1Char('\n'),
+                  Utils::NormalMessageFormat);
+    if (!QFile::exists(m_dataFile) || (status != QProcess::NormalExit && !m_stopped)) {
+        reportFailure(tr("perf did not record any samples."));
+        return;
+    }
+
+    appendMessage(tr("Resolving samples...") + QLatin1Char('\n'), Utils::NormalMessageFormat);
+    m_watcher.setFuture(Utils::runAsync(resolveSamples, m_dataFile));
+}
+
+PerfProfiler::PerfProfiler()
+{
+    m_instance = this;
+}
+
+PerfProfiler::~PerfProfiler()
+{
+    qDeleteAll(m_marks);
+    m_instance = nullptr;
+}
+
+PerfProfiler *PerfProfiler::instance()
+{
+    return m_instance;
+}
+
+void PerfProfiler::profileStartupProject()
+{
+    ProjectExplorer::ProjectExplorerPlugin::runStartupProject(Constants::C_PERF_RUN_MODE);
+}
+
+void PerfProfiler::setProfile(const PerfProfile &profile)
+{
+    m_profile = profile;
+    updateMarks();
+    emit profileChanged();
+}
+
+void PerfProfiler::updateMarks()
+{
+    qDeleteAll(m_marks);
+    m_marks.clear();
+    if (m_profile.sampleCount == 0)
+        return;
+
+    struct LineHit
+    {
+        QString filePath;
+        int line;
+        int samples;
+    };
+    QVector<LineHit> hits;
+    for (auto file = m_profile.lineHits.cbegin(); file != m_profile.lineHits.cend(); ++file) {
+        for (auto line = file->cbegin(); line != file->cend(); ++line) {
+            if (line.value() >= hotLineShare * m_profile.sampleCount)
+                hits.append({file.key(), line.key(), line.value()});
+        }
+    }
+    std::sort(hits.begin(), hits.end(), [](const LineHit &a, const LineHit &b) {
+        return a.samples > b.samples;
+    });
+    if (hits.size() > maxHotLines)
+        hits.resize(maxHotLines);
+
+    for (const LineHit &hit : qAsConst(hits)) {
+        m_marks.append(new PerfLineMark(hit.filePath, hit.line, hit.samples,
+                                        double(hit.samples) / m_profile.sampleCount));
+    }
+}
+
+} // namespace Internal
+} // namespace Vcreator
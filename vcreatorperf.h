@@ -0,0 +1,90 @@
+#pragma once
+
+#include <projectexplorer/runcontrol.h>
+
+#include <QFutureWatcher>
+#include <QHash>
+#include <QObject>
+#include <QProcess>
+#include <QVector>
+
+namespace TextEditor { class TextMark; }
+
+namespace VCreator {
+namespace Internal {
+
+struct PerfProfile
+{
+    // Call tree of all samples, node 0 is the root. Frames are merged by
+    // function along the stack, which is what the flame graph shows.
+    struct Node
+    {
+        QString function;
+        QString filePath;   // first V location seen for the frame
+        int line = 0;
+        int samples = 0;
+        QVector<int> children;
+    };
+
+    QVector<Node> nodes;
+    // Samples whose innermost V frame is on the line: file -> line -> count
+    QHash<QString, QHash<int, int>> lineHits;
+    int sampleCount = 0;
+};
+
+// Turns "perf script -F ip,sym,srcline" output into a profile. Locations in
+// generated C files are mapped to V lines through their #line directives.
+PerfProfile parsePerfScript(const QString &output);
+
+// Records the run configuration's executable with "perf record -g" and
+// resolves the samples on a worker thread once the program exits. Debug
+// builds carry the #line mappings needed to get back to V source.
+class PerfRunner : public ProjectExplorer::RunWorker
+{
+    Q_OBJECT
+
+public:
+    explicit PerfRunner(ProjectExplorer::RunControl *runControl);
+    ~PerfRunner() override;
+
+    void start() override;
+    void stop() override;
+
+private:
+    void recordFinished(int exitCode, QProcess::ExitStatus status);
+
+    QProcess m_process;
+    QString m_dataFile;
+    bool m_stopped = false;
+    QFutureWatcher<PerfProfile> m_watcher;
+};
+
+// Latest perf profile of the session, its hot lines get a hit count mark
+// in the editor margin.
+class PerfProfiler : public QObject
+{
+    Q_OBJECT
+
+public:
+    PerfProfiler();
+    ~PerfProfiler() override;
+
+    static PerfProfiler *instance();
+
+    static void profileStartupProject();
+
+    void setProfile(const PerfProfile &profile);
+    const PerfProfile &profile() const { return m_profile; }
+
+signals:
+    void profileChanged();
+
+private:
+    void updateMarks();
+
+    PerfProfile m_profile;
+    QVector<TextEditor::TextMark *> m_marks;
+};
+
+} // namespace Internal
+} // namespace Vcreator
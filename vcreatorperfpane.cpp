@@ -0,0 +1,289 @@
+#include "vcreatorperfpane.h"
+#include "vcreatorperf.h"
+#include "vcreatorsources.h"
+
+#include <utils/utilsicons.h>
+
+#include <QLabel>
+#include <QMouseEvent>
+#include <QPainter>
+#include <QScrollArea>
+#include <QToolButton>
+#include <QToolTip>
+
+namespace VCreator {
+namespace Internal {
+
+static const int rowHeight = 18;
+static const double minBoxWidth = 2;
+
+static const PerfProfile &currentProfile()
+{
+    return PerfProfiler::instance()->profile();
+}
+
+// Stable warm color per function, so frames keep their color between runs
+static QColor frameColor(const QString &function, bool hovered)
+{
+    const uint hash = qHash(function);
+    QColor color = QColor::fromHsv(int(hash % 50), 140 + int(hash / 50 % 80), 230);
+    return hovered ? color.lighter(120) : color;
+}
+
+static int treeDepth(const PerfProfile &profile, int node)
+{
+    int depth = 0;
+    for (int child : profile.nodes.at(node).children)
+        depth = qMax(depth, treeDepth(profile, child));
+    return depth + 1;
+}
+
+FlameGraphWidget::FlameGraphWidget(QWidget *parent)
+    : QWidget(parent)
+{
+    setMouseTracking(true);
+    setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Minimum);
+}
+
+void FlameGraphWidget::reset()
+{
+    m_zoomPath.clear();
+    m_hovered = -1;
+    const PerfProfile &profile = currentProfile();
+    setMinimumHeight(profile.nodes.isEmpty() ? 0 : treeDepth(profile, 0) * rowHeight);
+    update();
+}
+
+void FlameGraphWidget::zoomOut()
+{
+    if (m_zoomPath.isEmpty())
+        return;
+    m_zoomPath.removeLast();
+    update();
+}
+
+QSize FlameGraphWidget::sizeHint() const
+{
+    return QSize(600, minimumHeight());
+}
+
+void FlameGraphWidget::layoutBoxes()
+{
+    m_boxes.clear();
+    const PerfProfile &profile = currentProfile();
+    if (profile.nodes.isEmpty())
+        return;
+    layoutNode(m_zoomPath.isEmpty() ? 0 : m_zoomPath.last(), 0, width(), 0);
+}
+
+void FlameGraphWidget::layoutNode(int node, double x, double width, int depth)
+{
+    const PerfProfile &profile = currentProfile();
+    const PerfProfile::Node &current = profile.nodes.at(node);
+    m_boxes.append({QRectF(x, depth * rowHeight, width, rowHeight - 1), node});
+    if (current.samples == 0)
+        return;
+
+    for (int child : current.children) {
+        const double childWidth = width * profile.nodes.at(child).samples / current.samples;
+        if (childWidth >= minBoxWidth)
+            layoutNode(child, x, childWidth, depth + 1);
+        x += childWidth;
+    }
+}
+
+int FlameGraphWidget::nodeAt(const QPoint &pos) const
+{
+    for (const Box &box : m_boxes) {
+        if (box.rect.contains(pos))
+            return box.node;
+    }
+    return -1;
+}
+
+void FlameGraphWidget::paintEvent(QPaintEvent *event)
+{
+    Q_UNUSED(event)
+    layoutBoxes();
+
+    QPainter painter(this);
+    painter.fillRect(rect(), palette().base());
+    const PerfProfile &profile = currentProfile();
+    const QFontMetrics metrics = fontMetrics();
+    for (const Box &box : qAsConst(m_boxes)) {
+        const PerfProfile::Node &node = profile.nodes.at(box.node);
+        painter.fillRect(box.rect, frameColor(node.function, box.node == m_hovered));
+        const QRectF textRect = box.rect.adjusted(3, 0, -3, 0);
+        if (textRect.width() < metrics.averageCharWidth() * 3)
+            continue;
+        painter.setPen(Qt::black);
+        painter.drawText(textRect, Qt::AlignLeft | Qt::AlignVCenter,
+                         metrics.elidedText(node.function, Qt::ElideRight, int(textRect.width())));
+    }
+}
+
+void FlameGraphWidget::mouseMoveEvent(QMouseEvent *event)
+{
+    const int node = nodeAt(event->pos());
+    if (node != m_hovered) {
+        m_hovered = node;
+        update();
+    }
+    if (node < 0) {
+        QToolTip::hideText();
+        return;
+    }
+
+    const PerfProfile &profile = currentProfile();
+    const PerfProfile::Node &current = profile.nodes.at(node);
+    QString text = tr("%1\n%n samples (%2%)", nullptr, current.samples)
+            .arg(current.function)
+            .arg(100.0 * current.samples / qMax(1, profile.sampleCount), 0, 'f', 1);
+    if (current.line > 0)
+        text += QLatin1Char('\n') + tr("%1:%2").arg(current.filePath).arg(current.line);
+    QToolTip::showText(event->globalPos(), text, this);
+}
+
+void FlameGraphWidget::mousePressEvent(QMouseEvent *event)
+{
+    if (event->button() == Qt::RightButton) {
+        zoomOut();
+        return;
+    }
+    const int node = nodeAt(event->pos());
+    if (node > 0 && (m_zoomPath.isEmpty() || m_zoomPath.last() != node)) {
+        m_zoomPath.append(node);
+        update();
+    }
+}
+
+void FlameGraphWidget::mouseDoubleClickEvent(QMouseEvent *event)
+{
+    const int node = nodeAt(event->pos());
+    if (node < 0)
+        return;
+    const PerfProfile::Node &current = currentProfile().nodes.at(node);
+    if (current.line > 0)
+        openEditorAt(current.filePath, current.line);
+}
+
+PerfPane::PerfPane()
+    : m_scrollArea(new QScrollArea)
+    , m_profileButton(new QToolButton)
+    , m_zoomOutButton(new QToolButton)
+    , m_summary(new QLabel)
+{
+    m_scrollArea->setFrameStyle(QFrame::NoFrame);
+    m_scrollArea->setWidgetResizable(true);
+
+    m_profileButton->setIcon(Utils::Icons::RUN_SMALL_TOOLBAR.icon());
+    m_profileButton->setToolTip(tr("Profile V Application with perf"));
+    connect(m_profileButton, &QToolButton::clicked, this, &PerfProfiler::profileStartupProject);
+
+    m_zoomOutButton->setIcon(Utils::Icons::ZOOMOUT_TOOLBAR.icon());
+    m_zoomOutButton->setToolTip(tr("Zoom Out"));
+    m_zoomOutButton->setEnabled(false);
+
+    m_summary->setText(tr("No samples yet"));
+}
+
+PerfPane::~PerfPane()
+{
+    delete m_scrollArea;
+}
+
+void PerfPane::attach(PerfProfiler *profiler)
+{
+    m_graph = new FlameGraphWidget;
+    m_scrollArea->setWidget(m_graph);
+    m_zoomOutButton->setEnabled(true);
+    connect(m_zoomOutButton, &QToolButton::clicked, m_graph, &FlameGraphWidget::zoomOut);
+    connect(profiler, &PerfProfiler::profileChanged, this, &PerfPane::profileChanged);
+}
+
+QWidget *PerfPane::outputWidget(QWidget *parent)
+{
+    m_scrollArea->setParent(parent);
+    return m_scrollArea;
+}
+
+QList<QWidget *> PerfPane::toolBarWidgets() const
+{
+    return {m_profileButton, m_zoomOutButton, m_summary};
+}
+
+QString PerfPane::displayName() const
+{
+    return tr("V Perf");
+}
+
+int PerfPane::priorityInStatusBar() const
+{
+    return 5;
+}
+
+void PerfPane::clearContents()
+{
+    if (PerfProfiler *profiler = PerfProfiler::instance())
+        profiler->setProfile({});
+}
+
+void PerfPane::visibilityChanged(bool visible)
+{
+    Q_UNUSED(visible)
+}
+
+void PerfPane::setFocus()
+{
+    if (m_graph)
+        m_graph->setFocus();
+}
+
+bool PerfPane::hasFocus() const
+{
+    return m_graph && m_graph->hasFocus();
+}
+
+bool PerfPane::canFocus() const
+{
+    return true;
+}
+
+bool PerfPane::canNavigate() const
+{
+    return false;
+}
+
+bool PerfPane::canNext() const
+{
+    return false;
+}
+
+bool PerfPane::canPrevious() const
+{
+    return false;
+}
+
+void PerfPane::goToNext()
+{
+}
+
+void PerfPane::goToPrev()
+{
+}
+
+void PerfPane::profileChanged()
+{
+    m_graph->reset();
+    const PerfProfile &profile = currentProfile();
+    if (profile.sampleCount == 0) {
+        m_summary->setText(tr("No samples yet"));
+        return;
+    }
+    m_summary->setText(tr("%n samples in %1 files", nullptr, profile.sampleCount)
+                       .arg(profile.lineHits.size()));
+    popup(NoModeSwitch);
+}
+
+} // namespace Internal
+} // namespace Vcreator
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <coreplugin/ioutputpane.h>
+
+#include <QWidget>
+
+QT_BEGIN_NAMESPACE
+class QLabel;
+class QScrollArea;
+class QToolButton;
+QT_END_NAMESPACE
+
+namespace VCreator {
+namespace Internal {
+
+class PerfProfiler;
+
+// Icicle style flame graph of the latest perf profile: callers at the top,
+// width proportional to the samples. Clicking a frame zooms into it,
+// double clicking opens its V source.
+class FlameGraphWidget : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit FlameGraphWidget(QWidget *parent = nullptr);
+
+    void reset();
+    void zoomOut();
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+    void mouseMoveEvent(QMouseEvent *event) override;
+    void mousePressEvent(QMouseEvent *event) override;
+    void mouseDoubleClickEvent(QMouseEvent *event) override;
+    QSize sizeHint() const override;
+
+private:
+    struct Box
+    {
+        QRectF rect;
+        int node;
+    };
+
+    void layoutBoxes();
+    void layoutNode(int node, double x, double width, int depth);
+    int nodeAt(const QPoint &pos) const;
+
+    QVector<Box> m_boxes;
+    QVector<int> m_zoomPath;
+    int m_hovered = -1;
+};
+
+class PerfPane : public Core::IOutputPane
+{
+    Q_OBJECT
+
+public:
+    PerfPane();
+    ~PerfPane() override;
+
+    // Builds the flame graph and follows profiler, on first V use
+    void attach(PerfProfiler *profiler);
+
+    QWidget *outputWidget(QWidget *parent) override;
+    QList<QWidget *> toolBarWidgets() const override;
+    QString displayName() const override;
+    int priorityInStatusBar() const override;
+    void clearContents() override;
+    void visibilityChanged(bool visible) override;
+    void setFocus() override;
+    bool hasFocus() const override;
+    bool canFocus() const override;
+    bool canNavigate() const override;
+    bool canNext() const override;
+    bool canPrevious() const override;
+    void goToNext() override;
+    void goToPrev() override;
+
+private:
+    void profileChanged();
+
+    QScrollArea *m_scrollArea;
+    FlameGraphWidget *m_graph = nullptr;
+    QToolButton *m_profileButton;
+    QToolButton *m_zoomOutButton;
+    QLabel *m_summary;
+};
+
+} // namespace Internal
+} // namespace Vcreator
@@ -1,10 +1,29 @@
 #include "vcreatorplugin.h"
 #include "vcreatorconstants.h"
 #include "vcreatorproject.h"
+#include "vcreatorbuildconfiguration.h"
+#include "vcreatorbuildstep.h"
+#include "vcreatorcallhierarchy.h"
+#include "vcreatorrunconfiguration.h"
 #include "vcreatorsettings.h"
+#include "vcreatordiagnostics.h"
 #include "vcreatoreditor.h"
+#include "vcreatorformatter.h"
 #include "vcreatorhighlighter.h"
+#include "vcreatorimplementations.h"
+#include "vcreatorimportgraph.h"
+#include "vcreatorimportsview.h"
 #include "vcreatorindenter.h"
+#include "vcreatorperf.h"
+#include "vcreatorperfpane.h"
+#include "vcreatorprofiler.h"
+#include "vcreatorprofilerpane.h"
+#include "vcreatorsnapshots.h"
+#include "vcreatorsymbolindex.h"
+#include "vcreatortestresultspane.h"
+#include "vcreatortestrunner.h"
+#include "vcreatortoolchain.h"
+#include "vcreatorvls.h"
 
 #include <coreplugin/icore.h>
 #include <coreplugin/icontext.h>
@@ -12,28 +31,88 @@
 #include <coreplugin/actionmanager/command.h>
 #include <coreplugin/actionmanager/actioncontainer.h>
 #include <coreplugin/coreconstants.h>
+#include <coreplugin/editormanager/editormanager.h>
 
 #include <coreplugin/fileiconprovider.h>
+#include <projectexplorer/projectexplorerconstants.h>
 #include <projectexplorer/projectmanager.h>
+#include <projectexplorer/runcontrol.h>
 #include <texteditor/snippets/snippetprovider.h>
 #include <texteditor/texteditor.h>
 #include <texteditor/textdocument.h>
 
 #include <utils/theme/theme.h>
 
+#include <QAction>
+#include <QElapsedTimer>
+#include <QLoggingCategory>
+#include <QMenu>
+
+#include <memory>
+
 namespace VCreator {
 namespace Internal {
 
+Q_LOGGING_CATEGORY(pluginLog, "qtc.vcreator.plugin", QtWarningMsg)
+
+static Plugin *m_instance = nullptr;
+
+// Indexes, checks and runners, created on first V use. Later members use
+// the instances of earlier ones.
+struct LanguageSupport {
+    VlsManager vlsManager;
+    DocumentSnapshotManager snapshotManager;
+    SymbolIndex symbolIndex;
+    ImportGraph importGraph;
+    ImplementationIndex implementationIndex;
+    CallIndex callIndex;
+    VlangDiagnostics diagnostics;
+    TestRunner testRunner;
+    Profiler profiler;
+    PerfProfiler perfProfiler;
+};
+
 struct PluginPrivate {
+    ToolchainManager toolchainManager;
+    ImportsViewFactory importsViewFactory;
+    CallHierarchyFactory callHierarchyFactory;
+    // Output panes have to exist before Core sets up the pane bar, their
+    // contents are only built when language support is
+    TestResultsPane testResultsPane;
+    ProfilerPane profilerPane;
+    PerfPane perfPane;
     VlangSettings settings;
     EditorFactory editorFactory;
+    VlangSettingsPage settingsPage;
     VlangCodeStyleSettingsPage codeStylePage;
+    VlangBuildConfigurationFactory buildConfigurationFactory;
+    VlangBuildStepFactory buildStepFactory;
+    VlangCleanStepFactory cleanStepFactory;
+    VlangRunConfigurationFactory runConfigurationFactory;
+    ProjectExplorer::RunWorkerFactory runWorkerFactory{
+        ProjectExplorer::RunWorkerFactory::make<ProjectExplorer::SimpleTargetRunner>(),
+        {ProjectExplorer::Constants::NORMAL_RUN_MODE},
+        {runConfigurationFactory.runConfigurationId()}
+    };
+    ProjectExplorer::RunWorkerFactory profileWorkerFactory{
+        ProjectExplorer::RunWorkerFactory::make<ProfileRunner>(),
+        {Constants::C_PROFILE_RUN_MODE},
+        {runConfigurationFactory.runConfigurationId()}
+    };
+    ProjectExplorer::RunWorkerFactory perfWorkerFactory{
+        ProjectExplorer::RunWorkerFactory::make<PerfRunner>(),
+        {Constants::C_PERF_RUN_MODE},
+        {runConfigurationFactory.runConfigurationId()}
+    };
+    // Last, so it goes before the settings and panes it uses
+    std::unique_ptr<LanguageSupport> languageSupport;
 };
 
 
 Plugin::Plugin()
 {
     // Create your members
+    m_instance = this;
 }
 
 Plugin::~Plugin()
@@ -41,6 +120,26 @@ Plugin::~Plugin()
     // Unregister objects from the plugin manager's object pool
     // Delete members
     delete d;
+    m_instance = nullptr;
+}
+
+void Plugin::ensureLanguageSupport()
+{
+    PluginPrivate *d = m_instance ? m_instance->d : nullptr;
+    if (!d || d->languageSupport)
+        return;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    d->languageSupport.reset(new LanguageSupport);
+    d->testResultsPane.attach(&d->languageSupport->testRunner);
+    d->profilerPane.attach(&d->languageSupport->profiler);
+    d->perfPane.attach(&d->languageSupport->perfProfiler);
+    d->settings.loadCodeStyles();
+    d->toolchainManager.detect();
+
+    qCDebug(pluginLog) << "Language support set up in" << timer.nsecsElapsed() / 1000 << "us";
 }
 
 bool Plugin::initialize(const QStringList &arguments, QString *errorString)
@@ -55,6 +154,13 @@ bool Plugin::initialize(const QStringList &arguments, QString *errorString)
     Q_UNUSED(arguments)
     Q_UNUSED(errorString)
 
+    QElapsedTimer timer;
+    timer.start();
+
+    // Only registrations happen here: Qt Creator picks up code style
+    // factories when projects are created, snippet groups and output panes
+    // when the core opens. Indexes, runners, pane contents, reading settings
+    // and probing the toolchain wait for ensureLanguageSupport().
     d = new PluginPrivate;
 
     TextEditor::SnippetProvider::registerGroup(Constants::C_VLANGSNIPPETSGROUP_ID,
@@ -63,6 +169,104 @@ bool Plugin::initialize(const QStringList &arguments, QString *errorString)
 
     ProjectExplorer::ProjectManager::registerProjectType<VlangProject>(Constants::C_VLANG_PROJECT_MIMETYPE);
 
+    connect(Core::EditorManager::instance(), &Core::EditorManager::aboutToSave,
+            this, &VlangFormatter::formatBeforeSave);
+
+    Core::ActionContainer *menu = Core::ActionManager::createMenu(Constants::C_VLANG_MENU_ID);
+    menu->menu()->setTitle(tr("&V"));
+    Core::ActionManager::actionContainer(Core::Constants::M_TOOLS)->addMenu(menu);
+
+    const Core::Context editorContext(Constants::C_VLANG_EDITOR_ID);
+    const auto currentEditor = [] {
+        return dynamic_cast<VlangEditorWidget *>(TextEditor::TextEditorWidget::currentTextEditorWidget());
+    };
+
+    auto findImplementations = new QAction(tr("Find Implementations"), this);
+    menu->addAction(Core::ActionManager::registerAction(findImplementations,
+                                                        Constants::C_ACTION_FIND_IMPLEMENTATIONS,
+                                                        editorContext));
+    connect(findImplementations, &QAction::triggered, this, [currentEditor] {
+        if (VlangEditorWidget *editor = currentEditor())
+            editor->findImplementations();
+    });
+
+    auto findImplementedInterfaces = new QAction(tr("Find Implemented Interfaces"), this);
+    menu->addAction(Core::ActionManager::registerAction(findImplementedInterfaces,
+                                                        Constants::C_ACTION_FIND_IMPLEMENTED_INTERFACES,
+                                                        editorContext));
+    connect(findImplementedInterfaces, &QAction::triggered, this, [currentEditor] {
+        if (VlangEditorWidget *editor = currentEditor())
+            editor->findImplementedInterfaces();
+    });
+
+    auto openCallHierarchy = new QAction(tr("Open Call Hierarchy"), this);
+    menu->addAction(Core::ActionManager::registerAction(openCallHierarchy,
+                                                        Constants::C_ACTION_OPEN_CALL_HIERARCHY,
+                                                        editorContext));
+    connect(openCallHierarchy, &QAction::triggered, this, [currentEditor] {
+        if (VlangEditorWidget *editor = currentEditor())
+            editor->openCallHierarchy();
+    });
+    menu->addSeparator();
+
+    auto jumpToMatchingBracket = new QAction(tr("Jump to Matching Bracket"), this);
+    menu->addAction(Core::ActionManager::registerAction(jumpToMatchingBracket,
+                                                        Constants::C_ACTION_JUMP_TO_MATCHING_BRACKET,
+                                                        editorContext));
+    connect(jumpToMatchingBracket, &QAction::triggered, this, [currentEditor] {
+        if (VlangEditorWidget *editor = currentEditor())
+            editor->jumpToMatchingBracket();
+    });
+
+    auto selectEnclosingBlock = new QAction(tr("Select Enclosing Block"), this);
+    menu->addAction(Core::ActionManager::registerAction(selectEnclosingBlock,
+                                                        Constants::C_ACTION_SELECT_ENCLOSING_BLOCK,
+                                                        editorContext));
+    connect(selectEnclosingBlock, &QAction::triggered, this, [currentEditor] {
+        if (VlangEditorWidget *editor = currentEditor())
+            editor->selectEnclosingBlock();
+    });
+    menu->addSeparator();
+
+    auto runTests = new QAction(tr("Run All Tests"), this);
+    menu->addAction(Core::ActionManager::registerAction(runTests, Constants::C_ACTION_RUN_TESTS));
+    connect(runTests, &QAction::triggered, this, [] {
+        ensureLanguageSupport();
+        TestRunner::instance()->runAllTests();
+    });
+
+    auto runAffectedTests = new QAction(tr("Run Affected Tests"), this);
+    menu->addAction(Core::ActionManager::registerAction(runAffectedTests,
+                                                        Constants::C_ACTION_RUN_AFFECTED_TESTS));
+    connect(runAffectedTests, &QAction::triggered, this, [] {
+        ensureLanguageSupport();
+        TestRunner::instance()->runAffectedTests();
+    });
+
+    auto rerunFailedTests = new QAction(tr("Rerun Failed Tests"), this);
+    menu->addAction(Core::ActionManager::registerAction(rerunFailedTests,
+                                                        Constants::C_ACTION_RERUN_FAILED_TESTS));
+    connect(rerunFailedTests, &QAction::triggered, this, [] {
+        ensureLanguageSupport();
+        TestRunner::instance()->rerunFailedTests();
+    });
+    menu->addSeparator();
+
+    auto profile = new QAction(tr("Profile V Application"), this);
+    menu->addAction(Core::ActionManager::registerAction(profile, Constants::C_ACTION_PROFILE));
+    connect(profile, &QAction::triggered, this, [] {
+        ensureLanguageSupport();
+        Profiler::profileStartupProject();
+    });
+
+    auto perfProfile = new QAction(tr("Profile V Application with perf"), this);
+    menu->addAction(Core::ActionManager::registerAction(perfProfile, Constants::C_ACTION_PERF_PROFILE));
+    connect(perfProfile, &QAction::triggered, this, [] {
+        ensureLanguageSupport();
+        PerfProfiler::profileStartupProject();
+    });
+
+    qCDebug(pluginLog) << "Initialized in" << timer.nsecsElapsed() / 1000 << "us";
     return true;
 }
 
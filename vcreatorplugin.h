@@ -22,6 +22,11 @@ public:
     void extensionsInitialized() override;
     ShutdownFlag aboutToShutdown() override;
 
+    // Creates the indexes, runners and pane contents, loads code styles and
+    // detects the toolchain on first use: when a V file or project is opened,
+    // a V view, action or settings page is used.
+    static void ensureLanguageSupport();
+
 private:
     PluginPrivate *d = nullptr;
 };
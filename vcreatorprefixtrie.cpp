@@ -0,0 +1,87 @@
+#include "vcreatorprefixtrie.h"
+
+namespace VCreator {
+namespace Internal {
+
+PrefixTrie::PrefixTrie()
+{
+    clear();
+}
+
+void PrefixTrie::clear()
+{
+    m_nodes.clear();
+    m_nodes.append(Node());
+}
+
+int PrefixTrie::child(int node, QChar ch) const
+{
+    for (const auto &edge : m_nodes.at(node).children) {
+        if (edge.first == ch)
+            return edge.second;
+    }
+    return -1;
+}
+
+int PrefixTrie::findNode(const QString &prefix) const
+{
+    int node = 0;
+    for (const QChar ch : prefix) {
+        node = child(node, ch.toLower());
+        if (node == -1)
+            break;
+    }
+    return node;
+}
+
+void PrefixTrie::insert(const QString &name)
+{
+    int node = 0;
+    for (const QChar ch : name) {
+        const QChar key = ch.toLower();
+        int next = child(node, key);
+        if (next == -1) {
+            next = m_nodes.size();
+            m_nodes.append(Node());
+            m_nodes[node].children.append(qMakePair(key, next));
+        }
+        node = next;
+    }
+    ++m_nodes[node].names[name];
+}
+
+void PrefixTrie::remove(const QString &name)
+{
+    // Nodes are kept, they are reused when the name comes back on the next
+    // reindex of the file.
+    const int node = findNode(name);
+    if (node == -1)
+        return;
+    auto it = m_nodes[node].names.find(name);
+    if (it != m_nodes[node].names.end() && --it.value() <= 0)
+        m_nodes[node].names.erase(it);
+}
+
+QStringList PrefixTrie::namesWithPrefix(const QString &prefix, int limit) const
+{
+    QStringList result;
+    const int start = findNode(prefix);
+    if (start == -1)
+        return result;
+
+    QVector<int> stack{start};
+    while (!stack.isEmpty()) {
+        const Node &node = m_nodes.at(stack.takeLast());
+        for (auto it = node.names.cbegin(); it != node.names.cend(); ++it) {
+            result.append(it.key());
+            if (limit >= 0 && result.size() >= limit)
+                return result;
+        }
+        for (const auto &edge : node.children)
+            stack.append(edge.second);
+    }
+    return result;
+}
+
+} // namespace Internal
+} // namespace Vcreator
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <QHash>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+namespace VCreator {
+namespace Internal {
+
+// Case insensitive prefix trie of names. Names are reference counted, so the
+// same name may be inserted once per declaration and removed the same way.
+class PrefixTrie
+{
+public:
+    PrefixTrie();
+
+    void insert(const QString &name);
+    void remove(const QString &name);
+    void clear();
+
+    QStringList namesWithPrefix(const QString &prefix, int limit = -1) const;
+
+private:
+    struct Node
+    {
+        QVector<QPair<QChar, int>> children;
+        QHash<QString, int> names; // spellings ending here and their counts
+    };
+
+    int child(int node, QChar ch) const;
+    int findNode(const QString &prefix) const;
+
+    QVector<Node> m_nodes;
+};
+
+} // namespace Internal
+} // namespace Vcreator
@@ -0,0 +1,298 @@
+#include "vcreatorprofiler.h"
+#include "vcreatorconstants.h"
+#include "vcreatorsettings.h"
+#include "vcreatorsymbolindex.h"
+
+#include <projectexplorer/project.h>
+#include <projectexplorer/projectexplorer.h>
+#include <texteditor/textmark.h>
+#include <utils/hostosinfo.h>
+#include <utils/qtcprocess.h>
+#include <utils/theme/theme.h>
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QRegularExpression>
+
+#include <algorithm>
+
+namespace VCreator {
+namespace Internal {
+
+static Profiler *m_instance = nullptr;
+
+// Functions taking at least this share of the run are annotated
+static const double hotShare = 0.05;
+static const int maxHotFunctions = 10;
+static const int maxRuns = 10;
+
+class ProfileMark : public TextEditor::TextMark
+{
+public:
+    ProfileMark(const QString &filePath, int line, const ProfileEntry &entry, double share)
+        : TextEditor::TextMark(Utils::FilePath::fromString(filePath), line,
+                               Constants::C_PROFILER_MARK_CATEGORY)
+    {
+        setColor(Utils::Theme::CodeModel_Warning_TextMarkColor);
+        setPriority(TextEditor::TextMark::LowPriority);
+        const QString text = Profiler::tr("%1% of run time, %2 ms in %3 calls")
+                .arg(share * 100, 0, 'f', 1)
+                .arg(entry.totalMs, 0, 'f', 3)
+                .arg(entry.calls);
+        setLineAnnotation(text);
+        setToolTip(text);
+    }
+};
+
+double ProfileRun::totalMs() const
+{
+    double total = 0;
+    for (const ProfileEntry &entry : entries)
+        total = qMax(total, entry.totalMs);
+    return total;
+}
+
+const ProfileEntry *ProfileRun::entry(const QString &function) const
+{
+    for (const ProfileEntry &entry : entries) {
+        if (entry.function == function)
+            return &entry;
+    }
+    return nullptr;
+}
+
+QVector<ProfileEntry> parseProfile(const QString &text)
+{
+    // "calls total_ms [self_ms] average_ns name", self time only in newer V
+    static const QRegularExpression line(
+                R"(^\s*(\d+)\s+([\d.]+)ms\s+(?:([\d.]+)ms\s+)?([\d.]+)ns\s+(\S+)\s*$)",
+                QRegularExpression::MultilineOption);
+
+    QVector<ProfileEntry> entries;
+    QRegularExpressionMatchIterator it = line.globalMatch(text);
+    while (it.hasNext()) {
+        const QRegularExpressionMatch match = it.next();
+        ProfileEntry entry;
+        entry.calls = match.captured(1).toLongLong();
+        entry.totalMs = match.captured(2).toDouble();
+        if (match.capturedLength(3) > 0)
+            entry.selfMs = match.captured(3).toDouble();
+        entry.averageNs = match.captured(4).toDouble();
+        entry.function = match.captured(5);
+        entries.append(entry);
+    }
+    std::sort(entries.begin(), entries.end(), [](const ProfileEntry &a, const ProfileEntry &b) {
+        return a.totalMs > b.totalMs;
+    });
+    return entries;
+}
+
+QString FunctionName::toString() const
+{
+    QString result = module.isEmpty() ? QString() : module + QLatin1Char('.');
+    if (!receiver.isEmpty())
+        result += receiver + QLatin1Char('.');
+    return result + name;
+}
+
+FunctionName demangle(const QString &cName)
+{
+    static const QStringList builtinReceivers = {
+        "string", "array", "map", "byte", "rune", "int", "u8", "u16", "u32", "u64",
+        "i8", "i16", "i64", "f32", "f64", "bool", "char", "voidptr", "byteptr"
+    };
+
+    FunctionName result;
+    QString rest = cName;
+    const int moduleEnd = cName.lastIndexOf(QLatin1String("__"));
+    if (moduleEnd > 0) {
+        result.module = cName.left(moduleEnd).replace(QLatin1String("__"), QLatin1String("."));
+        rest = cName.mid(moduleEnd + 2);
+    }
+
+    // Methods are "Type_method", builtin types are lower case
+    const int separator = rest.indexOf(QLatin1Char('_'));
+    if (separator > 0) {
+        const QString type = rest.left(separator);
+        if (type.at(0).isUpper() || (result.module.isEmpty() && builtinReceivers.contains(type))) {
+            result.receiver = type;
+            rest = rest.mid(separator + 1);
+        }
+    }
+    result.name = rest;
+    return result;
+}
+
+ProfileRunner::ProfileRunner(ProjectExplorer::RunControl *runControl)
+    : RunWorker(runControl)
+{
+    setId("VlangProfileRunner");
+
+    connect(&m_process, &QProcess::readyReadStandardOutput, this, [this] {
+        appendMessage(QString::fromLocal8Bit(m_process.readAllStandardOutput()), Utils::StdOutFormat);
+    });
+    connect(&m_process, &QProcess::readyReadStandardError, this, [this] {
+        appendMessage(QString::fromLocal8Bit(m_process.readAllStandardError()), Utils::StdErrFormat);
+    });
+    connect(&m_process, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished),
+            this, [this](int exitCode, QProcess::ExitStatus status) {
+        if (m_building)
+            buildFinished(exitCode, status);
+        else
+            runFinished(exitCode, status);
+    });
+    // No finished() follows, the run would never stop
+    connect(&m_process, &QProcess::errorOccurred, this, [this](QProcess::ProcessError error) {
+        if (error != QProcess::FailedToStart)
+            return;
+        const QString program = m_building ? VlangSettings::compilerPath().toUserOutput()
+                                           : m_binary.toUserOutput();
+        m_building = false;
+        reportFailure(tr("Could not start %1: %2").arg(program, m_process.errorString()));
+    });
+}
+
+void ProfileRunner::start()
+{
+    const ProjectExplorer::Runnable &runnable = runControl()->runnable();
+    const QFileInfo executable(runnable.executable.toString());
+    const QString directory = executable.absolutePath();
+    m_binary = Utils::FilePath::fromString(directory + QLatin1Char('/')
+            + Utils::HostOsInfo::withExecutableSuffix(executable.completeBaseName() + "-prof"));
+    m_profileFile = directory + QLatin1Char('/') + executable.completeBaseName() + ".profile.txt";
+    QFile::remove(m_profileFile);
+    QDir().mkpath(directory);
+
+    const QStringList arguments = {"-profile", m_profileFile, "-o", m_binary.toString(),
+                                   runControl()->project()->projectDirectory().toString()};
+    const QString compiler = VlangSettings::compilerPath().toString();
+    appendMessage(tr("Building %1 for profiling: %2 %3")
+                  .arg(runControl()->project()->displayName(), compiler, arguments.join(' '))
+                  + QLatin1Char('\n'), Utils::NormalMessageFormat);
+
+    m_building = true;
+    m_process.setWorkingDirectory(runControl()->project()->projectDirectory().toString());
+    m_process.start(compiler, arguments);
+    reportStarted();
+}
+
+void ProfileRunner::stop()
+{
+    if (m_process.state() == QProcess::NotRunning) {
+        reportStopped();
+        return;
+    }
+    m_building = false;
+    m_profileFile.clear();
+    m_process.kill();
+}
+
+void ProfileRunner::buildFinished(int exitCode, QProcess::ExitStatus status)
+{
+    m_building = false;
+    if (status != QProcess::NormalExit || exitCode != 0) {
+        reportFailure(tr("Building with -profile failed."));
+        return;
+    }
+
+    const ProjectExplorer::Runnable &runnable = runControl()->runnable();
+    appendMessage(tr("Starting %1").arg(m_binary.toUserOutput()) + QLatin1Char('\n'),
+                  Utils::NormalMessageFormat);
+    m_process.setProcessEnvironment(runnable.environment.toProcessEnvironment());
+    m_process.setWorkingDirectory(runnable.workingDirectory);
+    m_process.start(m_binary.toString(), Utils::QtcProcess::splitArgs(runnable.commandLineArguments));
+}
+
+void ProfileRunner::runFinished(int exitCode, QProcess::ExitStatus status)
+{
+    appendMessage(tr("%1 exited with code %2").arg(m_binary.toUserOutput()).arg(exitCode)
+                  + QLatin1Char('\n'), Utils::NormalMessageFormat);
+
+    // The profile is written on a regular exit only
+    QFile file(m_profileFile);
+    if (status == QProcess::NormalExit && !m_profileFile.isEmpty()
+            && file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        ProfileRun run;
+        run.projectName = runControl()->project()->displayName();
+        run.timestamp = QDateTime::currentDateTime();
+        run.entries = parseProfile(QString::fromUtf8(file.readAll()));
+        if (!run.entries.isEmpty())
+            Profiler::instance()->addRun(run);
+        else
+            appendMessage(tr("The profile is empty.") + QLatin1Char('\n'), Utils::ErrorMessageFormat);
+    }
+    reportStopped();
+}
+
+Profiler::Profiler()
+{
+    m_instance = this;
+}
+
+Profiler::~Profiler()
+{
+    qDeleteAll(m_marks);
+    m_instance = nullptr;
+}
+
+Profiler *Profiler::instance()
+{
+    return m_instance;
+}
+
+void Profiler::profileStartupProject()
+{
+    ProjectExplorer::ProjectExplorerPlugin::runStartupProject(Constants::C_PROFILE_RUN_MODE);
+}
+
+void Profiler::addRun(const ProfileRun &run)
+{
+    m_runs.append(run);
+    if (m_runs.size() > maxRuns)
+        m_runs.removeFirst();
+    updateMarks();
+    emit runAdded();
+}
+
+QPair<QString, int> Profiler::location(const QString &function)
+{
+    const FunctionName name = demangle(function);
+    const QString module = name.module.mid(name.module.lastIndexOf(QLatin1Char('.')) + 1);
+    for (const SymbolRef &ref : SymbolIndex::instance()->symbols(name.name)) {
+        const Symbol &symbol = ref.symbol();
+        if (symbol.kind != Symbol::Function && symbol.kind != Symbol::Method)
+            continue;
+        if (symbol.receiver != name.receiver)
+            continue;
+        if (!module.isEmpty() && ref.file->module != module)
+            continue;
+        return {ref.file->filePath, symbol.line};
+    }
+    return {QString(), 0};
+}
+
+void Profiler::updateMarks()
+{
+    qDeleteAll(m_marks);
+    m_marks.clear();
+    if (m_runs.isEmpty())
+        return;
+
+    const ProfileRun &run = m_runs.last();
+    const double total = run.totalMs();
+    if (total <= 0)
+        return;
+
+    for (const ProfileEntry &entry : run.entries) {
+        const double share = entry.totalMs / total;
+        if (share < hotShare || m_marks.size() == maxHotFunctions)
+            break;
+        const QPair<QString, int> declaration = location(entry.function);
+        if (declaration.second > 0)
+            m_marks.append(new ProfileMark(declaration.first, declaration.second, entry, share));
+    }
+}
+
+} // namespace Internal
+} // namespace Vcreator
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <projectexplorer/runcontrol.h>
+
+#include <QDateTime>
+#include <QObject>
+#include <QProcess>
+#include <QVector>
+
+namespace TextEditor { class TextMark; }
+
+namespace VCreator {
+namespace Internal {
+
+struct ProfileEntry
+{
+    QString function;       // C name as reported, "main__Foo_bar"
+    qint64 calls = 0;
+    double totalMs = 0;
+    double selfMs = -1;     // -1 when the V version does not report it
+    double averageNs = 0;
+};
+
+struct ProfileRun
+{
+    QString projectName;
+    QDateTime timestamp;
+    QVector<ProfileEntry> entries;
+
+    // Time of the outermost function, the instrumented time includes callees
+    double totalMs() const;
+    const ProfileEntry *entry(const QString &function) const;
+};
+
+// Parses the table a program built with "-profile <file>" writes on exit.
+QVector<ProfileEntry> parseProfile(const QString &text);
+
+struct FunctionName
+{
+    QString module;     // "net.http", empty for builtin
+    QString receiver;   // "Foo" for methods
+    QString name;
+
+    QString toString() const;
+};
+
+// "net__http__Request_do" -> net.http, Request, do
+FunctionName demangle(const QString &cName);
+
+// Builds the run configuration's project with -profile into a separate
+// binary next to the regular one, runs it like the run configuration
+// would and hands the parsed profile to the Profiler.
+class ProfileRunner : public ProjectExplorer::RunWorker
+{
+    Q_OBJECT
+
+public:
+    explicit ProfileRunner(ProjectExplorer::RunControl *runControl);
+
+    void start() override;
+    void stop() override;
+
+private:
+    void buildFinished(int exitCode, QProcess::ExitStatus status);
+    void runFinished(int exitCode, QProcess::ExitStatus status);
+
+    QProcess m_process;
+    Utils::FilePath m_binary;
+    QString m_profileFile;
+    bool m_building = false;
+};
+
+// Profile runs of the session, the latest one annotates its hot functions
+// in the editor. At most ten runs are kept for comparison.
+class Profiler : public QObject
+{
+    Q_OBJECT
+
+public:
+    Profiler();
+    ~Profiler() override;
+
+    static Profiler *instance();
+
+    static void profileStartupProject();
+
+    void addRun(const ProfileRun &run);
+    const QVector<ProfileRun> &runs() const { return m_runs; }
+
+    // Declaration of the profiled function in the symbol index, the line is
+    // 0 when it is not indexed.
+    static QPair<QString, int> location(const QString &function);
+
+signals:
+    void runAdded();
+
+private:
+    void updateMarks();
+
+    QVector<ProfileRun> m_runs;
+    QVector<TextEditor::TextMark *> m_marks;
+};
+
+} // namespace Internal
+} // namespace Vcreator
@@ -0,0 +1,281 @@
+#include "vcreatorprofilerpane.h"
+#include "vcreatorprofiler.h"
+#include "vcreatorsources.h"
+
+#include <utils/utilsicons.h>
+
+#include <QComboBox>
+#include <QHeaderView>
+#include <QLabel>
+#include <QLocale>
+#include <QToolButton>
+#include <QTreeWidget>
+#include <QVBoxLayout>
+
+namespace VCreator {
+namespace Internal {
+
+enum ItemRole {
+    SortRole = Qt::UserRole,
+    FunctionRole
+};
+
+enum Column {
+    FunctionColumn,
+    CallsColumn,
+    TotalColumn,
+    SelfColumn,
+    AverageColumn,
+    BaselineCallsColumn,
+    BaselineTotalColumn,
+    ChangeColumn,
+    ColumnCount
+};
+
+// Numeric columns sort by value, not by text
+class ProfileItem : public QTreeWidgetItem
+{
+public:
+    using QTreeWidgetItem::QTreeWidgetItem;
+
+    bool operator<(const QTreeWidgetItem &other) const override
+    {
+        const int column = treeWidget() ? treeWidget()->sortColumn() : FunctionColumn;
+        const QVariant value = data(column, SortRole);
+        const QVariant otherValue = other.data(column, SortRole);
+        if (value.isValid() && otherValue.isValid())
+            return value.toDouble() < otherValue.toDouble();
+        return QTreeWidgetItem::operator<(other);
+    }
+
+    void setNumber(int column, double value, const QString &text)
+    {
+        setText(column, text);
+        setData(column, SortRole, value);
+        setTextAlignment(column, Qt::AlignRight | Qt::AlignVCenter);
+    }
+};
+
+static QString formatMs(double milliseconds)
+{
+    return ProfilerPane::tr("%1 ms").arg(milliseconds, 0, 'f', milliseconds < 10 ? 3 : 1);
+}
+
+ProfilerPane::ProfilerPane()
+    : m_widget(new QWidget)
+    , m_layout(new QVBoxLayout(m_widget))
+    , m_profileButton(new QToolButton)
+    , m_baseline(new QComboBox)
+    , m_summary(new QLabel)
+{
+    m_layout->setContentsMargins(0, 0, 0, 0);
+
+    m_profileButton->setIcon(Utils::Icons::RUN_SMALL_TOOLBAR.icon());
+    m_profileButton->setToolTip(tr("Profile V Application"));
+    connect(m_profileButton, &QToolButton::clicked, this, &Profiler::profileStartupProject);
+
+    m_baseline->setToolTip(tr("Compare with an earlier run"));
+    m_baseline->setSizeAdjustPolicy(QComboBox::AdjustToContents);
+    m_baseline->setEnabled(false);
+}
+
+ProfilerPane::~ProfilerPane()
+{
+    delete m_widget;
+}
+
+void ProfilerPane::attach(Profiler *profiler)
+{
+    m_tree = new QTreeWidget;
+    m_layout->addWidget(m_tree);
+    m_tree->setColumnCount(ColumnCount);
+    m_tree->setHeaderLabels({tr("Function"), tr("Calls"), tr("Total"), tr("Self"), tr("Average"),
+                             tr("Baseline Calls"), tr("Baseline Total"), tr("Change")});
+    m_tree->setRootIsDecorated(false);
+    m_tree->setFrameStyle(QFrame::NoFrame);
+    m_tree->setUniformRowHeights(true);
+    m_tree->setSortingEnabled(true);
+    m_tree->sortByColumn(TotalColumn, Qt::DescendingOrder);
+    m_tree->header()->setStretchLastSection(false);
+    m_tree->header()->setSectionResizeMode(QHeaderView::ResizeToContents);
+    m_tree->header()->setSectionResizeMode(FunctionColumn, QHeaderView::Stretch);
+
+    connect(m_tree, &QTreeWidget::itemActivated, this, [](QTreeWidgetItem *item) {
+        const QPair<QString, int> location
+                = Profiler::location(item->data(FunctionColumn, FunctionRole).toString());
+        if (location.second > 0)
+            openEditorAt(location.first, location.second);
+    });
+
+    connect(m_baseline, QOverload<int>::of(&QComboBox::currentIndexChanged),
+            this, &ProfilerPane::updateTable);
+    connect(profiler, &Profiler::runAdded, this, &ProfilerPane::runAdded);
+
+    updateBaselines();
+    updateTable();
+}
+
+QWidget *ProfilerPane::outputWidget(QWidget *parent)
+{
+    m_widget->setParent(parent);
+    return m_widget;
+}
+
+QList<QWidget *> ProfilerPane::toolBarWidgets() const
+{
+    return {m_profileButton, m_baseline, m_summary};
+}
+
+QString ProfilerPane::displayName() const
+{
+    return tr("V Profile");
+}
+
+int ProfilerPane::priorityInStatusBar() const
+{
+    return 5;
+}
+
+void ProfilerPane::clearContents()
+{
+    if (m_tree)
+        m_tree->clear();
+    m_summary->clear();
+}
+
+void ProfilerPane::visibilityChanged(bool visible)
+{
+    Q_UNUSED(visible)
+}
+
+void ProfilerPane::setFocus()
+{
+    if (m_tree)
+        m_tree->setFocus();
+}
+
+bool ProfilerPane::hasFocus() const
+{
+    return m_tree && m_tree->hasFocus();
+}
+
+bool ProfilerPane::canFocus() const
+{
+    return true;
+}
+
+bool ProfilerPane::canNavigate() const
+{
+    return true;
+}
+
+bool ProfilerPane::canNext() const
+{
+    return m_tree && m_tree->topLevelItemCount() > 0;
+}
+
+bool ProfilerPane::canPrevious() const
+{
+    return m_tree && m_tree->topLevelItemCount() > 0;
+}
+
+void ProfilerPane::goToNext()
+{
+    if (!m_tree)
+        return;
+    QTreeWidgetItem *item = m_tree->currentItem();
+    item = item ? m_tree->itemBelow(item) : m_tree->topLevelItem(0);
+    if (item) {
+        m_tree->setCurrentItem(item);
+        emit m_tree->itemActivated(item, FunctionColumn);
+    }
+}
+
+void ProfilerPane::goToPrev()
+{
+    if (!m_tree)
+        return;
+    QTreeWidgetItem *item = m_tree->currentItem();
+    item = item ? m_tree->itemAbove(item) : m_tree->topLevelItem(0);
+    if (item) {
+        m_tree->setCurrentItem(item);
+        emit m_tree->itemActivated(item, FunctionColumn);
+    }
+}
+
+void ProfilerPane::runAdded()
+{
+    updateBaselines();
+    updateTable();
+    popup(NoModeSwitch);
+}
+
+// Every run but the latest can be the baseline, the previous one is preselected
+void ProfilerPane::updateBaselines()
+{
+    const QVector<ProfileRun> &runs = Profiler::instance()->runs();
+
+    QSignalBlocker blocker(m_baseline);
+    m_baseline->clear();
+    m_baseline->addItem(tr("No Comparison"), -1);
+    for (int i = runs.size() - 2; i >= 0; --i) {
+        m_baseline->addItem(tr("Compare with %1 at %2")
+                            .arg(runs.at(i).projectName,
+                                 QLocale().toString(runs.at(i).timestamp, QLocale::ShortFormat)), i);
+    }
+    m_baseline->setCurrentIndex(runs.size() > 1 ? 1 : 0);
+    m_baseline->setEnabled(runs.size() > 1);
+}
+
+void ProfilerPane::updateTable()
+{
+    m_tree->clear();
+    const QVector<ProfileRun> &runs = Profiler::instance()->runs();
+    if (runs.isEmpty()) {
+        m_summary->setText(tr("No profile yet"));
+        return;
+    }
+
+    const ProfileRun &run = runs.last();
+    const int baselineIndex = m_baseline->currentData().toInt();
+    const ProfileRun *baseline = baselineIndex >= 0 ? &runs.at(baselineIndex) : nullptr;
+    for (int column = BaselineCallsColumn; column <= ChangeColumn; ++column)
+        m_tree->setColumnHidden(column, !baseline);
+
+    bool hasSelfTime = false;
+    m_tree->setSortingEnabled(false);
+    for (const ProfileEntry &entry : run.entries) {
+        auto item = new ProfileItem(m_tree);
+        item->setText(FunctionColumn, demangle(entry.function).toString());
+        item->setToolTip(FunctionColumn, entry.function);
+        item->setData(FunctionColumn, FunctionRole, entry.function);
+        item->setNumber(CallsColumn, entry.calls, QString::number(entry.calls));
+        item->setNumber(TotalColumn, entry.totalMs, formatMs(entry.totalMs));
+        if (entry.selfMs >= 0) {
+            item->setNumber(SelfColumn, entry.selfMs, formatMs(entry.selfMs));
+            hasSelfTime = true;
+        }
+        item->setNumber(AverageColumn, entry.averageNs, tr("%1 ns").arg(entry.averageNs, 0, 'f', 0));
+
+        if (!baseline)
+            continue;
+        if (const ProfileEntry *before = baseline->entry(entry.function)) {
+            item->setNumber(BaselineCallsColumn, before->calls, QString::number(before->calls));
+            item->setNumber(BaselineTotalColumn, before->totalMs, formatMs(before->totalMs));
+            if (before->totalMs > 0) {
+                const double change = (entry.totalMs - before->totalMs) / before->totalMs * 100;
+                item->setNumber(ChangeColumn, change, tr("%1%").arg(change, 0, 'f', 1));
+            }
+        } else {
+            item->setText(ChangeColumn, tr("new"));
+        }
+    }
+    m_tree->setColumnHidden(SelfColumn, !hasSelfTime);
+    m_tree->setSortingEnabled(true);
+
+    m_summary->setText(tr("%1: %2 in %n functions", nullptr, run.entries.size())
+                       .arg(run.projectName, formatMs(run.totalMs())));
+}
+
+} // namespace Internal
+} // namespace Vcreator
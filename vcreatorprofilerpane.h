@@ -0,0 +1,61 @@
+#pragma once
+
+#include <coreplugin/ioutputpane.h>
+
+QT_BEGIN_NAMESPACE
+class QComboBox;
+class QLabel;
+class QToolButton;
+class QTreeWidget;
+class QVBoxLayout;
+QT_END_NAMESPACE
+
+namespace VCreator {
+namespace Internal {
+
+class Profiler;
+
+// Sortable table of the latest profile run. Another run can be picked as
+// baseline, its calls and total time are then shown next to the latest
+// ones together with the change.
+class ProfilerPane : public Core::IOutputPane
+{
+    Q_OBJECT
+
+public:
+    ProfilerPane();
+    ~ProfilerPane() override;
+
+    // Builds the table and follows profiler, on first V use
+    void attach(Profiler *profiler);
+
+    QWidget *outputWidget(QWidget *parent) override;
+    QList<QWidget *> toolBarWidgets() const override;
+    QString displayName() const override;
+    int priorityInStatusBar() const override;
+    void clearContents() override;
+    void visibilityChanged(bool visible) override;
+    void setFocus() override;
+    bool hasFocus() const override;
+    bool canFocus() const override;
+    bool canNavigate() const override;
+    bool canNext() const override;
+    bool canPrevious() const override;
+    void goToNext() override;
+    void goToPrev() override;
+
+private:
+    void runAdded();
+    void updateBaselines();
+    void updateTable();
+
+    QWidget *m_widget;
+    QVBoxLayout *m_layout;
+    QTreeWidget *m_tree = nullptr;
+    QToolButton *m_profileButton;
+    QComboBox *m_baseline;
+    QLabel *m_summary;
+};
+
+} // namespace Internal
+} // namespace Vcreator
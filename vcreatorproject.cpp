@@ -1,5 +1,8 @@
 #include "vcreatorproject.h"
 #include "vcreatorconstants.h"
+#include "vcreatorplugin.h"
+#include "vcreatorsources.h"
+#include "vcreatorsymbolindex.h"
 #include "ide.h"
 
 #include <projectexplorer/buildsystem.h>
@@ -98,10 +101,21 @@ public:
         connect(&m_treeScanner, &ProjectExplorer::TreeScanner::finished, this, [this, target] {
             auto root = std::make_unique<ProjectExplorer::ProjectNode>(projectDirectory());
             root->setDisplayName(target->project()->displayName());
+            QSet<QString> sourceFiles;
             std::vector<std::unique_ptr<ProjectExplorer::FileNode>> nodePtrs
-                = Utils::transform<std::vector>(m_treeScanner.release(), [](ProjectExplorer::FileNode *fn) {
+                = Utils::transform<std::vector>(m_treeScanner.release(), [&sourceFiles](ProjectExplorer::FileNode *fn) {
+                      if (isVlangSourceFile(fn->filePath().toString()))
+                          sourceFiles.insert(fn->filePath().toString());
                       return std::unique_ptr<ProjectExplorer::FileNode>(fn);
                   });
+            updateIndex(sourceFiles);
+
+            ProjectExplorer::BuildTargetInfo targetInfo;
+            targetInfo.buildKey = projectFilePath().toString();
+            targetInfo.displayName = target->project()->displayName();
+            targetInfo.projectFilePath = projectFilePath();
+            setApplicationTargets({targetInfo});
+
             root->addNestedNodes(std::move(nodePtrs));
             setRootProjectNode(std::move(root));
 
@@ -118,6 +132,13 @@ public:
 
         requestDelayedParse();
     }
+
+    ~BuildSystem() override
+    {
+        if (SymbolIndex *index = SymbolIndex::instance())
+            index->releaseOwner(this);
+    }
+
     bool supportsAction(ProjectExplorer::Node *context, ProjectExplorer::ProjectAction action, const ProjectExplorer::Node *node) const override {
         if (node->asFileNode()) {
             return action == ProjectExplorer::ProjectAction::Rename
@@ -163,6 +184,11 @@ public:
     }
 
 private:
+    void updateIndex(const QSet<QString> &sourceFiles)
+    {
+        SymbolIndex::instance()->setOwnerFiles(this, sourceFiles);
+    }
+
     QHash<QString, bool> m_mimeBinaryCache;
     ProjectExplorer::TreeScanner m_treeScanner;
     ParseGuard m_parseGuard;
@@ -171,13 +197,12 @@ private:
 VlangProject::VlangProject(const Utils::FilePath &filename)
     : ProjectExplorer::Project(Constants::C_VLANG_PROJECT_MIMETYPE, filename)
 {
+    Plugin::ensureLanguageSupport();
     setId(Constants::C_VLANG_PROJECT_ID);
     ManifestParser manifest;
     manifest.parse(filename);
     setDisplayName(manifest.name);
 
-    setNeedsBuildConfigurations(false);
-
     setBuildSystemCreator([](ProjectExplorer::Target *t) { return new BuildSystem(t); });
 }
 
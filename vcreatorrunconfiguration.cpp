@@ -0,0 +1,45 @@
+#include "vcreatorrunconfiguration.h"
+#include "vcreatorbuildconfiguration.h"
+#include "vcreatorconstants.h"
+
+#include <projectexplorer/localenvironmentaspect.h>
+#include <projectexplorer/project.h>
+#include <projectexplorer/projectexplorerconstants.h>
+#include <projectexplorer/runconfigurationaspects.h>
+#include <projectexplorer/target.h>
+
+using namespace ProjectExplorer;
+
+namespace VCreator {
+namespace Internal {
+
+VlangRunConfiguration::VlangRunConfiguration(Target *target, Utils::Id id)
+    : RunConfiguration(target, id)
+{
+    addAspect<LocalEnvironmentAspect>(target);
+    addAspect<ExecutableAspect>();
+    addAspect<ArgumentsAspect>();
+    auto workingDirectory = addAspect<WorkingDirectoryAspect>();
+    workingDirectory->setDefaultWorkingDirectory(target->project()->projectDirectory());
+    addAspect<TerminalAspect>();
+
+    setDefaultDisplayName(tr("Run %1").arg(target->project()->displayName()));
+
+    setUpdater([this, target] {
+        auto bc = qobject_cast<VlangBuildConfiguration *>(target->activeBuildConfiguration());
+        aspect<ExecutableAspect>()->setExecutable(bc ? bc->executable() : Utils::FilePath());
+    });
+
+    connect(target, &Target::buildSystemUpdated, this, &RunConfiguration::update);
+    connect(target, &Target::activeBuildConfigurationChanged, this, &RunConfiguration::update);
+}
+
+VlangRunConfigurationFactory::VlangRunConfigurationFactory()
+{
+    registerRunConfiguration<VlangRunConfiguration>(Constants::C_VLANG_RUNCONFIGURATION_ID);
+    addSupportedProjectType(Constants::C_VLANG_PROJECT_ID);
+    addSupportedTargetDeviceType(ProjectExplorer::Constants::DESKTOP_DEVICE_TYPE);
+}
+
+} // namespace Internal
+} // namespace Vcreator
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <projectexplorer/runconfiguration.h>
+
+namespace VCreator {
+namespace Internal {
+
+class VlangRunConfiguration : public ProjectExplorer::RunConfiguration
+{
+    Q_OBJECT
+
+public:
+    VlangRunConfiguration(ProjectExplorer::Target *target, Utils::Id id);
+};
+
+class VlangRunConfigurationFactory : public ProjectExplorer::RunConfigurationFactory
+{
+public:
+    VlangRunConfigurationFactory();
+};
+
+} // namespace Internal
+} // namespace Vcreator
@@ -0,0 +1,492 @@
+#include "vcreatorsemantichighlighter.h"
+#include "vcreatorlexer.h"
+#include "vcreatorsymbolindex.h"
+#include "vcreatorvls.h"
+
+#include <languageclient/client.h>
+#include <texteditor/fontsettings.h>
+#include <texteditor/syntaxhighlighter.h>
+#include <texteditor/textdocument.h>
+#include <texteditor/texteditor.h>
+#include <texteditor/texteditorsettings.h>
+#include <utils/runextensions.h>
+
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QPointer>
+#include <QTextBlock>
+
+#include <algorithm>
+#include <iterator>
+
+using namespace TextEditor;
+
+namespace VCreator {
+namespace Internal {
+
+static int kindForSymbol(const Symbol &symbol)
+{
+    switch (symbol.kind) {
+    case Symbol::Struct:
+    case Symbol::Enum:
+    case Symbol::Interface:
+    case Symbol::TypeAlias:
+        return VlangSemanticHighlighter::Type;
+    case Symbol::EnumValue:
+        return VlangSemanticHighlighter::EnumValue;
+    case Symbol::Constant:
+    case Symbol::Global:
+        return VlangSemanticHighlighter::Constant;
+    default:
+        return -1;
+    }
+}
+
+static int kindForTokenType(const QString &type)
+{
+    static const QHash<QString, int> kinds = {
+        {"type", VlangSemanticHighlighter::Type},
+        {"class", VlangSemanticHighlighter::Type},
+        {"struct", VlangSemanticHighlighter::Type},
+        {"enum", VlangSemanticHighlighter::Type},
+        {"interface", VlangSemanticHighlighter::Type},
+        {"typeParameter", VlangSemanticHighlighter::Type},
+        {"enumMember", VlangSemanticHighlighter::EnumValue},
+        {"function", VlangSemanticHighlighter::Function},
+        {"method", VlangSemanticHighlighter::Function},
+        {"property", VlangSemanticHighlighter::Field},
+        {"parameter", VlangSemanticHighlighter::Parameter},
+        {"variable", VlangSemanticHighlighter::Local},
+    };
+    return kinds.value(type, -1);
+}
+
+// Legend of the server's semantic tokens, empty when it provides none.
+static QJsonObject semanticTokensLegend(const LanguageClient::Client *client)
+{
+    const QJsonObject capabilities = client->capabilities();
+    return capabilities.value("semanticTokensProvider").toObject().value("legend").toObject();
+}
+
+static bool supportsSemanticTokensDelta(const LanguageClient::Client *client)
+{
+    const QJsonObject capabilities = client->capabilities();
+    const QJsonValue full = capabilities.value("semanticTokensProvider").toObject().value("full");
+    return full.toObject().value("delta").toBool();
+}
+
+static QVector<int> toIntVector(const QJsonArray &array)
+{
+    QVector<int> result;
+    result.reserve(array.size());
+    for (const QJsonValue &value : array)
+        result.append(value.toInt());
+    return result;
+}
+
+// Edits refer to positions in the unedited data and must not overlap
+static QVector<int> applySemanticTokensEdits(const QVector<int> &data, const QJsonArray &edits)
+{
+    struct Edit
+    {
+        int start;
+        int deleteCount;
+        QJsonArray data;
+    };
+    QVector<Edit> sorted;
+    sorted.reserve(edits.size());
+    for (const QJsonValue &value : edits) {
+        const QJsonObject edit = value.toObject();
+        sorted.append({edit.value("start").toInt(), edit.value("deleteCount").toInt(),
+                       edit.value("data").toArray()});
+    }
+    std::sort(sorted.begin(), sorted.end(), [](const Edit &a, const Edit &b) {
+        return a.start < b.start;
+    });
+
+    QVector<int> result;
+    result.reserve(data.size());
+    int copied = 0;
+    for (const Edit &edit : qAsConst(sorted)) {
+        const int start = qBound(copied, edit.start, data.size());
+        std::copy(data.cbegin() + copied, data.cbegin() + start, std::back_inserter(result));
+        for (const QJsonValue &value : edit.data)
+            result.append(value.toInt());
+        copied = qMin(data.size(), start + qMax(0, edit.deleteCount));
+    }
+    std::copy(data.cbegin() + copied, data.cend(), std::back_inserter(result));
+    return result;
+}
+
+static QHash<int, QVector<SemanticRange>> decodeSemanticTokens(const QVector<int> &data,
+                                                              const QJsonObject &legend)
+{
+    QVector<int> kinds;
+    for (const QJsonValue &type : legend.value("tokenTypes").toArray())
+        kinds.append(kindForTokenType(type.toString()));
+
+    QHash<int, QVector<SemanticRange>> result;
+    int line = 0;
+    int column = 0;
+    for (int i = 0; i + 4 < data.size(); i += 5) {
+        const int deltaLine = data.at(i);
+        line += deltaLine;
+        column = deltaLine ? data.at(i + 1) : column + data.at(i + 1);
+        const int kind = kinds.value(data.at(i + 3), -1);
+        if (kind >= 0)
+            result[line + 1].append({column, data.at(i + 2), kind});
+    }
+    return result;
+}
+
+static void highlightIdentifiers(QFutureInterface<SemanticLine> &futureInterface,
+                                 const QString &text,
+                                 const QString &filePath,
+                                 int firstVisibleLine,
+                                 int lastVisibleLine)
+{
+    const SourceTokens source(text);
+    const QVector<Token> &tokens = source.tokens();
+    const SymbolIndex *index = SymbolIndex::instance();
+
+    // Unqualified names resolve the same everywhere in the file
+    QHash<QString, int> unqualifiedKinds;
+    const auto kindOf = [&](int i) {
+        const QString name = source.textOf(tokens.at(i)).toString();
+        const bool qualified = i > 0 && tokens.at(i - 1).is(Token::Dot);
+        if (!qualified) {
+            const auto it = unqualifiedKinds.constFind(name);
+            if (it != unqualifiedKinds.constEnd())
+                return *it;
+        }
+
+        QString qualifier;
+        if (qualified && i > 1 && tokens.at(i - 2).is(Token::Identifier)
+                && tokens.at(i - 2).end() == tokens.at(i - 1).begin()) {
+            qualifier = source.textOf(tokens.at(i - 2)).toString();
+        }
+        const QVector<SymbolRef> symbols = index->resolve(filePath, qualifier, name, qualified);
+        // Member access on values only colors enum values, not fields
+        int kind = -1;
+        if (!symbols.isEmpty()) {
+            kind = kindForSymbol(symbols.first().symbol());
+            if (qualified && qualifier.isEmpty() && kind != VlangSemanticHighlighter::EnumValue)
+                kind = -1;
+        }
+        if (!qualified)
+            unqualifiedKinds.insert(name, kind);
+        return kind;
+    };
+
+    // Group identifier tokens by line, the visible lines go first
+    QVector<QVector<int>> lines(source.lineCount() + 1);
+    for (int i = 0; i < tokens.size(); ++i) {
+        if (tokens.at(i).is(Token::Identifier))
+            lines[source.lineAt(tokens.at(i).offset)].append(i);
+    }
+    QVector<int> order;
+    order.reserve(source.lineCount());
+    for (int line = firstVisibleLine; line <= lastVisibleLine && line <= source.lineCount(); ++line)
+        order.append(line);
+    const int visibleCount = order.size();
+    for (int line = 1; line <= source.lineCount(); ++line) {
+        if (line < firstVisibleLine || line > lastVisibleLine)
+            order.append(line);
+    }
+
+    QVector<SemanticLine> batch;
+    for (int k = 0; k < order.size(); ++k) {
+        if (futureInterface.isCanceled())
+            return;
+        const int line = order.at(k);
+        if (lines.at(line).isEmpty()) {
+            if (k + 1 == visibleCount && !batch.isEmpty()) {
+                futureInterface.reportResults(batch);
+                batch.clear();
+            }
+            continue;
+        }
+
+        SemanticLine result;
+        result.line = line;
+        for (const int i : lines.at(line)) {
+            const int kind = kindOf(i);
+            if (kind >= 0) {
+                result.ranges.append({tokens.at(i).offset - source.lineStart(line),
+                                      tokens.at(i).length, kind});
+            }
+        }
+        batch.append(result);
+        if (batch.size() == 100 || k + 1 == visibleCount) {
+            futureInterface.reportResults(batch);
+            batch.clear();
+        }
+    }
+    if (!batch.isEmpty())
+        futureInterface.reportResults(batch);
+}
+
+VlangSemanticHighlighter::VlangSemanticHighlighter(TextEditorWidget *editor)
+    : QObject(editor)
+    , m_editor(editor)
+{
+    m_timer.setSingleShot(true);
+    m_timer.setInterval(300);
+    connect(&m_timer, &QTimer::timeout, this, &VlangSemanticHighlighter::run);
+
+    connect(&m_watcher, &QFutureWatcherBase::resultsReadyAt,
+            this, &VlangSemanticHighlighter::applyResults);
+    connect(&m_watcher, &QFutureWatcherBase::finished, this, &VlangSemanticHighlighter::finish);
+
+    m_serverRequests = new RequestCoalescer(100, this);
+    connect(VlsManager::instance(), &VlsManager::clientInitialized,
+            this, &VlangSemanticHighlighter::scheduleUpdate);
+
+    connect(editor->textDocument(), &IDocument::contentsChanged,
+            this, &VlangSemanticHighlighter::scheduleUpdate);
+    connect(SymbolIndex::instance(), &SymbolIndex::filesIndexed,
+            this, &VlangSemanticHighlighter::scheduleUpdate);
+    connect(TextEditorSettings::instance(), &TextEditorSettings::fontSettingsChanged, this, [this] {
+        updateFormats();
+        m_applied.clear();
+        scheduleUpdate();
+    });
+
+    updateFormats();
+    scheduleUpdate();
+}
+
+VlangSemanticHighlighter::~VlangSemanticHighlighter()
+{
+    if (!m_requestKey.isEmpty())
+        m_serverRequests->cancel(m_requestKey);
+    m_watcher.cancel();
+    m_watcher.waitForFinished();
+}
+
+void VlangSemanticHighlighter::scheduleUpdate()
+{
+    m_watcher.cancel();
+    m_timer.start();
+}
+
+void VlangSemanticHighlighter::updateFormats()
+{
+    const FontSettings &fontSettings = TextEditorSettings::fontSettings();
+    m_formats.insert(Type, fontSettings.toTextCharFormat(C_TYPE));
+    m_formats.insert(EnumValue, fontSettings.toTextCharFormat(C_ENUMERATION));
+    m_formats.insert(Constant, fontSettings.toTextCharFormat(C_GLOBAL));
+    m_formats.insert(Function, fontSettings.toTextCharFormat(C_FUNCTION));
+    m_formats.insert(Field, fontSettings.toTextCharFormat(C_FIELD));
+    m_formats.insert(Parameter, fontSettings.toTextCharFormat(C_PARAMETER));
+    m_formats.insert(Local, fontSettings.toTextCharFormat(C_LOCAL));
+    // Extra formats are told apart from the syntactic ones by this property
+    for (QTextCharFormat &format : m_formats)
+        format.setProperty(QTextFormat::UserProperty, true);
+}
+
+void VlangSemanticHighlighter::run()
+{
+    m_watcher.cancel();
+    m_watcher.waitForFinished();
+
+    m_revision = m_editor->document()->revision();
+    m_reported.clear();
+    const QFuture<SemanticLine> future = Utils::runAsync(highlightIdentifiers,
+                                                         m_editor->document()->toPlainText(),
+                                                         m_editor->textDocument()->filePath().toString(),
+                                                         m_editor->firstVisibleBlockNumber() + 1,
+                                                         m_editor->lastVisibleBlockNumber() + 1);
+    m_watcher.setFuture(future);
+
+    requestServerTokens();
+}
+
+void VlangSemanticHighlighter::requestServerTokens()
+{
+    TextDocument *document = m_editor->textDocument();
+    LanguageClient::Client *client = VlsManager::instance()->clientForDocument(document);
+    if (!client || semanticTokensLegend(client).isEmpty())
+        return;
+
+    const QString key = document->filePath().toString();
+    if (key != m_requestKey && !m_requestKey.isEmpty()) {
+        m_serverRequests->cancel(m_requestKey);
+        m_resultId.clear();
+    }
+    m_requestKey = key;
+    const LanguageServerProtocol::DocumentUri uri
+            = LanguageServerProtocol::DocumentUri::fromFilePath(document->filePath());
+    const int revision = m_revision;
+    QPointer<VlangSemanticHighlighter> self(this);
+    m_serverRequests->schedule(client, key, [self, key, uri, revision](LanguageClient::Client *client) {
+        // The coalescer is owned by the highlighter, it cannot be gone here
+        const QString previousResultId = supportsSemanticTokensDelta(client) ? self->m_resultId
+                                                                             : QString();
+        QPointer<LanguageClient::Client> guardedClient(client);
+        const auto handleResponse = [self, key, revision, previousResultId, guardedClient](
+                const auto &response) {
+            if (!self || !guardedClient)
+                return;
+            self->m_serverRequests->finished(key, response.id());
+            if (const Utils::optional<SemanticTokensResult> result = response.result()) {
+                self->serverTokensReceived(revision, previousResultId, *result, guardedClient);
+            } else {
+                // E.g. the server forgot the previous result, start over
+                self->m_resultId.clear();
+            }
+        };
+
+        if (previousResultId.isEmpty()) {
+            SemanticTokensParams params;
+            params.setTextDocument(LanguageServerProtocol::TextDocumentIdentifier(uri));
+            SemanticTokensRequest request(params);
+            request.setResponseCallback(handleResponse);
+            client->sendContent(request);
+            return request.id();
+        }
+        SemanticTokensDeltaParams params;
+        params.setTextDocument(LanguageServerProtocol::TextDocumentIdentifier(uri));
+        params.setPreviousResultId(previousResultId);
+        SemanticTokensDeltaRequest request(params);
+        request.setResponseCallback(handleResponse);
+        client->sendContent(request);
+        return request.id();
+    });
+}
+
+void VlangSemanticHighlighter::serverTokensReceived(int revision, const QString &previousResultId,
+                                                    const SemanticTokensResult &result,
+                                                    LanguageClient::Client *client)
+{
+    // The data is kept even for an older revision, it is what the server's
+    // next delta refers to
+    if (result.isDelta()) {
+        if (previousResultId.isEmpty() || previousResultId != m_resultId) {
+            m_resultId.clear();
+            return;
+        }
+        m_serverData = applySemanticTokensEdits(m_serverData, result.edits());
+    } else {
+        m_serverData = toIntVector(result.data());
+    }
+    m_resultId = result.resultId();
+
+    applyServerTokens(revision, client);
+}
+
+void VlangSemanticHighlighter::applyServerTokens(int revision, LanguageClient::Client *client)
+{
+    // Tokens for an older revision would be placed at shifted positions
+    if (revision != m_editor->document()->revision())
+        return;
+
+    QHash<int, QVector<SemanticRange>> server = decodeSemanticTokens(m_serverData,
+                                                                     semanticTokensLegend(client));
+    QSet<int> lines;
+    for (auto it = m_server.cbegin(); it != m_server.cend(); ++it) {
+        if (server.value(it.key()) != *it)
+            lines.insert(it.key());
+    }
+    for (auto it = server.cbegin(); it != server.cend(); ++it) {
+        if (!m_server.contains(it.key()) || m_withoutServer.contains(it.key()))
+            lines.insert(it.key());
+    }
+    m_withoutServer.clear();
+
+    m_server = std::move(server);
+    m_serverRevision = revision;
+    for (const int line : qAsConst(lines))
+        applyLine(line);
+}
+
+void VlangSemanticHighlighter::applyResults(int begin, int end)
+{
+    // The document changed since the run started, a new one is scheduled
+    if (m_editor->document()->revision() != m_revision)
+        return;
+
+    for (int i = begin; i < end; ++i) {
+        const SemanticLine result = m_watcher.resultAt(i);
+        m_reported.insert(result.line);
+        if (result.ranges.isEmpty())
+            m_local.remove(result.line);
+        else
+            m_local.insert(result.line, result.ranges);
+        applyLine(result.line);
+    }
+}
+
+void VlangSemanticHighlighter::applyLine(int line)
+{
+    SyntaxHighlighter *highlighter = m_editor->textDocument()->syntaxHighlighter();
+    if (!highlighter)
+        return;
+
+    // Server ranges of the current revision, local ones fill the gaps
+    QVector<SemanticRange> ranges = m_local.value(line);
+    if (m_serverRevision != m_editor->document()->revision()) {
+        if (m_serverRevision >= 0)
+            m_withoutServer.insert(line);
+    } else {
+        const QVector<SemanticRange> server = m_server.value(line);
+        if (!server.isEmpty()) {
+            ranges.erase(std::remove_if(ranges.begin(), ranges.end(), [&server](const SemanticRange &local) {
+                return std::any_of(server.cbegin(), server.cend(), [&local](const SemanticRange &range) {
+                    return local.column < range.column + range.length
+                            && range.column < local.column + local.length;
+                });
+            }), ranges.end());
+            ranges += server;
+            std::sort(ranges.begin(), ranges.end(), [](const SemanticRange &a, const SemanticRange &b) {
+                return a.column < b.column;
+            });
+        }
+    }
+
+    auto applied = m_applied.find(line);
+    if (applied != m_applied.end() ? *applied == ranges : ranges.isEmpty())
+        return;
+
+    const QTextBlock block = m_editor->document()->findBlockByNumber(line - 1);
+    if (!block.isValid()) {
+        m_applied.remove(line);
+        return;
+    }
+
+    QVector<QTextLayout::FormatRange> formats;
+    formats.reserve(ranges.size());
+    for (const SemanticRange &range : qAsConst(ranges)) {
+        QTextLayout::FormatRange format;
+        format.start = range.column;
+        format.length = range.length;
+        format.format = m_formats.value(range.kind);
+        formats.append(format);
+    }
+    highlighter->setExtraFormats(block, std::move(formats));
+
+    if (ranges.isEmpty())
+        m_applied.remove(line);
+    else
+        m_applied.insert(line, ranges);
+}
+
+void VlangSemanticHighlighter::finish()
+{
+    if (m_watcher.isCanceled() || m_editor->document()->revision() != m_revision)
+        return;
+
+    // Lines without identifiers anymore still carry the formats of a previous run
+    QVector<int> stale;
+    for (auto it = m_applied.cbegin(); it != m_applied.cend(); ++it) {
+        if (!m_reported.contains(it.key()))
+            stale.append(it.key());
+    }
+    for (const int line : qAsConst(stale)) {
+        m_local.remove(line);
+        applyLine(line);
+    }
+}
+
+} // namespace Internal
+} // namespace Vcreator
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <QFutureWatcher>
+#include <QHash>
+#include <QObject>
+#include <QSet>
+#include <QTextCharFormat>
+#include <QTimer>
+#include <QVector>
+
+namespace LanguageClient { class Client; }
+namespace TextEditor { class TextEditorWidget; }
+
+namespace VCreator {
+namespace Internal {
+
+struct SemanticRange
+{
+    int column = 0;
+    int length = 0;
+    int kind = 0;
+
+    bool operator==(const SemanticRange &other) const
+    { return column == other.column && length == other.length && kind == other.kind; }
+};
+
+struct SemanticLine
+{
+    int line = 0; // 1-based
+    QVector<SemanticRange> ranges;
+};
+
+class RequestCoalescer;
+class SemanticTokensResult;
+
+// Colors identifiers that resolve to project types, enum values and
+// constants. Resolution runs on a worker thread, lines in the visible range
+// are reported first and applied as extra formats block by block, so the
+// syntax highlighter never rehighlights the document for it.
+//
+// When VLS provides semantic tokens they are layered on top: a server range
+// wins over a local one it overlaps. Server results only count for the
+// document revision they were requested for, while the server lags behind
+// the local results are shown alone. Servers supporting deltas only send
+// the changes to their previous tokens, and only lines whose server ranges
+// changed are applied again.
+class VlangSemanticHighlighter : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum Kind {
+        Type,
+        EnumValue,
+        Constant,
+        Function,
+        Field,
+        Parameter,
+        Local
+    };
+
+    explicit VlangSemanticHighlighter(TextEditor::TextEditorWidget *editor);
+    ~VlangSemanticHighlighter() override;
+
+    void scheduleUpdate();
+
+private:
+    void run();
+    void requestServerTokens();
+    void serverTokensReceived(int revision, const QString &previousResultId,
+                              const SemanticTokensResult &result, LanguageClient::Client *client);
+    void applyServerTokens(int revision, LanguageClient::Client *client);
+    void updateFormats();
+    void applyResults(int begin, int end);
+    void applyLine(int line);
+    void finish();
+
+    TextEditor::TextEditorWidget *m_editor;
+    QTimer m_timer;
+    QFutureWatcher<SemanticLine> m_watcher;
+    int m_revision = -1;
+    QHash<int, QTextCharFormat> m_formats;
+    QHash<int, QVector<SemanticRange>> m_local;
+    QHash<int, QVector<SemanticRange>> m_server;
+    int m_serverRevision = -1;
+    // Undecoded tokens of the server's latest result, the base of a delta
+    QVector<int> m_serverData;
+    QString m_resultId;
+    // Lines applied while the server lagged behind, without its ranges
+    QSet<int> m_withoutServer;
+    QHash<int, QVector<SemanticRange>> m_applied;
+    QSet<int> m_reported;
+    RequestCoalescer *m_serverRequests;
+    // The editor's document is already gone when the highlighter is destroyed
+    QString m_requestKey;
+};
+
+} // namespace Internal
+} // namespace Vcreator
@@ -2,6 +2,9 @@
 #include "vcreatorconstants.h"
 #include "vcreatorindenter.h"
 #include "vcreatorhighlighter.h"
+#include "vcreatorplugin.h"
+#include "vcreatortoolchain.h"
+#include "vcreatorvls.h"
 
 #include <texteditor/simplecodestylepreferences.h>
 #include <texteditor/simplecodestylepreferenceswidget.h>
@@ -21,7 +24,9 @@
 #include <QVBoxLayout>
 #include <QGroupBox>
 #include <QLabel>
+#include <QCheckBox>
 #include <QFormLayout>
+#include <QSpinBox>
 #include <utils/pathchooser.h>
 
 using namespace TextEditor;
@@ -31,10 +36,25 @@ namespace Internal {
 
 static SimpleCodeStylePreferences *m_globalCodeStyle = nullptr;
 
+static const char compilerPathKey[] = "CompilerPath";
+static const char testConcurrencyKey[] = "TestConcurrency";
+static const char formatOnSaveKey[] = "FormatOnSave";
+static const char formatTimeoutKey[] = "FormatTimeout";
+static const char useLanguageServerKey[] = "UseLanguageServer";
+static const char languageServerPathKey[] = "LanguageServerPath";
+
 class SettingsWidget final : public QWidget {
 public:
     explicit SettingsWidget(QWidget *parent = nullptr);
 
+    Utils::FilePath path() const { return pathWidget->filePath(); }
+    void updateToolchainInfo();
+    int testConcurrency() const { return testConcurrencyWidget->value(); }
+    bool formatOnSave() const { return formatOnSaveWidget->isChecked(); }
+    int formatTimeout() const { return formatTimeoutWidget->value(); }
+    bool useLanguageServer() const { return languageServerGroupBox->isChecked(); }
+    Utils::FilePath languageServerPath() const { return languageServerPathWidget->filePath(); }
+
 private:
 
     QGroupBox *groupBox;
@@ -43,6 +63,17 @@ private:
     QFormLayout *formLayout;
     QLabel *pathLabel;
     Utils::PathChooser *pathWidget;
+    QLabel *toolchainLabel;
+    QGroupBox *testGroupBox;
+    QFormLayout *testFormLayout;
+    QSpinBox *testConcurrencyWidget;
+    QGroupBox *formatGroupBox;
+    QFormLayout *formatFormLayout;
+    QCheckBox *formatOnSaveWidget;
+    QSpinBox *formatTimeoutWidget;
+    QGroupBox *languageServerGroupBox;
+    QFormLayout *languageServerFormLayout;
+    Utils::PathChooser *languageServerPathWidget;
     QSpacerItem *verticalSpacer;
 };
 
@@ -132,14 +163,22 @@ VlangSettings::VlangSettings(QObject *parent)
 
     m_globalCodeStyle->setCurrentDelegate(codeStyle);
 
+    TextEditorSettings::registerMimeTypeForLanguageId(Constants::C_VLANG_MIMETYPE,
+                                                      Constants::C_VLANGUAGE_ID);
+}
+
+void VlangSettings::loadCodeStyles()
+{
+    if (m_codeStylesLoaded)
+        return;
+    m_codeStylesLoaded = true;
+
+    CodeStylePool *pool = TextEditorSettings::codeStylePool(Constants::C_VLANGUAGE_ID);
     pool->loadCustomCodeStyles();
 
     // load global settings (after built-in settings are added to the pool)
     QSettings *s = Core::ICore::settings();
     m_globalCodeStyle->fromSettings(QLatin1String(Constants::C_VLANGUAGE_ID), s);
-
-    TextEditorSettings::registerMimeTypeForLanguageId(Constants::C_VLANG_MIMETYPE,
-                                                      Constants::C_VLANGUAGE_ID);
 }
 
 VlangSettings::~VlangSettings()
@@ -157,6 +196,86 @@ TextEditor::SimpleCodeStylePreferences *VlangSettings::globalCodeStyle()
     return m_globalCodeStyle;
 }
 
+static QVariant toolValue(const char *key, const QVariant &defaultValue = QVariant())
+{
+    QSettings *s = Core::ICore::settings();
+    s->beginGroup(Constants::C_VLANG_SETTINGS_GROUP);
+    const QVariant value = s->value(key, defaultValue);
+    s->endGroup();
+    return value;
+}
+
+static void setToolValue(const char *key, const QVariant &value)
+{
+    QSettings *s = Core::ICore::settings();
+    s->beginGroup(Constants::C_VLANG_SETTINGS_GROUP);
+    s->setValue(key, value);
+    s->endGroup();
+}
+
+Utils::FilePath VlangSettings::compilerPath()
+{
+    const QString path = toolValue(compilerPathKey).toString();
+    if (!path.isEmpty())
+        return Utils::FilePath::fromString(path);
+    return ToolchainManager::instance()->defaultCompiler();
+}
+
+void VlangSettings::setCompilerPath(const Utils::FilePath &path)
+{
+    setToolValue(compilerPathKey, path.toString());
+}
+
+int VlangSettings::testConcurrency()
+{
+    return toolValue(testConcurrencyKey, 0).toInt();
+}
+
+void VlangSettings::setTestConcurrency(int concurrency)
+{
+    setToolValue(testConcurrencyKey, concurrency);
+}
+
+bool VlangSettings::formatOnSave()
+{
+    return toolValue(formatOnSaveKey, false).toBool();
+}
+
+void VlangSettings::setFormatOnSave(bool formatOnSave)
+{
+    setToolValue(formatOnSaveKey, formatOnSave);
+}
+
+int VlangSettings::formatTimeout()
+{
+    return toolValue(formatTimeoutKey, 1000).toInt();
+}
+
+void VlangSettings::setFormatTimeout(int milliseconds)
+{
+    setToolValue(formatTimeoutKey, milliseconds);
+}
+
+bool VlangSettings::useLanguageServer()
+{
+    return toolValue(useLanguageServerKey, true).toBool();
+}
+
+void VlangSettings::setUseLanguageServer(bool use)
+{
+    setToolValue(useLanguageServerKey, use);
+}
+
+Utils::FilePath VlangSettings::languageServerPath()
+{
+    return Utils::FilePath::fromString(toolValue(languageServerPathKey).toString());
+}
+
+void VlangSettings::setLanguageServerPath(const Utils::FilePath &path)
+{
+    setToolValue(languageServerPathKey, path.toString());
+}
+
 VlangSettingsPage::VlangSettingsPage()
 {
     setId(Constants::C_VLANGSETTINGSPAGE_ID);
@@ -168,6 +287,7 @@ VlangSettingsPage::VlangSettingsPage()
 
 QWidget *VlangSettingsPage::widget()
 {
+    Plugin::ensureLanguageSupport();
     if (!m_widget)
         m_widget.reset(new SettingsWidget);
 
@@ -176,7 +296,21 @@ QWidget *VlangSettingsPage::widget()
 
 void VlangSettingsPage::apply()
 {
-
+    if (m_widget) {
+        auto widget = static_cast<SettingsWidget *>(m_widget.get());
+        VlangSettings::setCompilerPath(widget->path());
+        VlangSettings::setTestConcurrency(widget->testConcurrency());
+        VlangSettings::setFormatOnSave(widget->formatOnSave());
+        VlangSettings::setFormatTimeout(widget->formatTimeout());
+        ToolchainManager::instance()->updateCurrent();
+
+        const bool serverChanged = widget->useLanguageServer() != VlangSettings::useLanguageServer()
+                || widget->languageServerPath() != VlangSettings::languageServerPath();
+        VlangSettings::setUseLanguageServer(widget->useLanguageServer());
+        VlangSettings::setLanguageServerPath(widget->languageServerPath());
+        if (serverChanged)
+            VlsManager::instance()->restart();
+    }
 }
 
 void VlangSettingsPage::finish()
@@ -191,7 +325,10 @@ VlangCodeStyleSettingsPage::VlangCodeStyleSettingsPage()
     setCategory(Constants::C_VLANGCODESTYLESETTINGSPAGE_CATEGORY);
     setDisplayCategory(CodeStyleSettingsWidget::tr("V"));
     setCategoryIconPath(":/v/images/settingscategory_v.png");
-    setWidgetCreator([] { return new CodeStyleSettingsWidget; });
+    setWidgetCreator([] {
+        Plugin::ensureLanguageSupport();
+        return new CodeStyleSettingsWidget;
+    });
 }
 
 rCodeStylePreferencesWidget::rCodeStylePreferencesWidget(ICodeStylePreferences *preferences, QWidget *parent)
@@ -277,14 +414,59 @@ SettingsWidget::SettingsWidget(QWidget *parent)
 
     pathWidget = new Utils::PathChooser(groupBox);
     pathWidget->setExpectedKind(Utils::PathChooser::ExistingCommand);
+    pathWidget->setFilePath(VlangSettings::compilerPath());
 
     formLayout->setWidget(0, QFormLayout::FieldRole, pathWidget);
 
+    toolchainLabel = new QLabel(groupBox);
+    toolchainLabel->setTextInteractionFlags(Qt::TextSelectableByMouse);
+    formLayout->setWidget(1, QFormLayout::FieldRole, toolchainLabel);
+    connect(pathWidget, &Utils::PathChooser::pathChanged, this, &SettingsWidget::updateToolchainInfo);
+    connect(ToolchainManager::instance(), &ToolchainManager::toolchainProbed,
+            this, &SettingsWidget::updateToolchainInfo);
+    updateToolchainInfo();
+
     verticalLayout->addLayout(formLayout);
 
 
     verticalLayout_2->addWidget(groupBox);
 
+    testGroupBox = new QGroupBox(this);
+    testFormLayout = new QFormLayout(testGroupBox);
+    testConcurrencyWidget = new QSpinBox(testGroupBox);
+    testConcurrencyWidget->setRange(0, 256);
+    testConcurrencyWidget->setSpecialValueText(tr("One per core"));
+    testConcurrencyWidget->setValue(VlangSettings::testConcurrency());
+    testFormLayout->addRow(tr("Parallel test files"), testConcurrencyWidget);
+
+    verticalLayout_2->addWidget(testGroupBox);
+
+    formatGroupBox = new QGroupBox(this);
+    formatFormLayout = new QFormLayout(formatGroupBox);
+    formatOnSaveWidget = new QCheckBox(tr("Format with v fmt on save"), formatGroupBox);
+    formatOnSaveWidget->setChecked(VlangSettings::formatOnSave());
+    formatFormLayout->addRow(formatOnSaveWidget);
+    formatTimeoutWidget = new QSpinBox(formatGroupBox);
+    formatTimeoutWidget->setRange(100, 60000);
+    formatTimeoutWidget->setSingleStep(100);
+    formatTimeoutWidget->setSuffix(tr(" ms"));
+    formatTimeoutWidget->setValue(VlangSettings::formatTimeout());
+    formatFormLayout->addRow(tr("Timeout on save"), formatTimeoutWidget);
+
+    verticalLayout_2->addWidget(formatGroupBox);
+
+    languageServerGroupBox = new QGroupBox(this);
+    languageServerGroupBox->setCheckable(true);
+    languageServerGroupBox->setChecked(VlangSettings::useLanguageServer());
+    languageServerFormLayout = new QFormLayout(languageServerGroupBox);
+    languageServerPathWidget = new Utils::PathChooser(languageServerGroupBox);
+    languageServerPathWidget->setExpectedKind(Utils::PathChooser::ExistingCommand);
+    languageServerPathWidget->setFilePath(VlangSettings::languageServerPath());
+    languageServerPathWidget->lineEdit()->setPlaceholderText(VlsManager::serverPath().toUserOutput());
+    languageServerFormLayout->addRow(tr("Path"), languageServerPathWidget);
+
+    verticalLayout_2->addWidget(languageServerGroupBox);
+
     verticalSpacer = new QSpacerItem(20, 40, QSizePolicy::Minimum, QSizePolicy::Expanding);
 
     verticalLayout_2->addItem(verticalSpacer);
@@ -292,6 +474,29 @@ SettingsWidget::SettingsWidget(QWidget *parent)
 
     groupBox->setTitle(tr("V compiler"));
     pathLabel->setText(tr("Path"));
+    testGroupBox->setTitle(tr("Tests"));
+    formatGroupBox->setTitle(tr("Formatting"));
+    languageServerGroupBox->setTitle(tr("Language server (VLS)"));
+}
+
+void SettingsWidget::updateToolchainInfo()
+{
+    const Utils::FilePath compiler = pathWidget->filePath();
+    if (compiler.isEmpty() || !compiler.isExecutableFile()) {
+        toolchainLabel->setText(tr("No V compiler found."));
+        return;
+    }
+
+    const Toolchain toolchain = ToolchainManager::instance()->toolchain(compiler);
+    if (!toolchain.isValid()) {
+        toolchainLabel->setText(toolchain.lastModified.isValid() ? tr("\"v version\" failed.")
+                                                                 : tr("Checking version..."));
+        return;
+    }
+    toolchainLabel->setText(tr("%1, C backend: %2\nvlib: %3")
+                            .arg(toolchain.version, toolchain.cBackend,
+                                 toolchain.vlibDirectory.isEmpty() ? tr("not found")
+                                                                   : toolchain.vlibDirectory));
 }
 
 CodeStylePreferencesFactory::CodeStylePreferencesFactory() {
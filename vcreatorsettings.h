@@ -15,6 +15,35 @@ public:
     ~VlangSettings();
 
     static TextEditor::SimpleCodeStylePreferences *globalCodeStyle();
+
+    // Reads custom code styles and the global code style settings. The
+    // factory and pool are registered by the constructor already, projects
+    // set up their per-language code styles from them.
+    void loadCodeStyles();
+
+    // V compiler from the Tools page, falls back to "v" found in PATH.
+    static Utils::FilePath compilerPath();
+    static void setCompilerPath(const Utils::FilePath &path);
+
+    // Number of test files run in parallel, 0 for one per core.
+    static int testConcurrency();
+    static void setTestConcurrency(int concurrency);
+
+    // Formatting after a save gives up after formatTimeout(), leaving the
+    // file as it was saved.
+    static bool formatOnSave();
+    static void setFormatOnSave(bool formatOnSave);
+    static int formatTimeout();
+    static void setFormatTimeout(int milliseconds);
+
+    // VLS, an empty path looks for vls in PATH and ~/.vls/bin.
+    static bool useLanguageServer();
+    static void setUseLanguageServer(bool use);
+    static Utils::FilePath languageServerPath();
+    static void setLanguageServerPath(const Utils::FilePath &path);
+
+private:
+    bool m_codeStylesLoaded = false;
 };
 
 class VlangSettingsPage final: public Core::IOptionsPage {
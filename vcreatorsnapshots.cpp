@@ -0,0 +1,222 @@
+#include "vcreatorsnapshots.h"
+
+#include <texteditor/textdocument.h>
+#include <utils/hostosinfo.h>
+
+#include <QDir>
+#include <QFileInfo>
+#include <QTextBlock>
+#include <QTextDocument>
+
+namespace VCreator {
+namespace Internal {
+
+static DocumentSnapshotManager *m_instance = nullptr;
+
+static const int chunkLines = 128;
+
+int DocumentSnapshot::lineCount() const
+{
+    int count = 0;
+    for (const ChunkPtr &chunk : m_chunks)
+        count += chunk->lineCount;
+    return count;
+}
+
+QByteArray DocumentSnapshot::contents() const
+{
+    int size = 0;
+    for (const ChunkPtr &chunk : m_chunks)
+        size += chunk->text.size();
+
+    QByteArray result;
+    result.reserve(size);
+    for (const ChunkPtr &chunk : m_chunks)
+        result += chunk->text;
+    // The last line has no terminator of its own
+    result.chop(1);
+    return result;
+}
+
+QString DocumentSnapshot::text() const
+{
+    return QString::fromUtf8(contents());
+}
+
+// Chunks for the blocks first to last, both included
+static QVector<DocumentSnapshot::ChunkPtr> buildChunks(const QTextDocument *document,
+                                                      int first, int last)
+{
+    QVector<DocumentSnapshot::ChunkPtr> chunks;
+    QTextBlock block = document->findBlockByNumber(first);
+    while (block.isValid() && block.blockNumber() <= last) {
+        auto chunk = QSharedPointer<DocumentSnapshot::Chunk>::create();
+        for (; block.isValid() && block.blockNumber() <= last && chunk->lineCount < chunkLines;
+             block = block.next()) {
+            chunk->text += block.text().toUtf8();
+            chunk->text += '\n';
+            ++chunk->lineCount;
+        }
+        chunks.append(chunk);
+    }
+    return chunks;
+}
+
+DocumentSnapshotManager::DocumentSnapshotManager()
+{
+    m_instance = this;
+}
+
+DocumentSnapshotManager::~DocumentSnapshotManager()
+{
+    m_instance = nullptr;
+}
+
+DocumentSnapshotManager *DocumentSnapshotManager::instance()
+{
+    return m_instance;
+}
+
+void DocumentSnapshotManager::watchDocument(TextEditor::TextDocument *document)
+{
+    // Split views share one document
+    if (m_states.contains(document))
+        return;
+
+    connect(document->document(), &QTextDocument::contentsChange, this,
+            [this, document](int position, int charsRemoved, int charsAdded) {
+        contentsChange(document, position, charsRemoved, charsAdded);
+    });
+    // Saving and renaming change the snapshot, not the text
+    connect(document, &Core::IDocument::changed, this, [this, document] {
+        publish(document);
+    });
+    connect(document, &QObject::destroyed, this, [this, document] {
+        const QString filePath = m_states.take(document).filePath;
+        QMutexLocker locker(&m_mutex);
+        m_snapshots.remove(filePath);
+    });
+    rebuild(document);
+}
+
+void DocumentSnapshotManager::contentsChange(TextEditor::TextDocument *document, int position,
+                                             int charsRemoved, int charsAdded)
+{
+    Q_UNUSED(charsRemoved)
+    const QTextDocument *text = document->document();
+    DocumentState &state = m_states[document];
+    // Format changes report contents changes too, but keep the revision
+    if (text->revision() == state.revision)
+        return;
+    const int lineCount = text->blockCount();
+    const int delta = lineCount - state.lineCount;
+    const int firstLine = text->findBlock(position).blockNumber();
+    const int lastLine = text->findBlock(qMin(position + charsAdded,
+                                              text->characterCount() - 1)).blockNumber();
+
+    // Old lines firstLine to lastLine - delta became firstLine to lastLine
+    const int lastOldLine = lastLine - delta;
+    if (firstLine < 0 || lastLine < firstLine || lastOldLine < firstLine
+            || lastOldLine >= state.lineCount) {
+        rebuild(document);
+        return;
+    }
+
+    int firstChunk = -1;
+    int firstChunkLine = 0;
+    int lastChunk = -1;
+    int endLine = 0;
+    for (int i = 0; i < state.chunks.size(); ++i) {
+        const int chunkEnd = endLine + state.chunks.at(i)->lineCount;
+        if (firstChunk < 0 && firstLine < chunkEnd) {
+            firstChunk = i;
+            firstChunkLine = endLine;
+        }
+        endLine = chunkEnd;
+        if (lastOldLine < chunkEnd) {
+            lastChunk = i;
+            break;
+        }
+    }
+    if (firstChunk < 0 || lastChunk < 0) {
+        rebuild(document);
+        return;
+    }
+
+    const QVector<DocumentSnapshot::ChunkPtr> replacement
+            = buildChunks(text, firstChunkLine, endLine + delta - 1);
+    state.chunks.remove(firstChunk, lastChunk - firstChunk + 1);
+    for (int i = 0; i < replacement.size(); ++i)
+        state.chunks.insert(firstChunk + i, replacement.at(i));
+    state.lineCount = lineCount;
+    publish(document);
+}
+
+void DocumentSnapshotManager::rebuild(TextEditor::TextDocument *document)
+{
+    DocumentState &state = m_states[document];
+    state.lineCount = document->document()->blockCount();
+    state.chunks = buildChunks(document->document(), 0, state.lineCount - 1);
+    publish(document);
+}
+
+void DocumentSnapshotManager::publish(TextEditor::TextDocument *document)
+{
+    DocumentState &state = m_states[document];
+    DocumentSnapshot snapshot;
+    snapshot.m_filePath = document->filePath().toString();
+    snapshot.m_revision = document->document()->revision();
+    snapshot.m_modified = document->isModified();
+    snapshot.m_chunks = state.chunks;
+    state.revision = snapshot.m_revision;
+
+    QMutexLocker locker(&m_mutex);
+    if (state.filePath != snapshot.m_filePath) {
+        m_snapshots.remove(state.filePath);
+        state.filePath = snapshot.m_filePath;
+    }
+    if (!snapshot.m_filePath.isEmpty())
+        m_snapshots.insert(snapshot.m_filePath, snapshot);
+}
+
+DocumentSnapshot DocumentSnapshotManager::snapshot(const QString &filePath) const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_snapshots.value(filePath);
+}
+
+QHash<QString, DocumentSnapshot> DocumentSnapshotManager::snapshots() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_snapshots;
+}
+
+QHash<QString, DocumentSnapshot> DocumentSnapshotManager::modifiedSnapshots(
+        const QString &directory) const
+{
+    QHash<QString, DocumentSnapshot> modified;
+    QMutexLocker locker(&m_mutex);
+    for (auto it = m_snapshots.cbegin(); it != m_snapshots.cend(); ++it) {
+        if (!it->isModified())
+            continue;
+        if (directory.isEmpty() || QFileInfo(it.key()).absolutePath() == directory)
+            modified.insert(it.key(), it.value());
+    }
+    return modified;
+}
+
+QString DocumentSnapshotManager::overlayRoot()
+{
+    static const QString root = [] {
+        if (Utils::HostOsInfo::isLinuxHost()) {
+            const QFileInfo shm(QLatin1String("/dev/shm"));
+            if (shm.isDir() && shm.isWritable())
+                return shm.absoluteFilePath();
+        }
+        return QDir::tempPath();
+    }();
+    return root;
+}
+
+} // namespace Internal
+} // namespace Vcreator
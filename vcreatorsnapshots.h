@@ -0,0 +1,95 @@
+#pragma once
+
+#include <QByteArray>
+#include <QHash>
+#include <QMutex>
+#include <QObject>
+#include <QSharedPointer>
+#include <QVector>
+
+namespace TextEditor { class TextDocument; }
+
+namespace VCreator {
+namespace Internal {
+
+// Immutable UTF-8 contents of a document at one revision. The text is kept
+// in chunks of lines that are shared with the snapshots before and after,
+// an edit only replaces the chunks it touches. Copies are cheap and can be
+// handed to any thread.
+class DocumentSnapshot
+{
+public:
+    struct Chunk
+    {
+        QByteArray text;    // every line terminated by '\n'
+        int lineCount = 0;
+    };
+    using ChunkPtr = QSharedPointer<const Chunk>;
+
+    DocumentSnapshot() = default;
+
+    bool isValid() const { return !m_filePath.isEmpty(); }
+    QString filePath() const { return m_filePath; }
+    int revision() const { return m_revision; }
+    bool isModified() const { return m_modified; }
+    int lineCount() const;
+
+    // UTF-8 text with '\n' line endings, as the compiler reads it
+    QByteArray contents() const;
+    QString text() const;
+
+private:
+    friend class DocumentSnapshotManager;
+
+    QString m_filePath;
+    int m_revision = 0;
+    bool m_modified = false;
+    QVector<ChunkPtr> m_chunks;
+};
+
+// Keeps a snapshot of every open V document up to date on the GUI thread.
+// Workers read snapshots and overlay files without touching the documents.
+class DocumentSnapshotManager : public QObject
+{
+    Q_OBJECT
+
+public:
+    DocumentSnapshotManager();
+    ~DocumentSnapshotManager() override;
+
+    static DocumentSnapshotManager *instance();
+
+    void watchDocument(TextEditor::TextDocument *document);
+
+    // Thread-safe
+    DocumentSnapshot snapshot(const QString &filePath) const;
+    QHash<QString, DocumentSnapshot> snapshots() const;
+    // Snapshots with unsaved changes, optionally only those in directory
+    QHash<QString, DocumentSnapshot> modifiedSnapshots(const QString &directory = QString()) const;
+
+    // Directory on tmpfs when the system has one, for the overlays of
+    // unsaved files that tools like "v -check" read instead of the saved ones
+    static QString overlayRoot();
+
+private:
+    struct DocumentState
+    {
+        QString filePath;
+        QVector<DocumentSnapshot::ChunkPtr> chunks;
+        int lineCount = 0;
+        int revision = -1; // of the published snapshot
+    };
+
+    void contentsChange(TextEditor::TextDocument *document, int position,
+                        int charsRemoved, int charsAdded);
+    void rebuild(TextEditor::TextDocument *document);
+    void publish(TextEditor::TextDocument *document);
+
+    QHash<TextEditor::TextDocument *, DocumentState> m_states;
+
+    mutable QMutex m_mutex;
+    QHash<QString, DocumentSnapshot> m_snapshots;
+};
+
+} // namespace Internal
+} // namespace Vcreator
@@ -0,0 +1,167 @@
+#include "vcreatorsources.h"
+#include "ide.h"
+
+#include <coreplugin/editormanager/editormanager.h>
+#include <projectexplorer/project.h>
+#include <projectexplorer/session.h>
+
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFile>
+#include <QRegularExpression>
+#include <QtConcurrent>
+
+#include <algorithm>
+
+namespace VCreator {
+namespace Internal {
+
+static const QStringList vSourceFilters{"*.v", "*.vv", "*.vsh", "*.vh"};
+
+bool isVlangSourceFile(const QString &filePath)
+{
+    return filePath.endsWith(QLatin1String(".v"))
+            || filePath.endsWith(QLatin1String(".vv"))
+            || filePath.endsWith(QLatin1String(".vsh"))
+            || filePath.endsWith(QLatin1String(".vh"));
+}
+
+bool isVlangTestFile(const QString &filePath)
+{
+    return filePath.endsWith(QLatin1String("_test.v"));
+}
+
+QString readSourceFile(const QString &filePath)
+{
+    QFile file(filePath);
+    if (!file.open(QFile::ReadOnly))
+        return QString();
+    return QString::fromUtf8(file.readAll());
+}
+
+QByteArray contentHash(const QString &filePath)
+{
+    QFile file(filePath);
+    if (!file.open(QFile::ReadOnly))
+        return QByteArray();
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(&file);
+    return hash.result();
+}
+
+QByteArray contentHash(const QStringList &filePaths, const QByteArray &salt)
+{
+    QStringList sorted = filePaths;
+    std::sort(sorted.begin(), sorted.end());
+    const QList<QByteArray> hashes = QtConcurrent::blockingMapped<QList<QByteArray>>(
+                sorted, [](const QString &filePath) { return contentHash(filePath); });
+
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(salt);
+    for (int i = 0; i < sorted.size(); ++i) {
+        hash.addData(sorted.at(i).toUtf8());
+        hash.addData(hashes.at(i));
+    }
+    return hash.result();
+}
+
+QHash<QString, DocumentSnapshot> openDocumentContents()
+{
+    // Nothing is open before language support is set up
+    const DocumentSnapshotManager *manager = DocumentSnapshotManager::instance();
+    return manager ? manager->snapshots() : QHash<QString, DocumentSnapshot>();
+}
+
+QStringList vlangFilesForSearch(const QString &filePath)
+{
+    QStringList files;
+    const Utils::FilePath path = Utils::FilePath::fromString(filePath);
+    if (ProjectExplorer::Project *project = ProjectExplorer::SessionManager::projectForFile(path)) {
+        const Utils::FilePaths projectFiles = project->files(ProjectExplorer::Project::SourceFiles);
+        for (const Utils::FilePath &file : projectFiles) {
+            if (isVlangSourceFile(file.toString()))
+                files.append(file.toString());
+        }
+    }
+
+    if (files.isEmpty())
+        files = vlangModuleFiles(path.toFileInfo().absolutePath(), true);
+
+    if (!files.contains(filePath))
+        files.append(filePath);
+    return files;
+}
+
+void openEditorAt(const QString &filePath, int line, int column)
+{
+// TODO: Remove after Qt Creator 5.0 release
+#if QTCREATOR_VERSION >= QTCREATOR_VERSION_CHECK(4,82,0)
+    Core::EditorManager::openEditorAt(Utils::Link(Utils::FilePath::fromString(filePath), line, column));
+#else
+    Core::EditorManager::openEditorAt(filePath, line, column);
+#endif
+}
+
+QStringList vlangModuleFiles(const QString &directory, bool includeTests)
+{
+    QStringList files;
+    const QFileInfoList entries = QDir(directory).entryInfoList(vSourceFilters, QDir::Files);
+    for (const QFileInfo &entry : entries) {
+        if (includeTests || !isVlangTestFile(entry.fileName()))
+            files.append(entry.absoluteFilePath());
+    }
+    return files;
+}
+
+QString findProjectRoot(const QString &directory)
+{
+    QDir dir(directory);
+    do {
+        if (dir.exists(QLatin1String("v.mod")))
+            return dir.absolutePath();
+    } while (dir.cdUp());
+    return QString();
+}
+
+bool GeneratedLineMap::map(const QString &generatedFile, int generatedLine,
+                           QString *sourceFile, int *sourceLine)
+{
+    auto it = m_lineDirectives.find(generatedFile);
+    if (it == m_lineDirectives.end()) {
+        // Each generated file is read once, however many lines are mapped.
+        QVector<LineDirective> directives;
+        QFile file(generatedFile);
+        if (file.open(QFile::ReadOnly)) {
+            static const QRegularExpression lineDirective(R"(^#line (\d+) "([^"]+)")");
+            int lineNumber = 0;
+            while (!file.atEnd()) {
+                const QByteArray line = file.readLine();
+                ++lineNumber;
+                if (!line.startsWith("#line "))
+                    continue;
+                const QRegularExpressionMatch match = lineDirective.match(QString::fromUtf8(line));
+                if (match.hasMatch())
+                    directives.append({lineNumber, match.captured(1).toInt(), match.captured(2)});
+            }
+        }
+        it = m_lineDirectives.insert(generatedFile, directives);
+    }
+
+    const QVector<LineDirective> &directives = it.value();
+    auto directive = std::upper_bound(directives.cbegin(), directives.cend(), generatedLine,
+                                      [](int line, const LineDirective &d) {
+        return line < d.generatedLine;
+    });
+    if (directive == directives.cbegin())
+        return false;
+    --directive;
+    if (!isVlangSourceFile(directive->sourceFile))
+        return false;
+
+    *sourceFile = directive->sourceFile;
+    *sourceLine = directive->sourceLine + (generatedLine - directive->generatedLine - 1);
+    return true;
+}
+
+} // namespace Internal
+} // namespace Vcreator
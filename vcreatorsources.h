@@ -0,0 +1,60 @@
+#pragma once
+
+#include "vcreatorsnapshots.h"
+
+#include <QHash>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+namespace VCreator {
+namespace Internal {
+
+bool isVlangSourceFile(const QString &filePath);
+bool isVlangTestFile(const QString &filePath);
+
+QString readSourceFile(const QString &filePath);
+
+// Hash of a file's contents, empty when it cannot be read.
+QByteArray contentHash(const QString &filePath);
+
+// Combined hash of several files, computed in parallel. The order of files
+// does not matter, salt is mixed in for options that affect the result.
+QByteArray contentHash(const QStringList &filePaths, const QByteArray &salt);
+
+// Snapshots of all open V documents, including unsaved changes.
+QHash<QString, DocumentSnapshot> openDocumentContents();
+
+// V source files belonging to the project of filePath, or the files of the
+// containing directory when the file is not part of a project.
+QStringList vlangFilesForSearch(const QString &filePath);
+
+// Opens filePath in an editor, line is 1-based and column 0-based.
+void openEditorAt(const QString &filePath, int line, int column = 0);
+
+// V source files of a module directory, not recursing into submodules.
+QStringList vlangModuleFiles(const QString &directory, bool includeTests = false);
+
+// Closest directory containing a v.mod, starting at directory.
+QString findProjectRoot(const QString &directory);
+
+// Maps lines of C files generated by the V compiler back to the V lines
+// recorded by the nearest preceding #line directive.
+class GeneratedLineMap
+{
+public:
+    bool map(const QString &generatedFile, int generatedLine, QString *sourceFile, int *sourceLine);
+
+private:
+    struct LineDirective
+    {
+        int generatedLine;
+        int sourceLine;
+        QString sourceFile;
+    };
+
+    QHash<QString, QVector<LineDirective>> m_lineDirectives;
+};
+
+} // namespace Internal
+} // namespace Vcreator
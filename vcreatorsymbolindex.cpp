@@ -0,0 +1,446 @@
+#include "vcreatorsymbolindex.h"
+#include "vcreatorconstants.h"
+#include "vcreatorlexer.h"
+#include "vcreatorsources.h"
+#include "vcreatortoolchain.h"
+
+#include <coreplugin/progressmanager/progressmanager.h>
+#include <utils/runextensions.h>
+
+#include <QDir>
+#include <QFileInfo>
+#include <QFutureWatcher>
+#include <QtConcurrent>
+
+namespace VCreator {
+namespace Internal {
+
+static SymbolIndex *m_instance = nullptr;
+
+static void indexSources(QFutureInterface<FileIndexPtr> &futureInterface,
+                         const QStringList &files,
+                         const QHash<QString, DocumentSnapshot> &contents)
+{
+    futureInterface.setProgressRange(0, files.size());
+    QAtomicInt done = 0;
+    QtConcurrent::blockingMap(files.constBegin(), files.constEnd(), [&](const QString &file) {
+        if (futureInterface.isCanceled())
+            return;
+        const auto it = contents.constFind(file);
+        const QString text = it != contents.constEnd() ? it->text() : readSourceFile(file);
+        futureInterface.reportResult(indexFile(file, SourceTokens(text)));
+        futureInterface.setProgressValue(++done);
+    });
+}
+
+SymbolIndex::SymbolIndex()
+{
+    m_instance = this;
+    m_futureSynchronizer.setCancelOnWait(true);
+
+    // Imports resolved against the previous vlib are stale, builtin is
+    // indexed with the next file that needs it
+    connect(ToolchainManager::instance(), &ToolchainManager::currentChanged, this, [this] {
+        {
+            QMutexLocker locker(&m_importCacheMutex);
+            m_importCache.clear();
+        }
+        m_requestedModules.clear();
+        indexDependencies({});
+        m_collectTimer.start();
+    });
+
+    // Closing a session releases all projects at once, collect them together
+    m_collectTimer.setSingleShot(true);
+    m_collectTimer.setInterval(1000);
+    connect(&m_collectTimer, &QTimer::timeout, this, &SymbolIndex::collectUnusedModules);
+}
+
+SymbolIndex::~SymbolIndex()
+{
+    m_futureSynchronizer.waitForFinished();
+    m_instance = nullptr;
+}
+
+SymbolIndex *SymbolIndex::instance()
+{
+    return m_instance;
+}
+
+void SymbolIndex::indexFiles(const QStringList &files)
+{
+    if (!files.isEmpty())
+        startIndexing(files, openDocumentContents());
+}
+
+void SymbolIndex::indexDocument(const DocumentSnapshot &snapshot)
+{
+    if (snapshot.isValid())
+        startIndexing({snapshot.filePath()}, {{snapshot.filePath(), snapshot}});
+}
+
+void SymbolIndex::removeFiles(const QStringList &files)
+{
+    if (files.isEmpty())
+        return;
+    {
+        QWriteLocker locker(&m_lock);
+        for (const QString &file : files) {
+            ++m_revisions[file];
+            removeFileLocked(file);
+        }
+    }
+    emit filesRemoved(files);
+}
+
+void SymbolIndex::setOwnerFiles(const QObject *owner, const QSet<QString> &files)
+{
+    const QSet<QString> previous = m_ownerFiles.value(owner);
+    if (files.isEmpty())
+        m_ownerFiles.remove(owner);
+    else
+        m_ownerFiles.insert(owner, files);
+
+    bool modulesReleased = false;
+    QStringList unused;
+    for (const QString &file : previous - files) {
+        if (--m_fileRefs[file] == 0) {
+            m_fileRefs.remove(file);
+            unused.append(file);
+        }
+        const QString module = QFileInfo(file).absolutePath();
+        if (--m_moduleRefs[module] == 0) {
+            m_moduleRefs.remove(module);
+            modulesReleased = true;
+        }
+    }
+    for (const QString &file : files - previous) {
+        ++m_fileRefs[file];
+        ++m_moduleRefs[QFileInfo(file).absolutePath()];
+    }
+
+    // Files of a released owner may still be imported by another project,
+    // only files that vanished from a live owner go right away
+    if (m_ownerFiles.contains(owner))
+        removeFiles(unused);
+    if (modulesReleased)
+        m_collectTimer.start();
+    indexFiles(files.values());
+}
+
+void SymbolIndex::releaseOwner(const QObject *owner)
+{
+    setOwnerFiles(owner, {});
+}
+
+// Mark and sweep from the owners' modules and the open documents along the
+// imports, the reference counts alone would miss modules that are only kept
+// by a module that is going away itself.
+void SymbolIndex::collectUnusedModules()
+{
+    QStringList pending = m_moduleRefs.keys();
+    for (const QString &filePath : openDocumentContents().keys())
+        pending.append(QFileInfo(filePath).absolutePath());
+    const QString vlib = ToolchainManager::instance()->vlibDirectory();
+    if (!vlib.isEmpty())
+        pending.append(vlib + QLatin1String("/builtin"));
+
+    QSet<QString> live;
+    while (!pending.isEmpty()) {
+        const QString directory = pending.takeLast();
+        if (directory.isEmpty() || live.contains(directory))
+            continue;
+        live.insert(directory);
+        for (const FileIndexPtr &file : moduleFiles(directory)) {
+            for (const Import &import : file->imports)
+                pending.append(resolveImport(file->filePath, import.path));
+        }
+    }
+
+    QStringList unused;
+    {
+        QReadLocker locker(&m_lock);
+        for (auto it = m_moduleFiles.cbegin(); it != m_moduleFiles.cend(); ++it) {
+            if (!live.contains(it.key()))
+                unused += it->values();
+        }
+    }
+    for (auto it = m_requestedModules.begin(); it != m_requestedModules.end();) {
+        if (live.contains(*it))
+            ++it;
+        else
+            it = m_requestedModules.erase(it);
+    }
+    removeFiles(unused);
+}
+
+void SymbolIndex::startIndexing(const QStringList &files,
+                                const QHash<QString, DocumentSnapshot> &contents)
+{
+    // A file may be queued again while an older run is still in flight,
+    // only the result of the latest request is kept.
+    QHash<QString, int> revisions;
+    for (const QString &file : files)
+        revisions.insert(file, ++m_revisions[file]);
+
+    const QFuture<FileIndexPtr> future = Utils::runAsync(indexSources, files, contents);
+    m_futureSynchronizer.addFuture(future);
+
+    auto watcher = new QFutureWatcher<FileIndexPtr>(this);
+    connect(watcher, &QFutureWatcherBase::finished, this, [this, watcher, revisions] {
+        QVector<FileIndexPtr> results;
+        if (!watcher->isCanceled()) {
+            const QList<FileIndexPtr> indexed = watcher->future().results();
+            for (const FileIndexPtr &file : indexed) {
+                if (m_revisions.value(file->filePath) == revisions.value(file->filePath))
+                    results.append(file);
+            }
+        }
+        watcher->deleteLater();
+        insertFiles(results);
+    });
+    watcher->setFuture(future);
+
+    if (files.size() > 1)
+        Core::ProgressManager::addTask(future, tr("Indexing V Files"), Constants::C_TASK_INDEX);
+}
+
+void SymbolIndex::insertFiles(const QVector<FileIndexPtr> &files)
+{
+    if (files.isEmpty())
+        return;
+
+    QStringList paths;
+    {
+        QWriteLocker locker(&m_lock);
+        for (const FileIndexPtr &file : files) {
+            removeFileLocked(file->filePath);
+            m_files.insert(file->filePath, file);
+            m_moduleFiles[file->directory].insert(file->filePath);
+            for (int i = 0; i < file->symbols.size(); ++i) {
+                const Symbol &symbol = file->symbols.at(i);
+                m_symbolsByName.insert(symbol.name, SymbolRef{file, i});
+                m_names.insert(symbol.name);
+                if (symbol.isMember())
+                    m_membersByReceiver.insert(symbol.receiver, SymbolRef{file, i});
+            }
+            paths.append(file->filePath);
+        }
+    }
+
+    emit filesIndexed(paths);
+    indexDependencies(files);
+}
+
+void SymbolIndex::removeFileLocked(const QString &filePath)
+{
+    const FileIndexPtr file = m_files.take(filePath);
+    if (!file)
+        return;
+
+    auto module = m_moduleFiles.find(file->directory);
+    if (module != m_moduleFiles.end()) {
+        module->remove(filePath);
+        if (module->isEmpty())
+            m_moduleFiles.erase(module);
+    }
+
+    const auto removeFrom = [&file](QMultiHash<QString, SymbolRef> &hash, const QString &key) {
+        for (auto it = hash.find(key); it != hash.end() && it.key() == key;) {
+            if (it->file == file)
+                it = hash.erase(it);
+            else
+                ++it;
+        }
+    };
+
+    for (const Symbol &symbol : file->symbols) {
+        removeFrom(m_symbolsByName, symbol.name);
+        m_names.remove(symbol.name);
+        if (symbol.isMember())
+            removeFrom(m_membersByReceiver, symbol.receiver);
+    }
+}
+
+void SymbolIndex::indexDependencies(const QVector<FileIndexPtr> &files)
+{
+    QStringList directories;
+    const QString vlib = ToolchainManager::instance()->vlibDirectory();
+    if (!vlib.isEmpty())
+        directories.append(vlib + QLatin1String("/builtin"));
+    for (const FileIndexPtr &file : files) {
+        for (const Import &import : file->imports)
+            directories.append(resolveImport(file->filePath, import.path));
+    }
+
+    QStringList dependencyFiles;
+    for (const QString &directory : qAsConst(directories)) {
+        if (directory.isEmpty() || m_requestedModules.contains(directory))
+            continue;
+        m_requestedModules.insert(directory);
+        if (!moduleFiles(directory).isEmpty())
+            continue;
+        dependencyFiles.append(vlangModuleFiles(directory));
+    }
+    indexFiles(dependencyFiles);
+}
+
+FileIndexPtr SymbolIndex::file(const QString &filePath) const
+{
+    QReadLocker locker(&m_lock);
+    return m_files.value(filePath);
+}
+
+QVector<FileIndexPtr> SymbolIndex::moduleFiles(const QString &directory) const
+{
+    QReadLocker locker(&m_lock);
+    QVector<FileIndexPtr> result;
+    const QSet<QString> files = m_moduleFiles.value(directory);
+    for (const QString &file : files)
+        result.append(m_files.value(file));
+    return result;
+}
+
+QVector<SymbolRef> SymbolIndex::symbols(const QString &name) const
+{
+    QReadLocker locker(&m_lock);
+    return m_symbolsByName.values(name).toVector();
+}
+
+QStringList SymbolIndex::namesWithPrefix(const QString &prefix, int limit) const
+{
+    QReadLocker locker(&m_lock);
+    return m_names.namesWithPrefix(prefix, limit);
+}
+
+QVector<SymbolRef> SymbolIndex::members(const QString &type) const
+{
+    QReadLocker locker(&m_lock);
+    return m_membersByReceiver.values(type).toVector();
+}
+
+QVector<SymbolRef> SymbolIndex::moduleDeclarations(const QString &directory) const
+{
+    QReadLocker locker(&m_lock);
+    QVector<SymbolRef> result;
+    const QSet<QString> files = m_moduleFiles.value(directory);
+    for (const QString &path : files) {
+        const FileIndexPtr file = m_files.value(path);
+        for (int i = 0; i < file->symbols.size(); ++i) {
+            if (!file->symbols.at(i).isMember())
+                result.append(SymbolRef{file, i});
+        }
+    }
+    return result;
+}
+
+QVector<SymbolRef> SymbolIndex::moduleSymbolsLocked(const QString &directory, const QString &name) const
+{
+    QVector<SymbolRef> result;
+    for (auto it = m_symbolsByName.constFind(name);
+         it != m_symbolsByName.constEnd() && it.key() == name; ++it) {
+        if (it->file->directory == directory && !it->symbol().isMember())
+            result.append(*it);
+    }
+    return result;
+}
+
+QString SymbolIndex::resolveImport(const QString &fromFile, const QString &importPath) const
+{
+    const QString fromDirectory = QFileInfo(fromFile).absolutePath();
+    const QString cacheKey = fromDirectory + QLatin1Char('|') + importPath;
+    {
+        QMutexLocker locker(&m_importCacheMutex);
+        const auto it = m_importCache.constFind(cacheKey);
+        if (it != m_importCache.constEnd())
+            return *it;
+    }
+
+    const QString relativePath = QString(importPath).replace(QLatin1Char('.'), QLatin1Char('/'));
+    QStringList roots;
+    const QString projectRoot = findProjectRoot(fromDirectory);
+    if (!projectRoot.isEmpty())
+        roots << projectRoot << projectRoot + QLatin1String("/modules");
+    roots << fromDirectory
+          << QDir::homePath() + QLatin1String("/.vmodules")
+          << ToolchainManager::instance()->vlibDirectory();
+
+    QString result;
+    for (const QString &root : qAsConst(roots)) {
+        if (root.isEmpty())
+            continue;
+        const QFileInfo candidate(root + QLatin1Char('/') + relativePath);
+        if (candidate.isDir()) {
+            result = candidate.absoluteFilePath();
+            break;
+        }
+    }
+
+    QMutexLocker locker(&m_importCacheMutex);
+    m_importCache.insert(cacheKey, result);
+    return result;
+}
+
+QVector<SymbolRef> SymbolIndex::resolve(const QString &filePath, const QString &qualifier,
+                                        const QString &name, bool qualified) const
+{
+    const FileIndexPtr currentFile = file(filePath);
+    const QString directory = QFileInfo(filePath).absolutePath();
+
+    if (qualified && currentFile && !qualifier.isEmpty()) {
+        if (const Import *import = currentFile->importForAlias(qualifier)) {
+            const QString moduleDirectory = resolveImport(filePath, import->path);
+            QReadLocker locker(&m_lock);
+            return moduleSymbolsLocked(moduleDirectory, name);
+        }
+    }
+
+    QReadLocker locker(&m_lock);
+    if (qualified) {
+        // Member access: prefer members of a type named like the qualifier
+        // (enum values, static-like access), then members in this module.
+        QVector<SymbolRef> members;
+        QVector<SymbolRef> local;
+        for (auto it = m_symbolsByName.constFind(name);
+             it != m_symbolsByName.constEnd() && it.key() == name; ++it) {
+            const Symbol &symbol = it->symbol();
+            if (!symbol.isMember())
+                continue;
+            if (!qualifier.isEmpty() && symbol.receiver == qualifier)
+                return {*it};
+            if (it->file->directory == directory)
+                local.append(*it);
+            else
+                members.append(*it);
+        }
+        return local + members;
+    }
+
+    QVector<SymbolRef> result = moduleSymbolsLocked(directory, name);
+    if (!result.isEmpty())
+        return result;
+
+    if (currentFile) {
+        for (const Import &import : currentFile->imports) {
+            if (import.symbols.contains(name))
+                return moduleSymbolsLocked(resolveImport(filePath, import.path), name);
+        }
+    }
+
+    const QString vlib = ToolchainManager::instance()->vlibDirectory();
+    if (!vlib.isEmpty()) {
+        result = moduleSymbolsLocked(vlib + QLatin1String("/builtin"), name);
+        if (!result.isEmpty())
+            return result;
+    }
+
+    for (auto it = m_symbolsByName.constFind(name);
+         it != m_symbolsByName.constEnd() && it.key() == name; ++it) {
+        if (!it->symbol().isMember())
+            result.append(*it);
+    }
+    return result;
+}
+
+} // namespace Internal
+} // namespace Vcreator
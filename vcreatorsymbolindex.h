@@ -0,0 +1,108 @@
+#pragma once
+
+#include "vcreatorindexer.h"
+#include "vcreatorprefixtrie.h"
+#include "vcreatorsnapshots.h"
+
+#include <utils/futuresynchronizer.h>
+
+#include <QHash>
+#include <QMultiHash>
+#include <QMutex>
+#include <QObject>
+#include <QReadWriteLock>
+#include <QSet>
+#include <QTimer>
+
+namespace VCreator {
+namespace Internal {
+
+struct SymbolRef
+{
+    FileIndexPtr file;
+    int index = -1;
+
+    const Symbol &symbol() const { return file->symbols.at(index); }
+};
+
+// Session wide index of V declarations, shared by all open projects. Files
+// are indexed on worker threads, the results are published on the GUI
+// thread. Lookups are hash based and may be done from any thread.
+//
+// Modules are kept by module directory: the modules of each owner's files
+// are reference counted, imported modules are indexed once for everybody
+// and dropped when no remaining module or open document reaches them.
+class SymbolIndex : public QObject
+{
+    Q_OBJECT
+
+public:
+    SymbolIndex();
+    ~SymbolIndex() override;
+
+    static SymbolIndex *instance();
+
+    // Open documents are indexed with their current contents.
+    void indexFiles(const QStringList &files);
+    void indexDocument(const DocumentSnapshot &snapshot);
+    void removeFiles(const QStringList &files);
+
+    // Replaces the files owner keeps indexed, files it no longer lists are
+    // removed unless another owner still lists them.
+    void setOwnerFiles(const QObject *owner, const QSet<QString> &files);
+    // Drops owner, its modules stay while something else still needs them
+    void releaseOwner(const QObject *owner);
+
+    FileIndexPtr file(const QString &filePath) const;
+    QVector<FileIndexPtr> moduleFiles(const QString &directory) const;
+    QVector<SymbolRef> symbols(const QString &name) const;
+    QStringList namesWithPrefix(const QString &prefix, int limit = -1) const;
+
+    // Fields, methods and enum values declared for type.
+    QVector<SymbolRef> members(const QString &type) const;
+    // Top-level declarations of the module in directory.
+    QVector<SymbolRef> moduleDeclarations(const QString &directory) const;
+
+    // Directory of the module imported as importPath from fromFile, or an
+    // empty string when it cannot be found.
+    QString resolveImport(const QString &fromFile, const QString &importPath) const;
+
+    // Declarations name refers to in filePath. qualifier is a module alias,
+    // a type name or empty for expressions like foo().name.
+    QVector<SymbolRef> resolve(const QString &filePath, const QString &qualifier,
+                               const QString &name, bool qualified) const;
+
+signals:
+    void filesIndexed(const QStringList &files);
+    void filesRemoved(const QStringList &files);
+
+private:
+    void startIndexing(const QStringList &files, const QHash<QString, DocumentSnapshot> &contents);
+    void insertFiles(const QVector<FileIndexPtr> &files);
+    void removeFileLocked(const QString &filePath);
+    void indexDependencies(const QVector<FileIndexPtr> &files);
+    void collectUnusedModules();
+    QVector<SymbolRef> moduleSymbolsLocked(const QString &directory, const QString &name) const;
+
+    mutable QReadWriteLock m_lock;
+    QHash<QString, FileIndexPtr> m_files;
+    QHash<QString, QSet<QString>> m_moduleFiles;
+    QMultiHash<QString, SymbolRef> m_symbolsByName;
+    QMultiHash<QString, SymbolRef> m_membersByReceiver;
+    PrefixTrie m_names;
+
+    // GUI thread only
+    QHash<QString, int> m_revisions;
+    QSet<QString> m_requestedModules;
+    QHash<const QObject *, QSet<QString>> m_ownerFiles;
+    QHash<QString, int> m_fileRefs;
+    QHash<QString, int> m_moduleRefs;
+    QTimer m_collectTimer;
+    Utils::FutureSynchronizer m_futureSynchronizer;
+
+    mutable QMutex m_importCacheMutex;
+    mutable QHash<QString, QString> m_importCache;
+};
+
+} // namespace Internal
+} // namespace Vcreator
@@ -0,0 +1,293 @@
+#include "vcreatortestresultspane.h"
+#include "vcreatorsources.h"
+#include "vcreatortestrunner.h"
+
+#include <projectexplorer/project.h>
+
+#include <utils/utilsicons.h>
+
+#include <QDir>
+#include <QHeaderView>
+#include <QLabel>
+#include <QRegularExpression>
+#include <QToolButton>
+#include <QTreeWidget>
+#include <QVBoxLayout>
+
+namespace VCreator {
+namespace Internal {
+
+enum ItemRole {
+    FileRole = Qt::UserRole,
+    LineRole
+};
+
+enum Column {
+    NameColumn,
+    DurationColumn
+};
+
+static QString formatDuration(double milliseconds)
+{
+    if (milliseconds >= 1000)
+        return TestResultsPane::tr("%1 s").arg(milliseconds / 1000, 0, 'f', 2);
+    return TestResultsPane::tr("%1 ms").arg(milliseconds, 0, 'f', milliseconds < 10 ? 3 : 0);
+}
+
+TestResultsPane::TestResultsPane()
+    : m_widget(new QWidget)
+    , m_layout(new QVBoxLayout(m_widget))
+    , m_runButton(new QToolButton)
+    , m_rerunFailedButton(new QToolButton)
+    , m_stopButton(new QToolButton)
+    , m_summary(new QLabel)
+{
+    m_layout->setContentsMargins(0, 0, 0, 0);
+
+    m_runButton->setIcon(Utils::Icons::RUN_SMALL_TOOLBAR.icon());
+    m_runButton->setToolTip(tr("Run All Tests"));
+    m_rerunFailedButton->setIcon(Utils::Icons::RELOAD_TOOLBAR.icon());
+    m_rerunFailedButton->setToolTip(tr("Rerun Failed Tests"));
+    m_stopButton->setIcon(Utils::Icons::STOP_SMALL_TOOLBAR.icon());
+    m_stopButton->setToolTip(tr("Stop"));
+    updateButtons();
+}
+
+TestResultsPane::~TestResultsPane()
+{
+    delete m_widget;
+}
+
+void TestResultsPane::attach(TestRunner *runner)
+{
+    m_tree = new QTreeWidget;
+    m_layout->addWidget(m_tree);
+    m_tree->setColumnCount(2);
+    m_tree->setHeaderHidden(true);
+    m_tree->setFrameStyle(QFrame::NoFrame);
+    m_tree->setUniformRowHeights(true);
+    m_tree->header()->setStretchLastSection(false);
+    m_tree->header()->setSectionResizeMode(NameColumn, QHeaderView::Stretch);
+    m_tree->header()->setSectionResizeMode(DurationColumn, QHeaderView::ResizeToContents);
+
+    connect(m_tree, &QTreeWidget::itemActivated, this, [](QTreeWidgetItem *item) {
+        const QString file = item->data(NameColumn, FileRole).toString();
+        if (!file.isEmpty())
+            openEditorAt(file, item->data(NameColumn, LineRole).toInt());
+    });
+
+    connect(m_runButton, &QToolButton::clicked, runner, &TestRunner::runAllTests);
+    connect(m_rerunFailedButton, &QToolButton::clicked, runner, &TestRunner::rerunFailedTests);
+    connect(m_stopButton, &QToolButton::clicked, runner, &TestRunner::stop);
+
+    connect(runner, &TestRunner::runStarted, this, &TestResultsPane::runStarted);
+    connect(runner, &TestRunner::fileStarted, this, &TestResultsPane::fileStarted);
+    connect(runner, &TestRunner::testFinished, this, &TestResultsPane::testFinished);
+    connect(runner, &TestRunner::testOutput, this, &TestResultsPane::testOutput);
+    connect(runner, &TestRunner::fileFinished, this, &TestResultsPane::fileFinished);
+    connect(runner, &TestRunner::runFinished, this, &TestResultsPane::runFinished);
+
+    updateButtons();
+}
+
+QWidget *TestResultsPane::outputWidget(QWidget *parent)
+{
+    m_widget->setParent(parent);
+    return m_widget;
+}
+
+QList<QWidget *> TestResultsPane::toolBarWidgets() const
+{
+    return {m_runButton, m_rerunFailedButton, m_stopButton, m_summary};
+}
+
+QString TestResultsPane::displayName() const
+{
+    return tr("V Tests");
+}
+
+int TestResultsPane::priorityInStatusBar() const
+{
+    return 10;
+}
+
+void TestResultsPane::clearContents()
+{
+    if (m_tree)
+        m_tree->clear();
+    m_fileItems.clear();
+    m_summary->clear();
+}
+
+void TestResultsPane::visibilityChanged(bool visible)
+{
+    Q_UNUSED(visible)
+}
+
+void TestResultsPane::setFocus()
+{
+    if (m_tree)
+        m_tree->setFocus();
+}
+
+bool TestResultsPane::hasFocus() const
+{
+    return m_tree && m_tree->hasFocus();
+}
+
+bool TestResultsPane::canFocus() const
+{
+    return true;
+}
+
+bool TestResultsPane::canNavigate() const
+{
+    return true;
+}
+
+bool TestResultsPane::canNext() const
+{
+    return m_tree && m_tree->topLevelItemCount() > 0;
+}
+
+bool TestResultsPane::canPrevious() const
+{
+    return m_tree && m_tree->topLevelItemCount() > 0;
+}
+
+void TestResultsPane::goToNext()
+{
+    navigate(1);
+}
+
+void TestResultsPane::goToPrev()
+{
+    navigate(-1);
+}
+
+// Moves to the next or previous item pointing at a source location.
+void TestResultsPane::navigate(int step)
+{
+    if (!m_tree)
+        return;
+    QTreeWidgetItem *item = m_tree->currentItem();
+    do {
+        item = item ? (step > 0 ? m_tree->itemBelow(item) : m_tree->itemAbove(item))
+                    : m_tree->topLevelItem(0);
+    } while (item && item->data(NameColumn, LineRole).toInt() <= 0);
+
+    if (item) {
+        m_tree->setCurrentItem(item);
+        emit m_tree->itemActivated(item, NameColumn);
+    }
+}
+
+void TestResultsPane::runStarted(const QVector<TestFile> &files)
+{
+    clearContents();
+
+    QString projectDirectory;
+    if (ProjectExplorer::Project *project = TestRunner::currentProject())
+        projectDirectory = project->projectDirectory().toString();
+
+    for (const TestFile &file : files) {
+        auto fileItem = new QTreeWidgetItem(m_tree);
+        fileItem->setText(NameColumn, projectDirectory.isEmpty()
+                          ? QDir::toNativeSeparators(file.filePath)
+                          : QDir(projectDirectory).relativeFilePath(file.filePath));
+        fileItem->setData(NameColumn, FileRole, file.filePath);
+        m_fileItems.insert(file.filePath, fileItem);
+
+        for (int i = 0; i < file.functions.size(); ++i) {
+            auto testItem = new QTreeWidgetItem(fileItem);
+            testItem->setText(NameColumn, file.functions.at(i));
+            testItem->setData(NameColumn, FileRole, file.filePath);
+            testItem->setData(NameColumn, LineRole, file.lines.at(i));
+        }
+    }
+    m_summary->setText(tr("Running %n test files", nullptr, files.size()));
+    updateButtons();
+    popup(NoModeSwitch);
+}
+
+void TestResultsPane::fileStarted(const QString &filePath)
+{
+    if (QTreeWidgetItem *item = m_fileItems.value(filePath))
+        item->setIcon(NameColumn, Utils::Icons::RUN_SMALL.icon());
+}
+
+QTreeWidgetItem *TestResultsPane::testItem(const QString &filePath, const QString &function) const
+{
+    QTreeWidgetItem *fileItem = m_fileItems.value(filePath);
+    if (!fileItem)
+        return nullptr;
+    for (int i = 0; i < fileItem->childCount(); ++i) {
+        if (fileItem->child(i)->text(NameColumn) == function)
+            return fileItem->child(i);
+    }
+    return nullptr;
+}
+
+void TestResultsPane::testFinished(const QString &filePath, const QString &function, bool passed,
+                                   double milliseconds)
+{
+    if (QTreeWidgetItem *item = testItem(filePath, function)) {
+        item->setIcon(NameColumn, passed ? Utils::Icons::OK.icon() : Utils::Icons::CRITICAL.icon());
+        item->setText(DurationColumn, formatDuration(milliseconds));
+    }
+}
+
+void TestResultsPane::testOutput(const QString &filePath, const QString &line)
+{
+    QTreeWidgetItem *fileItem = m_fileItems.value(filePath);
+    if (!fileItem)
+        return;
+
+    // Assertion failures start with "file:line:"
+    static const QRegularExpression location(R"(^(.+?\.v):(\d+):)");
+    const QRegularExpressionMatch match = location.match(line);
+
+    auto item = new QTreeWidgetItem(fileItem);
+    item->setText(NameColumn, line);
+    item->setForeground(NameColumn, m_tree->palette().placeholderText());
+    if (match.hasMatch()) {
+        item->setData(NameColumn, FileRole, QDir(TestRunner::workingDirectory(filePath))
+                      .absoluteFilePath(match.captured(1)));
+        item->setData(NameColumn, LineRole, match.captured(2).toInt());
+    }
+}
+
+void TestResultsPane::fileFinished(const QString &filePath, bool passed, qint64 milliseconds)
+{
+    QTreeWidgetItem *fileItem = m_fileItems.value(filePath);
+    if (!fileItem)
+        return;
+    fileItem->setIcon(NameColumn, passed ? Utils::Icons::OK.icon() : Utils::Icons::CRITICAL.icon());
+    fileItem->setText(DurationColumn, formatDuration(milliseconds));
+    if (!passed)
+        fileItem->setExpanded(true);
+}
+
+void TestResultsPane::runFinished(int passedFiles, int failedFiles)
+{
+    if (passedFiles + failedFiles == 0)
+        m_summary->setText(tr("No tests to run"));
+    else
+        m_summary->setText(tr("%1 passed, %2 failed").arg(passedFiles).arg(failedFiles));
+    updateButtons();
+    if (failedFiles > 0)
+        flash();
+}
+
+void TestResultsPane::updateButtons()
+{
+    // Disabled until attached, running tests needs a V project anyway
+    const TestRunner *runner = m_tree ? TestRunner::instance() : nullptr;
+    const bool running = runner && runner->isRunning();
+    m_runButton->setEnabled(runner && !running);
+    m_rerunFailedButton->setEnabled(runner && !running && runner->hasFailedTests());
+    m_stopButton->setEnabled(running);
+}
+
+} // namespace Internal
+} // namespace Vcreator
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <coreplugin/ioutputpane.h>
+
+#include <QHash>
+
+QT_BEGIN_NAMESPACE
+class QLabel;
+class QToolButton;
+class QTreeWidget;
+class QTreeWidgetItem;
+class QVBoxLayout;
+QT_END_NAMESPACE
+
+namespace VCreator {
+namespace Internal {
+
+struct TestFile;
+class TestRunner;
+
+// Live results of the V test runner: one item per test file with its test
+// functions and the output of failed tests below it.
+class TestResultsPane : public Core::IOutputPane
+{
+    Q_OBJECT
+
+public:
+    TestResultsPane();
+    ~TestResultsPane() override;
+
+    // Builds the results tree and follows runner, on first V use
+    void attach(TestRunner *runner);
+
+    QWidget *outputWidget(QWidget *parent) override;
+    QList<QWidget *> toolBarWidgets() const override;
+    QString displayName() const override;
+    int priorityInStatusBar() const override;
+    void clearContents() override;
+    void visibilityChanged(bool visible) override;
+    void setFocus() override;
+    bool hasFocus() const override;
+    bool canFocus() const override;
+    bool canNavigate() const override;
+    bool canNext() const override;
+    bool canPrevious() const override;
+    void goToNext() override;
+    void goToPrev() override;
+
+private:
+    void runStarted(const QVector<TestFile> &files);
+    void fileStarted(const QString &filePath);
+    void testFinished(const QString &filePath, const QString &function, bool passed,
+                      double milliseconds);
+    void testOutput(const QString &filePath, const QString &line);
+    void fileFinished(const QString &filePath, bool passed, qint64 milliseconds);
+    void runFinished(int passedFiles, int failedFiles);
+    void updateButtons();
+    QTreeWidgetItem *testItem(const QString &filePath, const QString &function) const;
+    void navigate(int step);
+
+    QWidget *m_widget;
+    QVBoxLayout *m_layout;
+    QTreeWidget *m_tree = nullptr;
+    QToolButton *m_runButton;
+    QToolButton *m_rerunFailedButton;
+    QToolButton *m_stopButton;
+    QLabel *m_summary;
+    QHash<QString, QTreeWidgetItem *> m_fileItems;
+};
+
+} // namespace Internal
+} // namespace Vcreator
@@ -0,0 +1,404 @@
+#include "vcreatortestrunner.h"
+#include "vcreatorimportgraph.h"
+#include "vcreatorindexer.h"
+#include "vcreatorlexer.h"
+#include "vcreatorsettings.h"
+#include "vcreatorsources.h"
+
+#include <projectexplorer/project.h>
+#include <projectexplorer/projecttree.h>
+#include <projectexplorer/session.h>
+
+#include <utils/algorithm.h>
+#include <utils/runextensions.h>
+
+#include <QFileInfo>
+#include <QFutureWatcher>
+#include <QProcess>
+#include <QRegularExpression>
+#include <QThread>
+#include <QtConcurrent>
+
+#include <algorithm>
+#include <limits>
+
+namespace VCreator {
+namespace Internal {
+
+static TestRunner *m_instance = nullptr;
+
+static const char durationsKey[] = "Vcreator.TestDurations";
+static const char baselineKey[] = "Vcreator.TestBaseline";
+
+static TestFile discoverTests(const QString &filePath)
+{
+    TestFile file;
+    file.filePath = filePath;
+    const FileIndexPtr index = indexFile(filePath, SourceTokens(readSourceFile(filePath)));
+    for (const Symbol &symbol : index->symbols) {
+        if (symbol.kind == Symbol::Function && symbol.name.startsWith(QLatin1String("test_"))) {
+            file.functions.append(symbol.name);
+            file.lines.append(symbol.line);
+        }
+    }
+    return file;
+}
+
+TestRunner::TestRunner()
+{
+    m_instance = this;
+    m_futureSynchronizer.setCancelOnWait(true);
+}
+
+TestRunner::~TestRunner()
+{
+    stop();
+    m_futureSynchronizer.waitForFinished();
+    m_instance = nullptr;
+}
+
+TestRunner *TestRunner::instance()
+{
+    return m_instance;
+}
+
+ProjectExplorer::Project *TestRunner::currentProject()
+{
+    if (ProjectExplorer::Project *project = ProjectExplorer::ProjectTree::currentProject())
+        return project;
+    return ProjectExplorer::SessionManager::startupProject();
+}
+
+bool TestRunner::isRunning() const
+{
+    return m_discovering || !m_running.isEmpty() || !m_queue.isEmpty();
+}
+
+void TestRunner::runAllTests()
+{
+    runProjectTests(false);
+}
+
+void TestRunner::runAffectedTests()
+{
+    runProjectTests(true);
+}
+
+// Both take a snapshot of the project's source hashes, which becomes the
+// baseline for runAffectedTests() when every test passes.
+void TestRunner::runProjectTests(bool affectedOnly)
+{
+    ProjectExplorer::Project *project = currentProject();
+    if (!project || isRunning())
+        return;
+
+    const QStringList files = Utils::filtered(
+                Utils::transform(project->files(ProjectExplorer::Project::SourceFiles),
+                                 &Utils::FilePath::toString),
+                &isVlangSourceFile);
+    const QStringList testFiles = Utils::filtered(files, &isVlangTestFile);
+
+    m_project = project;
+    m_discovering = true;
+    const QFuture<FileHashes> future = Utils::runAsync([files] {
+        const QList<QByteArray> hashes = QtConcurrent::blockingMapped<QList<QByteArray>>(
+                    files, [](const QString &file) { return contentHash(file); });
+        FileHashes result;
+        for (int i = 0; i < files.size(); ++i)
+            result.insert(files.at(i), hashes.at(i));
+        return result;
+    });
+    m_futureSynchronizer.addFuture(future);
+
+    auto watcher = new QFutureWatcher<FileHashes>(this);
+    connect(watcher, &QFutureWatcherBase::finished, this, [this, watcher, affectedOnly, testFiles] {
+        watcher->deleteLater();
+        if (!m_discovering) // stopped
+            return;
+        m_discovering = false;
+        const FileHashes hashes = watcher->result();
+        startRun(affectedOnly ? affectedTestFiles(testFiles, hashes) : testFiles, {}, hashes);
+    });
+    watcher->setFuture(future);
+}
+
+QStringList TestRunner::affectedTestFiles(const QStringList &testFiles,
+                                          const FileHashes &hashes) const
+{
+    const QVariantMap baseline = m_project ? m_project->namedSettings(baselineKey).toMap()
+                                           : QVariantMap();
+    if (baseline.isEmpty())
+        return testFiles;
+
+    QSet<QString> changedFiles;
+    for (auto it = hashes.cbegin(); it != hashes.cend(); ++it) {
+        if (baseline.value(it.key()).toByteArray() != it->toHex())
+            changedFiles.insert(it.key());
+    }
+    for (auto it = baseline.cbegin(); it != baseline.cend(); ++it) {
+        if (!hashes.contains(it.key()))
+            changedFiles.insert(it.key());
+    }
+
+    // Modules with changed files and everything importing them, transitively
+    QSet<QString> impactedModules;
+    QStringList pending;
+    for (const QString &file : qAsConst(changedFiles))
+        pending.append(QFileInfo(file).absolutePath());
+    while (!pending.isEmpty()) {
+        const QString module = pending.takeLast();
+        if (impactedModules.contains(module))
+            continue;
+        impactedModules.insert(module);
+        pending.append(ImportGraph::instance()->importingModules(module));
+    }
+
+    return Utils::filtered(testFiles, [&](const QString &file) {
+        return changedFiles.contains(file)
+                || impactedModules.contains(QFileInfo(file).absolutePath());
+    });
+}
+
+void TestRunner::runTestFiles(const QStringList &files, const QHash<QString, QStringList> &functions)
+{
+    if (!isRunning() && !files.isEmpty())
+        startRun(files, functions, {});
+}
+
+void TestRunner::startRun(const QStringList &files, const QHash<QString, QStringList> &functions,
+                          const FileHashes &baseline)
+{
+    m_project = currentProject();
+    m_functions = functions;
+    m_pendingBaseline = baseline;
+    m_discovering = true;
+    loadDurations();
+
+    const QFuture<TestFile> future = Utils::runAsync([files](QFutureInterface<TestFile> &fi) {
+        const QList<TestFile> discovered = QtConcurrent::blockingMapped<QList<TestFile>>(files, discoverTests);
+        for (const TestFile &file : discovered)
+            fi.reportResult(file);
+    });
+    m_futureSynchronizer.addFuture(future);
+
+    auto watcher = new QFutureWatcher<TestFile>(this);
+    connect(watcher, &QFutureWatcherBase::finished, this, [this, watcher] {
+        watcher->deleteLater();
+        if (!m_discovering) // stopped
+            return;
+        m_discovering = false;
+        start(watcher->future().results().toVector());
+    });
+    watcher->setFuture(future);
+}
+
+void TestRunner::rerunFailedTests()
+{
+    QHash<QString, QStringList> functions;
+    for (auto it = m_failed.cbegin(); it != m_failed.cend(); ++it) {
+        if (!it->isEmpty())
+            functions.insert(it.key(), it->values());
+    }
+    runTestFiles(m_failed.keys(), functions);
+}
+
+void TestRunner::stop()
+{
+    m_discovering = false;
+    m_queue.clear();
+    const QList<QProcess *> processes = m_running.keys();
+    for (QProcess *process : processes) {
+        process->disconnect(this);
+        process->kill();
+        process->waitForFinished(1000);
+        process->deleteLater();
+    }
+    if (!m_running.isEmpty()) {
+        m_failedFiles += m_running.size();
+        m_running.clear();
+        finishRun();
+    }
+}
+
+void TestRunner::start(const QVector<TestFile> &files)
+{
+    m_queue = files;
+    // Slowest first, so a long test does not start last and keep one slot
+    // busy after the others finished. Files without history count as slow.
+    const auto duration = [this](const TestFile &file) {
+        return m_durations.value(file.filePath, std::numeric_limits<double>::max());
+    };
+    std::stable_sort(m_queue.begin(), m_queue.end(), [&](const TestFile &a, const TestFile &b) {
+        return duration(a) > duration(b);
+    });
+
+    const int concurrency = VlangSettings::testConcurrency();
+    m_maxRunning = concurrency > 0 ? concurrency : qMax(1, QThread::idealThreadCount());
+    m_passedFiles = 0;
+    m_failedFiles = 0;
+    for (const TestFile &file : files)
+        m_failed.remove(file.filePath);
+
+    emit runStarted(m_queue);
+    startNext();
+    if (m_queue.isEmpty() && m_running.isEmpty())
+        finishRun();
+}
+
+QString TestRunner::workingDirectory(const QString &testFile)
+{
+    const QString directory = QFileInfo(testFile).absolutePath();
+    const QString projectRoot = findProjectRoot(directory);
+    return projectRoot.isEmpty() ? directory : projectRoot;
+}
+
+void TestRunner::startNext()
+{
+    const QString compiler = VlangSettings::compilerPath().toString();
+    while (m_running.size() < m_maxRunning && !m_queue.isEmpty()) {
+        Slot slot;
+        slot.file = m_queue.takeFirst();
+
+        auto process = new QProcess(this);
+        process->setProcessChannelMode(QProcess::MergedChannels);
+        process->setWorkingDirectory(workingDirectory(slot.file.filePath));
+
+        const QStringList functions = m_functions.value(slot.file.filePath);
+        if (!functions.isEmpty()) {
+            QProcessEnvironment environment = QProcessEnvironment::systemEnvironment();
+            environment.insert("VTEST_ONLY_FN", functions.join(QLatin1Char(',')));
+            process->setProcessEnvironment(environment);
+        }
+
+        connect(process, &QProcess::readyRead, this, [this, process] { readOutput(process); });
+        connect(process, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished),
+                this, [this, process] { processFinished(process); });
+        connect(process, &QProcess::errorOccurred, this, [this, process](QProcess::ProcessError error) {
+            if (error == QProcess::FailedToStart)
+                processFinished(process);
+        });
+
+        emit fileStarted(slot.file.filePath);
+        slot.timer.start();
+        m_running.insert(process, slot);
+        process->start(compiler, {"-stats", "test", slot.file.filePath});
+    }
+}
+
+void TestRunner::readOutput(QProcess *process)
+{
+    auto it = m_running.find(process);
+    if (it == m_running.end())
+        return;
+
+    Slot &slot = *it;
+    slot.pendingOutput.append(process->readAll());
+    int start = 0;
+    for (int end = slot.pendingOutput.indexOf('\n'); end != -1;
+         end = slot.pendingOutput.indexOf('\n', start)) {
+        handleLine(slot, QString::fromUtf8(slot.pendingOutput.mid(start, end - start)).trimmed());
+        start = end + 1;
+    }
+    slot.pendingOutput.remove(0, start);
+}
+
+void TestRunner::handleLine(Slot &slot, const QString &line)
+{
+    if (line.isEmpty())
+        return;
+
+    // "OK    [1/3]     0.012 ms     2 asserts | main.test_foo()"
+    static const QRegularExpression statsLine(
+                R"(^(OK|FAIL)\b.*?([\d.]+)\s*ms.*\|\s*(?:[\w.]+\.)?(test_\w+)\(\))");
+    const QRegularExpressionMatch stats = statsLine.match(line);
+    if (stats.hasMatch()) {
+        const bool passed = stats.captured(1) == QLatin1String("OK");
+        const QString function = stats.captured(3);
+        const double milliseconds = stats.captured(2).toDouble();
+        slot.functionResults = true;
+        if (!passed)
+            slot.failedFunctions.insert(function);
+        m_durations.insert(slot.file.filePath + QLatin1Char(':') + function, milliseconds);
+        emit testFinished(slot.file.filePath, function, passed, milliseconds);
+        return;
+    }
+
+    // "/path/foo_test.v:12: ✗ fn test_foo"
+    static const QRegularExpression failedAssert(QStringLiteral(R"(: ✗ fn (test_\w+))"));
+    const QRegularExpressionMatch failure = failedAssert.match(line);
+    if (failure.hasMatch())
+        slot.failedFunctions.insert(failure.captured(1));
+
+    emit testOutput(slot.file.filePath, line);
+}
+
+void TestRunner::processFinished(QProcess *process)
+{
+    process->deleteLater();
+    auto it = m_running.find(process);
+    if (it == m_running.end())
+        return;
+
+    Slot slot = it.value();
+    m_running.erase(it);
+    slot.pendingOutput.append(process->readAll());
+    if (!slot.pendingOutput.isEmpty())
+        handleLine(slot, QString::fromUtf8(slot.pendingOutput).trimmed());
+
+    const bool passed = process->error() != QProcess::FailedToStart
+            && process->exitStatus() == QProcess::NormalExit && process->exitCode() == 0;
+    const qint64 elapsed = slot.timer.elapsed();
+    m_durations.insert(slot.file.filePath, elapsed);
+
+    if (passed) {
+        ++m_passedFiles;
+    } else {
+        ++m_failedFiles;
+        // Without per-test results the whole file has to run again
+        m_failed.insert(slot.file.filePath,
+                        slot.functionResults ? slot.failedFunctions : QSet<QString>());
+    }
+    emit fileFinished(slot.file.filePath, passed, elapsed);
+
+    startNext();
+    if (m_running.isEmpty() && m_queue.isEmpty())
+        finishRun();
+}
+
+void TestRunner::finishRun()
+{
+    saveDurations();
+    if (m_project && m_failedFiles == 0 && !m_pendingBaseline.isEmpty()) {
+        QVariantMap baseline;
+        for (auto it = m_pendingBaseline.cbegin(); it != m_pendingBaseline.cend(); ++it)
+            baseline.insert(it.key(), it->toHex());
+        m_project->setNamedSettings(baselineKey, baseline);
+    }
+    m_pendingBaseline.clear();
+    emit runFinished(m_passedFiles, m_failedFiles);
+}
+
+void TestRunner::loadDurations()
+{
+    if (!m_project)
+        return;
+    const QVariantMap durations = m_project->namedSettings(durationsKey).toMap();
+    for (auto it = durations.cbegin(); it != durations.cend(); ++it)
+        m_durations.insert(it.key(), it->toDouble());
+}
+
+void TestRunner::saveDurations()
+{
+    if (!m_project)
+        return;
+    const QString projectDirectory = m_project->projectDirectory().toString();
+    QVariantMap durations;
+    for (auto it = m_durations.cbegin(); it != m_durations.cend(); ++it) {
+        if (it.key().startsWith(projectDirectory))
+            durations.insert(it.key(), it.value());
+    }
+    m_project->setNamedSettings(durationsKey, durations);
+}
+
+} // namespace Internal
+} // namespace Vcreator
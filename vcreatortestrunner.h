@@ -0,0 +1,110 @@
+#pragma once
+
+#include <utils/futuresynchronizer.h>
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QObject>
+#include <QPointer>
+#include <QSet>
+#include <QVector>
+
+QT_BEGIN_NAMESPACE
+class QProcess;
+QT_END_NAMESPACE
+
+namespace ProjectExplorer { class Project; }
+
+namespace VCreator {
+namespace Internal {
+
+struct TestFile
+{
+    QString filePath;
+    QStringList functions; // test_ functions in declaration order
+    QVector<int> lines;    // 1-based, parallel to functions
+};
+
+// Runs _test.v files with "v -stats test", one compiler process per file.
+// Files are handed to a bounded set of parallel slots, slowest first as
+// measured by earlier runs. Results are reported per test function while
+// the output arrives.
+class TestRunner : public QObject
+{
+    Q_OBJECT
+
+public:
+    TestRunner();
+    ~TestRunner() override;
+
+    static TestRunner *instance();
+
+    // All _test.v files of the current project.
+    void runAllTests();
+    // Only the test files in or (transitively) importing modules whose files
+    // changed since the last run in which all tests passed.
+    void runAffectedTests();
+    // When functions has an entry for a file, only those tests of it run.
+    void runTestFiles(const QStringList &files,
+                      const QHash<QString, QStringList> &functions = {});
+    void rerunFailedTests();
+    void stop();
+
+    bool isRunning() const;
+    bool hasFailedTests() const { return !m_failed.isEmpty(); }
+
+    static ProjectExplorer::Project *currentProject();
+    // Tests run in the project root, locations in their output are relative to it.
+    static QString workingDirectory(const QString &testFile);
+
+signals:
+    void runStarted(const QVector<TestFile> &files);
+    void fileStarted(const QString &filePath);
+    void testFinished(const QString &filePath, const QString &function, bool passed,
+                      double milliseconds);
+    void testOutput(const QString &filePath, const QString &line);
+    void fileFinished(const QString &filePath, bool passed, qint64 milliseconds);
+    void runFinished(int passedFiles, int failedFiles);
+
+private:
+    struct Slot
+    {
+        TestFile file;
+        QElapsedTimer timer;
+        QByteArray pendingOutput;
+        QSet<QString> failedFunctions;
+        bool functionResults = false;
+    };
+
+    using FileHashes = QHash<QString, QByteArray>;
+
+    void runProjectTests(bool affectedOnly);
+    void startRun(const QStringList &files, const QHash<QString, QStringList> &functions,
+                  const FileHashes &baseline);
+    QStringList affectedTestFiles(const QStringList &testFiles, const FileHashes &hashes) const;
+    void start(const QVector<TestFile> &files);
+    void startNext();
+    void readOutput(QProcess *process);
+    void handleLine(Slot &slot, const QString &line);
+    void processFinished(QProcess *process);
+    void finishRun();
+    void loadDurations();
+    void saveDurations();
+
+    QPointer<ProjectExplorer::Project> m_project;
+    QHash<QString, QStringList> m_functions;
+    FileHashes m_pendingBaseline; // recorded when the run passes
+    QVector<TestFile> m_queue;
+    QHash<QProcess *, Slot> m_running;
+    int m_maxRunning = 1;
+    int m_passedFiles = 0;
+    int m_failedFiles = 0;
+    bool m_discovering = false;
+
+    QHash<QString, QSet<QString>> m_failed; // empty set: whole file
+    QHash<QString, double> m_durations;     // "file" and "file:function" -> ms
+    Utils::FutureSynchronizer m_futureSynchronizer;
+};
+
+} // namespace Internal
+} // namespace Vcreator
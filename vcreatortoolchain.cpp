@@ -0,0 +1,254 @@
+#include "vcreatortoolchain.h"
+#include "vcreatorconstants.h"
+#include "vcreatorsettings.h"
+
+#include <coreplugin/icore.h>
+#include <utils/hostosinfo.h>
+#include <utils/runextensions.h>
+
+#include <QDir>
+#include <QFileInfo>
+#include <QFutureWatcher>
+#include <QProcess>
+#include <QSettings>
+#include <QStandardPaths>
+
+namespace VCreator {
+namespace Internal {
+
+static ToolchainManager *m_instance = nullptr;
+
+static const char toolchainsKey[] = "Toolchains";
+static const int probeTimeout = 10000;
+
+static QDateTime lastModified(const Utils::FilePath &compiler)
+{
+    return QFileInfo(compiler.toString()).lastModified();
+}
+
+static Toolchain probeToolchain(const Utils::FilePath &compiler)
+{
+    Toolchain toolchain;
+    toolchain.compiler = compiler;
+    toolchain.lastModified = lastModified(compiler);
+
+    QProcess process;
+    process.start(compiler.toString(), {QLatin1String("version")});
+    if (!process.waitForFinished(probeTimeout)) {
+        process.kill();
+        process.waitForFinished();
+        return toolchain;
+    }
+    if (process.exitStatus() != QProcess::NormalExit || process.exitCode() != 0)
+        return toolchain;
+    toolchain.version = QString::fromLocal8Bit(process.readAllStandardOutput()).trimmed();
+
+    // vlib and the bundled tcc live next to the real binary, not the symlink
+    const QDir root = QFileInfo(QFileInfo(compiler.toString()).canonicalFilePath()).absoluteDir();
+    if (root.exists(QLatin1String("vlib")))
+        toolchain.vlibDirectory = root.absoluteFilePath(QLatin1String("vlib"));
+    toolchain.cBackend = root.exists(QLatin1String("thirdparty/tcc/tcc.exe"))
+            ? QLatin1String("tcc") : QLatin1String("cc");
+    return toolchain;
+}
+
+static QVector<Utils::FilePath> candidateCompilers()
+{
+    const QString v = Utils::HostOsInfo::withExecutableSuffix(QLatin1String("v"));
+
+    QStringList directories = QString::fromLocal8Bit(qgetenv("PATH"))
+            .split(QDir::listSeparator(), Qt::SkipEmptyParts);
+    directories << QDir::homePath() + QLatin1String("/v")
+                << QLatin1String("/opt/v")
+                << QLatin1String("/opt/vlang");
+
+    QVector<Utils::FilePath> result;
+    QSet<QString> seen;
+    for (const QString &directory : qAsConst(directories)) {
+        const QFileInfo candidate(QDir(directory).absoluteFilePath(v));
+        if (!candidate.isFile() || !candidate.isExecutable())
+            continue;
+        if (seen.contains(candidate.canonicalFilePath()))
+            continue;
+        seen.insert(candidate.canonicalFilePath());
+        result.append(Utils::FilePath::fromString(candidate.absoluteFilePath()));
+    }
+    return result;
+}
+
+static QVector<Toolchain> detectToolchains(const QHash<Utils::FilePath, Toolchain> &cache)
+{
+    QVector<Toolchain> result;
+    for (const Utils::FilePath &compiler : candidateCompilers()) {
+        const auto cached = cache.constFind(compiler);
+        if (cached != cache.constEnd() && cached->lastModified == lastModified(compiler))
+            result.append(*cached);
+        else
+            result.append(probeToolchain(compiler));
+    }
+    return result;
+}
+
+ToolchainManager::ToolchainManager()
+{
+    m_instance = this;
+    m_futureSynchronizer.setCancelOnWait(true);
+}
+
+ToolchainManager::~ToolchainManager()
+{
+    m_futureSynchronizer.waitForFinished();
+    m_instance = nullptr;
+}
+
+ToolchainManager *ToolchainManager::instance()
+{
+    return m_instance;
+}
+
+void ToolchainManager::detect()
+{
+    if (m_detectionStarted)
+        return;
+    m_detectionStarted = true;
+    loadCache();
+
+    const QFuture<QVector<Toolchain>> future = Utils::runAsync(detectToolchains, m_cache);
+    m_futureSynchronizer.addFuture(future);
+
+    auto watcher = new QFutureWatcher<QVector<Toolchain>>(this);
+    connect(watcher, &QFutureWatcherBase::finished, this, [this, watcher] {
+        watcher->deleteLater();
+        if (watcher->isCanceled())
+            return;
+        m_detected.clear();
+        for (const Toolchain &toolchain : watcher->result()) {
+            m_detected.append(toolchain.compiler);
+            insert(toolchain);
+        }
+        m_detectionFinished = true;
+        saveCache();
+        emit toolchainsDetected();
+        updateCurrent();
+    });
+    watcher->setFuture(future);
+}
+
+QVector<Toolchain> ToolchainManager::toolchains() const
+{
+    QVector<Toolchain> result;
+    for (const Utils::FilePath &compiler : m_detected)
+        result.append(m_cache.value(compiler));
+    return result;
+}
+
+Utils::FilePath ToolchainManager::defaultCompiler() const
+{
+    if (m_detectionFinished)
+        return m_detected.isEmpty() ? Utils::FilePath() : m_detected.first();
+    return Utils::FilePath::fromString(QStandardPaths::findExecutable(QLatin1String("v")));
+}
+
+Toolchain ToolchainManager::toolchain(const Utils::FilePath &compiler)
+{
+    detect();
+    if (compiler.isEmpty())
+        return {};
+
+    // Failed probes are cached as well, a broken binary is only probed
+    // again once it changes
+    const auto it = m_cache.constFind(compiler);
+    const Toolchain cached = it != m_cache.constEnd() ? *it : Toolchain();
+    if (it != m_cache.constEnd() && cached.lastModified == lastModified(compiler))
+        return cached;
+    if (m_probing.contains(compiler))
+        return cached;
+
+    m_probing.insert(compiler);
+    const QFuture<Toolchain> future = Utils::runAsync(probeToolchain, compiler);
+    m_futureSynchronizer.addFuture(future);
+
+    auto watcher = new QFutureWatcher<Toolchain>(this);
+    connect(watcher, &QFutureWatcherBase::finished, this, [this, watcher, compiler] {
+        watcher->deleteLater();
+        m_probing.remove(compiler);
+        if (watcher->isCanceled())
+            return;
+        insert(watcher->result());
+        saveCache();
+        emit toolchainProbed(compiler);
+        updateCurrent();
+    });
+    watcher->setFuture(future);
+    return cached;
+}
+
+Toolchain ToolchainManager::current()
+{
+    return toolchain(VlangSettings::compilerPath());
+}
+
+QString ToolchainManager::vlibDirectory() const
+{
+    QMutexLocker locker(&m_currentMutex);
+    return m_vlibDirectory;
+}
+
+void ToolchainManager::updateCurrent()
+{
+    const QString vlibDirectory = current().vlibDirectory;
+    {
+        QMutexLocker locker(&m_currentMutex);
+        if (m_vlibDirectory == vlibDirectory)
+            return;
+        m_vlibDirectory = vlibDirectory;
+    }
+    emit currentChanged();
+}
+
+void ToolchainManager::insert(const Toolchain &toolchain)
+{
+    if (!toolchain.compiler.isEmpty())
+        m_cache.insert(toolchain.compiler, toolchain);
+}
+
+void ToolchainManager::loadCache()
+{
+    QSettings *s = Core::ICore::settings();
+    s->beginGroup(Constants::C_VLANG_SETTINGS_GROUP);
+    const QVariantList entries = s->value(toolchainsKey).toList();
+    s->endGroup();
+
+    for (const QVariant &entry : entries) {
+        const QVariantMap map = entry.toMap();
+        Toolchain toolchain;
+        toolchain.compiler = Utils::FilePath::fromVariant(map.value("Compiler"));
+        toolchain.lastModified = map.value("LastModified").toDateTime();
+        toolchain.version = map.value("Version").toString();
+        toolchain.vlibDirectory = map.value("Vlib").toString();
+        toolchain.cBackend = map.value("CBackend").toString();
+        insert(toolchain);
+    }
+}
+
+void ToolchainManager::saveCache() const
+{
+    QVariantList entries;
+    for (const Toolchain &toolchain : m_cache) {
+        QVariantMap map;
+        map.insert("Compiler", toolchain.compiler.toVariant());
+        map.insert("LastModified", toolchain.lastModified);
+        map.insert("Version", toolchain.version);
+        map.insert("Vlib", toolchain.vlibDirectory);
+        map.insert("CBackend", toolchain.cBackend);
+        entries.append(map);
+    }
+
+    QSettings *s = Core::ICore::settings();
+    s->beginGroup(Constants::C_VLANG_SETTINGS_GROUP);
+    s->setValue(toolchainsKey, entries);
+    s->endGroup();
+}
+
+} // namespace Internal
+} // namespace Vcreator
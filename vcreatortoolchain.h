@@ -0,0 +1,86 @@
+#pragma once
+
+#include <utils/fileutils.h>
+#include <utils/futuresynchronizer.h>
+
+#include <QDateTime>
+#include <QHash>
+#include <QMutex>
+#include <QObject>
+#include <QSet>
+#include <QVector>
+
+namespace VCreator {
+namespace Internal {
+
+struct Toolchain
+{
+    Utils::FilePath compiler;
+    QDateTime lastModified;  // of compiler when probed
+    QString version;         // "V 0.2.2 0cb3ef5", empty when the probe failed
+    QString vlibDirectory;
+    QString cBackend;        // C compiler used by default, "tcc" or "cc"
+
+    bool isValid() const { return !version.isEmpty(); }
+};
+
+// V installations found in PATH, ~/v and /opt, and what "v version" says
+// about them. Detection runs once per session on a worker thread, binaries
+// are probed in the background as well and the results are cached across
+// sessions keyed by the binary's modification time. Nothing here waits for
+// a process: lookups return what is known and signal when more is.
+class ToolchainManager : public QObject
+{
+    Q_OBJECT
+
+public:
+    ToolchainManager();
+    ~ToolchainManager() override;
+
+    static ToolchainManager *instance();
+
+    // Starts detection, does nothing after the first call.
+    void detect();
+    QVector<Toolchain> toolchains() const;
+
+    // First detected compiler. Until detection has finished this falls
+    // back to "v" in PATH.
+    Utils::FilePath defaultCompiler() const;
+
+    // Cached information for compiler, starts probing it when it is
+    // unknown or the binary changed since. toolchainProbed() is emitted
+    // once the probe is done.
+    Toolchain toolchain(const Utils::FilePath &compiler);
+    // Toolchain of VlangSettings::compilerPath()
+    Toolchain current();
+
+    // vlib of the current toolchain, may be called from any thread. Empty
+    // until the toolchain is probed.
+    QString vlibDirectory() const;
+
+    // To be called when the configured compiler changed.
+    void updateCurrent();
+
+signals:
+    void toolchainsDetected();
+    void toolchainProbed(const Utils::FilePath &compiler);
+    void currentChanged();
+
+private:
+    void loadCache();
+    void saveCache() const;
+    void insert(const Toolchain &toolchain);
+
+    bool m_detectionStarted = false;
+    bool m_detectionFinished = false;
+    QVector<Utils::FilePath> m_detected;
+    QHash<Utils::FilePath, Toolchain> m_cache;
+    QSet<Utils::FilePath> m_probing;
+    Utils::FutureSynchronizer m_futureSynchronizer;
+
+    mutable QMutex m_currentMutex;
+    QString m_vlibDirectory;
+};
+
+} // namespace Internal
+} // namespace Vcreator
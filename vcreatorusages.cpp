@@ -0,0 +1,459 @@
+#include "vcreatorusages.h"
+#include "vcreatorconstants.h"
+#include "vcreatorlexer.h"
+#include "vcreatorsources.h"
+#include "vcreatorsymbolindex.h"
+#include "ide.h"
+
+#include <coreplugin/editormanager/documentmodel.h>
+#include <coreplugin/editormanager/editormanager.h>
+#include <coreplugin/find/searchresultwindow.h>
+#include <coreplugin/icore.h>
+#include <coreplugin/progressmanager/progressmanager.h>
+#include <texteditor/textdocument.h>
+#include <texteditor/texteditor.h>
+#include <utils/runextensions.h>
+
+#include <QDir>
+#include <QFile>
+#include <QFutureWatcher>
+#include <QHash>
+#include <QMessageBox>
+#include <QSaveFile>
+#include <QTextBlock>
+#include <QTextCursor>
+#include <QTextDocument>
+#include <QtConcurrent>
+
+#include <algorithm>
+
+namespace VCreator {
+namespace Internal {
+
+static bool isIdentifierStart(QChar ch)
+{
+    return ch.isLetter() || ch == QLatin1Char('_');
+}
+
+static bool isIdentifierPart(QChar ch)
+{
+    return ch.isLetterOrNumber() || ch == QLatin1Char('_');
+}
+
+template <typename Handler>
+static void forEachInterpolatedIdentifier(const QString &text, const Token &string, Handler &&handler)
+{
+    const int end = string.end();
+    int i = string.begin();
+    while (i < end) {
+        const QChar ch = text.at(i);
+        if (ch == QLatin1Char('\\')) {
+            i += 2;
+            continue;
+        }
+        if (ch != QLatin1Char('$') || i + 1 >= end) {
+            ++i;
+            continue;
+        }
+
+        const QChar la = text.at(i + 1);
+        if (la == QLatin1Char('{')) {
+            const int exprStart = i + 2;
+            int exprEnd = text.indexOf(QLatin1Char('}'), exprStart);
+            if (exprEnd == -1 || exprEnd > end)
+                exprEnd = end;
+
+            Scanner scanner;
+            const QList<Token> tokens = scanner(text.mid(exprStart, exprEnd - exprStart));
+            for (const Token &token : tokens) {
+                if (token.is(Token::Identifier))
+                    handler(exprStart + token.offset, token.length);
+            }
+            i = exprEnd + 1;
+        } else if (isIdentifierStart(la)) {
+            // '$foo.bar' references both foo and its field bar
+            int j = i + 1;
+            while (j < end && isIdentifierStart(text.at(j))) {
+                const int start = j;
+                while (j < end && isIdentifierPart(text.at(j)))
+                    ++j;
+                handler(start, j - start);
+                if (j + 1 < end && text.at(j) == QLatin1Char('.') && isIdentifierStart(text.at(j + 1)))
+                    ++j;
+                else
+                    break;
+            }
+            i = j;
+        } else {
+            ++i;
+        }
+    }
+}
+
+template <typename Tokens, typename Handler>
+static void forEachIdentifier(const QString &text, const Tokens &tokens, Handler &&handler)
+{
+    for (const Token &token : tokens) {
+        if (token.is(Token::Identifier))
+            handler(token.offset, token.length);
+        else if (token.is(Token::String))
+            forEachInterpolatedIdentifier(text, token, handler);
+    }
+}
+
+QVector<Usage> findUsagesInTokens(const QString &filePath, const SourceTokens &tokens, const QString &name)
+{
+    QVector<Usage> usages;
+    const QString &text = tokens.text();
+    forEachIdentifier(text, tokens.tokens(), [&](int offset, int length) {
+        if (length != name.length() || QStringView(text).mid(offset, length) != name)
+            return;
+
+        Usage usage;
+        usage.filePath = filePath;
+        usage.line = tokens.lineAt(offset);
+        usage.column = offset - tokens.lineStart(usage.line);
+        usage.length = length;
+        usage.lineText = tokens.lineText(usage.line);
+        usages.append(usage);
+    });
+    return usages;
+}
+
+QString identifierUnderCursor(const QTextCursor &cursor, int *start)
+{
+    const QTextBlock block = cursor.block();
+    const QString text = block.text();
+    const int previousState = block.previous().userState();
+    const int pos = cursor.positionInBlock();
+
+    Scanner scanner;
+    const QList<Token> tokens = scanner(text, previousState == -1
+                                        ? int(Scanner::Normal)
+                                        : previousState & Scanner::MultiLineMask);
+    QString result;
+    forEachIdentifier(text, tokens, [&](int offset, int length) {
+        if (result.isEmpty() && pos >= offset && pos <= offset + length) {
+            result = text.mid(offset, length);
+            if (start)
+                *start = block.position() + offset;
+        }
+    });
+    return result;
+}
+
+template <typename CharAt>
+static QString qualifierBefore(const CharAt &characterAt, int identifierStart, bool *qualified)
+{
+    int pos = identifierStart - 1;
+    const bool hasDot = pos >= 0 && characterAt(pos) == QLatin1Char('.');
+    if (qualified)
+        *qualified = hasDot;
+    if (!hasDot)
+        return QString();
+
+    const int end = pos;
+    while (pos > 0 && isIdentifierPart(characterAt(pos - 1)))
+        --pos;
+    if (pos == end || !isIdentifierStart(characterAt(pos)))
+        return QString();
+
+    QString qualifier;
+    for (int i = pos; i < end; ++i)
+        qualifier.append(characterAt(i));
+    return qualifier;
+}
+
+QString qualifierAt(const QTextDocument *document, int identifierStart, bool *qualified)
+{
+    return qualifierBefore([document](int pos) { return document->characterAt(pos); },
+                           identifierStart, qualified);
+}
+
+// Where a symbol is declared. Usages are the occurrences Follow Symbol
+// would take there, plus the declaring identifier itself.
+struct Declaration
+{
+    QString filePath;
+    int line = 0;   // 1-based
+    int column = 0; // 0-based
+
+    bool isValid() const { return !filePath.isEmpty(); }
+    bool operator==(const Declaration &other) const
+    { return filePath == other.filePath && line == other.line && column == other.column; }
+};
+
+static Declaration declarationOf(const QString &filePath, const QString &qualifier,
+                                 const QString &name, bool qualified)
+{
+    const QVector<SymbolRef> symbols = SymbolIndex::instance()->resolve(filePath, qualifier,
+                                                                        name, qualified);
+    if (symbols.isEmpty())
+        return Declaration();
+    const SymbolRef &symbol = symbols.first();
+    return {symbol.file->filePath, symbol.symbol().line, symbol.symbol().column};
+}
+
+static QVector<Usage> usagesOf(const QString &file, const QString &text, const QString &name,
+                               const Declaration &declaration)
+{
+    const SourceTokens tokens(text);
+    QVector<Usage> usages = findUsagesInTokens(file, tokens, name);
+    if (!declaration.isValid())
+        return usages;
+
+    // Names resolve the same everywhere in a file, per qualifier
+    QHash<QString, Declaration> resolved;
+    const auto characterAt = [&text](int pos) { return text.at(pos); };
+
+    usages.erase(std::remove_if(usages.begin(), usages.end(), [&](const Usage &usage) {
+        if (usage.filePath == declaration.filePath && usage.line == declaration.line
+                && usage.column == declaration.column) {
+            return false;
+        }
+        bool qualified = false;
+        const QString qualifier = qualifierBefore(characterAt,
+                                                  tokens.lineStart(usage.line) + usage.column,
+                                                  &qualified);
+        const QString key = qualified ? qualifier + QLatin1Char('.') : QString();
+        auto it = resolved.constFind(key);
+        if (it == resolved.constEnd())
+            it = resolved.insert(key, declarationOf(file, qualifier, name, qualified));
+        return !(*it == declaration);
+    }), usages.end());
+    return usages;
+}
+
+static void searchFiles(QFutureInterface<Usage> &futureInterface,
+                        const QStringList &files,
+                        const QHash<QString, DocumentSnapshot> &openContents,
+                        const QString &name,
+                        const Declaration &declaration)
+{
+    futureInterface.setProgressRange(0, files.size());
+    QAtomicInt done = 0;
+    QtConcurrent::blockingMap(files.constBegin(), files.constEnd(), [&](const QString &file) {
+        if (futureInterface.isCanceled())
+            return;
+
+        const auto open = openContents.constFind(file);
+        const QString text = open != openContents.constEnd() ? open->text() : readSourceFile(file);
+        // Cheap substring check first, most files do not mention the name at all
+        if (text.contains(name)) {
+            const QVector<Usage> usages = usagesOf(file, text, name, declaration);
+            if (!usages.isEmpty())
+                futureInterface.reportResults(usages);
+        }
+        futureInterface.setProgressValue(++done);
+    });
+}
+
+static void sortBackwards(QVector<Usage> &usages)
+{
+    std::sort(usages.begin(), usages.end(), [](const Usage &a, const Usage &b) {
+        return a.line != b.line ? a.line > b.line : a.column > b.column;
+    });
+}
+
+// Returns whether all usages were still found
+static bool renameInDocument(QTextDocument *document, QVector<Usage> usages,
+                             const QString &oldName, const QString &newName)
+{
+    sortBackwards(usages);
+
+    // One edit block per document, so a single undo reverts the rename
+    QTextCursor cursor(document);
+    cursor.beginEditBlock();
+    bool complete = true;
+    for (const Usage &usage : qAsConst(usages)) {
+        const QTextBlock block = document->findBlockByNumber(usage.line - 1);
+        if (!block.isValid() || block.text().mid(usage.column, usage.length) != oldName) {
+            complete = false;
+            continue;
+        }
+        cursor.setPosition(block.position() + usage.column);
+        cursor.setPosition(block.position() + usage.column + usage.length, QTextCursor::KeepAnchor);
+        cursor.insertText(newName);
+    }
+    cursor.endEditBlock();
+    return complete;
+}
+
+// Returns why not all usages in filePath were renamed, an empty string on success
+static QString renameInFile(const QString &filePath, QVector<Usage> usages,
+                            const QString &oldName, const QString &newName)
+{
+    QFile source(filePath);
+    if (!source.open(QFile::ReadOnly))
+        return VlangUsages::tr("%1: %2").arg(QDir::toNativeSeparators(filePath), source.errorString());
+    QString text = QString::fromUtf8(source.readAll());
+    source.close();
+
+    QVector<int> lineStarts{0};
+    for (int i = text.indexOf(QLatin1Char('\n')); i != -1; i = text.indexOf(QLatin1Char('\n'), i + 1))
+        lineStarts.append(i + 1);
+
+    sortBackwards(usages);
+    int renamed = 0;
+    for (const Usage &usage : qAsConst(usages)) {
+        if (usage.line < 1 || usage.line > lineStarts.size())
+            continue;
+        const int offset = lineStarts.at(usage.line - 1) + usage.column;
+        if (QStringView(text).mid(offset, usage.length) != oldName)
+            continue;
+        text.replace(offset, usage.length, newName);
+        ++renamed;
+    }
+
+    if (renamed > 0) {
+        QSaveFile file(filePath);
+        if (!file.open(QFile::WriteOnly) || file.write(text.toUtf8()) < 0 || !file.commit())
+            return VlangUsages::tr("%1: %2").arg(QDir::toNativeSeparators(filePath), file.errorString());
+    }
+    if (renamed < usages.size())
+        return VlangUsages::tr("%1: changed since the search").arg(QDir::toNativeSeparators(filePath));
+    return QString();
+}
+
+using FileUsages = QPair<QString, QVector<Usage>>;
+
+static void renameInFiles(QFutureInterface<QString> &futureInterface,
+                          const QVector<FileUsages> &files,
+                          const QString &oldName,
+                          const QString &newName)
+{
+    futureInterface.setProgressRange(0, files.size());
+    QAtomicInt done = 0;
+    QtConcurrent::blockingMap(files.constBegin(), files.constEnd(), [&](const FileUsages &file) {
+        const QString error = renameInFile(file.first, file.second, oldName, newName);
+        if (!error.isEmpty())
+            futureInterface.reportResult(error);
+        futureInterface.setProgressValue(++done);
+    });
+}
+
+static Usage usageFromItem(const Core::SearchResultItem &item)
+{
+// TODO: Remove after Qt Creator 5.0 release
+#if QTCREATOR_VERSION >= QTCREATOR_VERSION_CHECK(4,82,0)
+    return item.userData().value<Usage>();
+#else
+    return item.userData.value<Usage>();
+#endif
+}
+
+void VlangUsages::findUsages(TextEditor::TextEditorWidget *editor)
+{
+    startSearch(editor, false);
+}
+
+void VlangUsages::renameSymbol(TextEditor::TextEditorWidget *editor)
+{
+    startSearch(editor, true);
+}
+
+void VlangUsages::startSearch(TextEditor::TextEditorWidget *editor, bool replace)
+{
+    int start = -1;
+    const QString name = identifierUnderCursor(editor->textCursor(), &start);
+    if (name.isEmpty())
+        return;
+    const QString filePath = editor->textDocument()->filePath().toString();
+
+    // Names the index does not know, like locals and parameters, are only
+    // searched by name in this file
+    bool qualified = false;
+    const QString qualifier = qualifierAt(editor->document(), start, &qualified);
+    const Declaration declaration = declarationOf(filePath, qualifier, name, qualified);
+    const QStringList files = declaration.isValid() ? vlangFilesForSearch(filePath)
+                                                    : QStringList(filePath);
+
+    Core::SearchResult *search = Core::SearchResultWindow::instance()->startNewSearch(
+                tr("V Usages:"), QString(), name,
+                replace ? Core::SearchResultWindow::SearchAndReplace
+                        : Core::SearchResultWindow::SearchOnly,
+                Core::SearchResultWindow::PreserveCaseDisabled);
+
+    if (replace) {
+        search->setTextToReplace(name);
+        QObject::connect(search, &Core::SearchResult::replaceButtonClicked,
+                         [name](const QString &newName, const QList<Core::SearchResultItem> &items, bool) {
+            QVector<Usage> usages;
+            usages.reserve(items.size());
+            for (const Core::SearchResultItem &item : items)
+                usages.append(usageFromItem(item));
+            applyRename(name, newName, usages);
+        });
+    }
+    QObject::connect(search, &Core::SearchResult::activated, [](const Core::SearchResultItem &item) {
+        Core::EditorManager::openEditorAtSearchResult(item);
+    });
+
+    auto watcher = new QFutureWatcher<Usage>(search);
+    QObject::connect(watcher, &QFutureWatcherBase::resultsReadyAt, search, [watcher, search](int begin, int end) {
+        for (int i = begin; i < end; ++i) {
+            const Usage usage = watcher->resultAt(i);
+            search->addResult(usage.filePath, usage.line, usage.lineText,
+                              usage.column, usage.length, QVariant::fromValue(usage));
+        }
+    });
+    QObject::connect(watcher, &QFutureWatcherBase::finished, search, [watcher, search] {
+        search->finishSearch(watcher->isCanceled());
+    });
+    QObject::connect(search, &Core::SearchResult::cancelled, watcher, [watcher] { watcher->cancel(); });
+    QObject::connect(search, &Core::SearchResult::paused, watcher, [watcher](bool paused) {
+        watcher->setPaused(paused);
+    });
+
+    const QFuture<Usage> future = Utils::runAsync(searchFiles, files, openDocumentContents(),
+                                                  name, declaration);
+    watcher->setFuture(future);
+    Core::ProgressManager::addTask(future, tr("Searching for Usages"), Constants::C_TASK_FIND_USAGES);
+    Core::SearchResultWindow::instance()->popup(Core::IOutputPane::ModeSwitch | Core::IOutputPane::WithFocus);
+}
+
+void VlangUsages::applyRename(const QString &oldName, const QString &newName, const QVector<Usage> &usages)
+{
+    if (newName.isEmpty() || newName == oldName)
+        return;
+
+    QHash<QString, QVector<Usage>> usagesByFile;
+    for (const Usage &usage : usages)
+        usagesByFile[usage.filePath].append(usage);
+
+    // Open documents are edited in place so the rename is undoable, the rest
+    // is rewritten on disk without creating editors.
+    QStringList failed;
+    QVector<FileUsages> closedFiles;
+    for (auto it = usagesByFile.cbegin(); it != usagesByFile.cend(); ++it) {
+        auto document = qobject_cast<TextEditor::TextDocument *>(
+                    Core::DocumentModel::documentForFilePath(Utils::FilePath::fromString(it.key())));
+        if (!document)
+            closedFiles.append(qMakePair(it.key(), it.value()));
+        else if (!renameInDocument(document->document(), it.value(), oldName, newName))
+            failed.append(tr("%1: changed since the search").arg(QDir::toNativeSeparators(it.key())));
+    }
+    const auto reportFailures = [](const QStringList &failed) {
+        if (failed.isEmpty())
+            return;
+        QMessageBox::warning(Core::ICore::dialogParent(), tr("Rename Symbol"),
+                             tr("The rename is incomplete, usages in these files were not renamed:\n%1")
+                             .arg(failed.join(QLatin1Char('\n'))));
+    };
+    if (closedFiles.isEmpty()) {
+        reportFailures(failed);
+        return;
+    }
+
+    const QFuture<QString> future = Utils::runAsync(renameInFiles, closedFiles, oldName, newName);
+    auto watcher = new QFutureWatcher<QString>;
+    QObject::connect(watcher, &QFutureWatcherBase::finished, [watcher, failed, reportFailures] {
+        reportFailures(failed + watcher->future().results());
+        watcher->deleteLater();
+    });
+    watcher->setFuture(future);
+    Core::ProgressManager::addTask(future, tr("Renaming Symbol"), Constants::C_TASK_RENAME_SYMBOL);
+}
+
+} // namespace Internal
+} // namespace Vcreator
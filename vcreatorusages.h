@@ -0,0 +1,64 @@
+#pragma once
+
+#include <QCoreApplication>
+#include <QMetaType>
+#include <QString>
+#include <QVector>
+
+QT_BEGIN_NAMESPACE
+class QTextCursor;
+class QTextDocument;
+QT_END_NAMESPACE
+
+namespace TextEditor { class TextEditorWidget; }
+
+namespace VCreator {
+namespace Internal {
+
+class SourceTokens;
+
+struct Usage
+{
+    QString filePath;
+    int line = 0;   // 1-based
+    int column = 0; // 0-based
+    int length = 0;
+    QString lineText;
+};
+
+// Token-level usage search: only identifiers are matched, so occurrences in
+// comments and plain string text are skipped. Identifiers referenced from
+// string interpolation ('$name', '${expr}') are reported as usages.
+QVector<Usage> findUsagesInTokens(const QString &filePath,
+                                  const SourceTokens &tokens,
+                                  const QString &name);
+
+// Returns the identifier under the cursor, or an empty string.
+QString identifierUnderCursor(const QTextCursor &cursor, int *start = nullptr);
+
+// Returns "os" for "os.join_path" when identifierStart points at join_path.
+// qualified is also set for member access on expressions like "foo().bar",
+// where no qualifier name can be returned.
+QString qualifierAt(const QTextDocument *document, int identifierStart, bool *qualified = nullptr);
+
+// Usages of the symbol under the cursor are the identifiers resolving to the
+// same declaration through the symbol index, a rename reports every file it
+// could not complete.
+class VlangUsages
+{
+    Q_DECLARE_TR_FUNCTIONS(VCreator::Internal::VlangUsages)
+
+public:
+    static void findUsages(TextEditor::TextEditorWidget *editor);
+    static void renameSymbol(TextEditor::TextEditorWidget *editor);
+
+private:
+    static void startSearch(TextEditor::TextEditorWidget *editor, bool replace);
+    static void applyRename(const QString &oldName, const QString &newName,
+                            const QVector<Usage> &usages);
+};
+
+} // namespace Internal
+} // namespace Vcreator
+
+Q_DECLARE_METATYPE(VCreator::Internal::Usage)
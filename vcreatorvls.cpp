@@ -0,0 +1,233 @@
+#include "vcreatorvls.h"
+#include "vcreatorconstants.h"
+#include "vcreatorproject.h"
+#include "vcreatorsettings.h"
+
+#include <coreplugin/editormanager/documentmodel.h>
+#include <coreplugin/editormanager/editormanager.h>
+#include <languageclient/client.h>
+#include <languageclient/languageclientinterface.h>
+#include <languageclient/languageclientmanager.h>
+#include <projectexplorer/session.h>
+#include <texteditor/textdocument.h>
+#include <utils/hostosinfo.h>
+
+#include <QDir>
+#include <QFileInfo>
+#include <QLoggingCategory>
+#include <QStandardPaths>
+
+#include <utility>
+
+namespace VCreator {
+namespace Internal {
+
+Q_LOGGING_CATEGORY(vlsLog, "qtc.vcreator.vls", QtWarningMsg)
+
+static VlsManager *m_instance = nullptr;
+
+RequestCoalescer::RequestCoalescer(int interval, QObject *parent)
+    : QObject(parent)
+{
+    m_timer.setSingleShot(true);
+    m_timer.setInterval(interval);
+    connect(&m_timer, &QTimer::timeout, this, &RequestCoalescer::sendPending);
+}
+
+void RequestCoalescer::schedule(LanguageClient::Client *client, const QString &key, const Sender &send)
+{
+    m_pending.insert(key, {client, send});
+    m_timer.start();
+}
+
+void RequestCoalescer::cancel(const QString &key)
+{
+    m_pending.remove(key);
+    const InFlight inFlight = m_inFlight.take(key);
+    if (inFlight.client)
+        inFlight.client->cancelRequest(inFlight.id);
+}
+
+void RequestCoalescer::finished(const QString &key, const LanguageServerProtocol::MessageId &id)
+{
+    const auto it = m_inFlight.find(key);
+    if (it == m_inFlight.end() || !(it->id == id))
+        return;
+    qCDebug(vlsLog) << key << "answered in" << it->timer.elapsed() << "ms";
+    m_inFlight.erase(it);
+}
+
+void RequestCoalescer::sendPending()
+{
+    const QHash<QString, Pending> pending = std::exchange(m_pending, {});
+    for (auto it = pending.cbegin(); it != pending.cend(); ++it) {
+        if (!it->client || !it->client->reachable())
+            continue;
+        cancel(it.key());
+
+        InFlight inFlight;
+        inFlight.client = it->client;
+        inFlight.timer.start();
+        inFlight.id = it->send(it->client);
+        m_inFlight.insert(it.key(), inFlight);
+    }
+}
+
+VlsManager::VlsManager()
+{
+    m_instance = this;
+
+    auto session = ProjectExplorer::SessionManager::instance();
+    connect(session, &ProjectExplorer::SessionManager::projectAdded,
+            this, &VlsManager::projectAdded);
+    connect(session, &ProjectExplorer::SessionManager::aboutToRemoveProject,
+            this, &VlsManager::aboutToRemoveProject);
+    connect(session, &ProjectExplorer::SessionManager::projectRemoved,
+            this, &VlsManager::projectRemoved);
+    connect(Core::EditorManager::instance(), &Core::EditorManager::documentOpened,
+            this, &VlsManager::documentOpened);
+}
+
+VlsManager::~VlsManager()
+{
+    m_instance = nullptr;
+}
+
+VlsManager *VlsManager::instance()
+{
+    return m_instance;
+}
+
+LanguageClient::Client *VlsManager::clientForDocument(TextEditor::TextDocument *document) const
+{
+    LanguageClient::Client *client = LanguageClient::LanguageClientManager::clientForDocument(document);
+    if (!client || !client->reachable())
+        return nullptr;
+    for (const Server &server : m_servers) {
+        if (server.client == client)
+            return client;
+    }
+    return nullptr;
+}
+
+Utils::FilePath VlsManager::serverPath()
+{
+    const Utils::FilePath configured = VlangSettings::languageServerPath();
+    if (!configured.isEmpty())
+        return configured;
+
+    const QString vls = Utils::HostOsInfo::withExecutableSuffix(QLatin1String("vls"));
+    QString path = QStandardPaths::findExecutable(vls);
+    if (path.isEmpty())
+        path = QStandardPaths::findExecutable(vls, {QDir::homePath() + QLatin1String("/.vls/bin")});
+    return Utils::FilePath::fromString(path);
+}
+
+void VlsManager::restart()
+{
+    QList<ProjectExplorer::Project *> projects;
+    for (const Server &server : qAsConst(m_servers)) {
+        projects << server.projects;
+        if (server.client)
+            LanguageClient::LanguageClientManager::shutdownClient(server.client);
+    }
+    m_servers.clear();
+
+    for (ProjectExplorer::Project *project : qAsConst(projects))
+        projectAdded(project);
+}
+
+void VlsManager::projectAdded(ProjectExplorer::Project *project)
+{
+    if (!qobject_cast<VlangProject *>(project) || !VlangSettings::useLanguageServer())
+        return;
+
+    Server &server = m_servers[VlangSettings::compilerPath()];
+    server.projects.append(project);
+    if (!server.client)
+        server.client = startClient(project);
+}
+
+// LanguageClient shuts a client down when its current project closes. The
+// server is shared, so it is handed to another of its projects first.
+void VlsManager::aboutToRemoveProject(ProjectExplorer::Project *project)
+{
+    for (const Server &server : qAsConst(m_servers)) {
+        if (!server.client || server.client->project() != project)
+            continue;
+        for (ProjectExplorer::Project *other : server.projects) {
+            if (other != project) {
+                server.client->setCurrentProject(other);
+                break;
+            }
+        }
+        return;
+    }
+}
+
+void VlsManager::projectRemoved(ProjectExplorer::Project *project)
+{
+    for (auto it = m_servers.begin(); it != m_servers.end(); ++it) {
+        if (!it->projects.removeOne(project))
+            continue;
+        if (it->projects.isEmpty()) {
+            if (it->client)
+                LanguageClient::LanguageClientManager::shutdownClient(it->client);
+            m_servers.erase(it);
+        }
+        return;
+    }
+}
+
+void VlsManager::documentOpened(Core::IDocument *document)
+{
+    auto textDocument = qobject_cast<TextEditor::TextDocument *>(document);
+    if (!textDocument || textDocument->mimeType() != QLatin1String(Constants::C_VLANG_MIMETYPE))
+        return;
+
+    const Server server = m_servers.value(VlangSettings::compilerPath());
+    if (server.client && server.client->reachable())
+        LanguageClient::LanguageClientManager::openDocumentWithClient(textDocument, server.client);
+}
+
+LanguageClient::Client *VlsManager::startClient(ProjectExplorer::Project *project)
+{
+    const Utils::FilePath vls = serverPath();
+    if (vls.isEmpty() || !vls.isExecutableFile()) {
+        qCDebug(vlsLog) << "VLS not found, language server support disabled";
+        return nullptr;
+    }
+
+    // Starting the process does not block, the server initializes while the
+    // project is being parsed
+    auto clientInterface = new LanguageClient::StdIOClientInterface(vls.toString(), QString());
+    auto client = new LanguageClient::Client(clientInterface);
+    client->setName(tr("VLS"));
+    LanguageClient::LanguageFilter filter;
+    filter.mimeTypes = QStringList(QLatin1String(Constants::C_VLANG_MIMETYPE));
+    client->setSupportedLanguage(filter);
+    client->setCurrentProject(project);
+
+    QElapsedTimer timer;
+    timer.start();
+    connect(client, &LanguageClient::Client::initialized, this, [this, client, timer] {
+        qCDebug(vlsLog) << "VLS initialized in" << timer.elapsed() << "ms";
+        openDocuments(client);
+        emit clientInitialized(client);
+    });
+
+    LanguageClient::LanguageClientManager::startClient(client);
+    return client;
+}
+
+void VlsManager::openDocuments(LanguageClient::Client *client)
+{
+    for (Core::IDocument *document : Core::DocumentModel::openedDocuments()) {
+        auto textDocument = qobject_cast<TextEditor::TextDocument *>(document);
+        if (textDocument && textDocument->mimeType() == QLatin1String(Constants::C_VLANG_MIMETYPE))
+            LanguageClient::LanguageClientManager::openDocumentWithClient(textDocument, client);
+    }
+}
+
+} // namespace Internal
+} // namespace Vcreator
@@ -0,0 +1,166 @@
+#pragma once
+
+#include <languageserverprotocol/jsonrpcmessages.h>
+#include <languageserverprotocol/lsptypes.h>
+#include <utils/fileutils.h>
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QJsonArray>
+#include <QObject>
+#include <QPointer>
+#include <QTimer>
+
+#include <functional>
+
+namespace Core { class IDocument; }
+namespace LanguageClient { class Client; }
+namespace ProjectExplorer { class Project; }
+namespace TextEditor { class TextDocument; }
+
+namespace VCreator {
+namespace Internal {
+
+// textDocument/semanticTokens/full and .../full/delta, LanguageClient has
+// no support for semantic tokens yet.
+class SemanticTokensParams : public LanguageServerProtocol::JsonObject
+{
+public:
+    using JsonObject::JsonObject;
+
+    void setTextDocument(const LanguageServerProtocol::TextDocumentIdentifier &textDocument)
+    { insert(LanguageServerProtocol::textDocumentKey, textDocument); }
+};
+
+class SemanticTokensDeltaParams : public SemanticTokensParams
+{
+public:
+    using SemanticTokensParams::SemanticTokensParams;
+
+    void setPreviousResultId(const QString &resultId) { insert("previousResultId", resultId); }
+};
+
+// Either all tokens or, answering a delta request, the edits to the data of
+// the previous result
+class SemanticTokensResult : public LanguageServerProtocol::JsonObject
+{
+public:
+    using JsonObject::JsonObject;
+
+    QString resultId() const { return value("resultId").toString(); }
+
+    // Five integers per token: delta line, delta start, length, type and
+    // modifier bits
+    QJsonArray data() const { return value("data").toArray(); }
+
+    bool isDelta() const { return contains("edits"); }
+    // Objects with start, deleteCount and data, in terms of the previous data
+    QJsonArray edits() const { return value("edits").toArray(); }
+};
+
+class SemanticTokensRequest : public LanguageServerProtocol::Request<
+        SemanticTokensResult, std::nullptr_t, SemanticTokensParams>
+{
+public:
+    explicit SemanticTokensRequest(const SemanticTokensParams &params)
+        : Request(methodName, params) {}
+    using Request::Request;
+    constexpr static const char methodName[] = "textDocument/semanticTokens/full";
+};
+
+class SemanticTokensDeltaRequest : public LanguageServerProtocol::Request<
+        SemanticTokensResult, std::nullptr_t, SemanticTokensDeltaParams>
+{
+public:
+    explicit SemanticTokensDeltaRequest(const SemanticTokensDeltaParams &params)
+        : Request(methodName, params) {}
+    using Request::Request;
+    constexpr static const char methodName[] = "textDocument/semanticTokens/full/delta";
+};
+
+// Debounces requests to a language server per key, e.g. method and
+// document. Only the latest request for a key is sent once the key went
+// quiet for the interval; a request still in flight when a newer one is
+// sent is cancelled, so stale answers never arrive.
+class RequestCoalescer : public QObject
+{
+    Q_OBJECT
+
+public:
+    using Sender = std::function<LanguageServerProtocol::MessageId(LanguageClient::Client *)>;
+
+    explicit RequestCoalescer(int interval, QObject *parent = nullptr);
+
+    void schedule(LanguageClient::Client *client, const QString &key, const Sender &send);
+    void cancel(const QString &key);
+
+    // To be called from the response handler, logs the round trip time.
+    void finished(const QString &key, const LanguageServerProtocol::MessageId &id);
+
+private:
+    void sendPending();
+
+    struct Pending
+    {
+        QPointer<LanguageClient::Client> client;
+        Sender send;
+    };
+    struct InFlight
+    {
+        QPointer<LanguageClient::Client> client;
+        LanguageServerProtocol::MessageId id;
+        QElapsedTimer timer;
+    };
+
+    QTimer m_timer;
+    QHash<QString, Pending> m_pending;
+    QHash<QString, InFlight> m_inFlight;
+};
+
+// Runs VLS for V projects. A server is started in the background when the
+// first V project opens and is shared by all projects using the same V
+// compiler; it is shut down when the last of them closes. Documents are
+// synced by LanguageClient, which sends incremental didChange notifications
+// since VLS announces incremental text sync.
+class VlsManager : public QObject
+{
+    Q_OBJECT
+
+public:
+    VlsManager();
+    ~VlsManager() override;
+
+    static VlsManager *instance();
+
+    // Initialized server for document, or nullptr.
+    LanguageClient::Client *clientForDocument(TextEditor::TextDocument *document) const;
+
+    // VLS from the settings, then vls in PATH and ~/.vls/bin.
+    static Utils::FilePath serverPath();
+
+    // To be called when the server settings changed, restarts servers.
+    void restart();
+
+signals:
+    void clientInitialized(LanguageClient::Client *client);
+
+private:
+    void projectAdded(ProjectExplorer::Project *project);
+    void aboutToRemoveProject(ProjectExplorer::Project *project);
+    void projectRemoved(ProjectExplorer::Project *project);
+    void documentOpened(Core::IDocument *document);
+    LanguageClient::Client *startClient(ProjectExplorer::Project *project);
+    void openDocuments(LanguageClient::Client *client);
+
+    struct Server
+    {
+        QPointer<LanguageClient::Client> client;
+        QList<ProjectExplorer::Project *> projects;
+    };
+
+    // Keyed by V compiler
+    QHash<Utils::FilePath, Server> m_servers;
+};
+
+} // namespace Internal
+} // namespace Vcreator